@@ -3,54 +3,218 @@
 #include <utility>
 #include <algorithm>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 #include <limits>
 #include "iterators.hpp"
 #include "weighted_oriented_graph.hpp"
+#include "csr_graph.hpp"
+#include "vertex_index.hpp"
   namespace graph {
-    /**
+
+/**
+ * @brief Результат поиска кратчайших путей от одной вершины.
+ *
+ * @tparam Weight Тип веса рёбер.
+ *
+ * Все векторы индексируются плотными индексами вершин графа
+ * (см. CsrGraph::Index()).
+ */
+template<typename Weight>
+struct ShortestPaths {
+  //! Достижима ли вершина из начальной.
+  std::vector<bool> reached;
+  //! Длина кратчайшего пути до вершины.
+  std::vector<Weight> distance;
+  //! Предок вершины в дереве кратчайших путей (VertexIndex::npos для
+  //! начальной и недостижимых вершин).
+  std::vector<size_t> parent;
+  //! Достижим ли из начальной вершины цикл отрицательного веса. В этом
+  //! случае расстояния не определены.
+  bool negativeCycle = false;
+
+  /**
+   * @brief Подготовить результат для графа из n вершин.
+   *
+   * @param n Количество вершин.
+   * @param source Индекс начальной вершины.
+   */
+  void Reset(size_t n, size_t source) {
+    reached.assign(n, false);
+    distance.assign(n, Weight());
+    parent.assign(n, VertexIndex::npos);
+    negativeCycle = false;
+
+    reached[source] = true;
+  }
+};
+
+/**
  * @brief Алгоритм Беллмана-Форда.
  *
- * @tparam T Тип данных сортируемых элементов.
+ * @tparam Weight Тип веса рёбер.
  *
- * @param wog Взвешенный ориентируемый граф
+ * @param graph Граф в формате CSR.
+ * @param source Индекс начальной вершины.
+ * @param result Результат.
  *
- * Функция находит длины кратчайших путей от вершины v до всех остальных вершин.
+ * Алгоритм выполняет не более N - 1 фаз релаксации всех рёбер и
+ * останавливается, как только очередная фаза ничего не изменила. Если
+ * изменения есть и на N-й фазе, то из начальной вершины достижим цикл
+ * отрицательного веса.
  */
+template<typename Weight>
+void BellmanFord(const CsrGraph<Weight>& graph, size_t source,
+                 ShortestPaths<Weight>* result) {
+  const size_t n = graph.NumVertices();
+  const std::vector<size_t>& offsets = graph.Offsets();
+  const std::vector<size_t>& neighbours = graph.Neighbours();
+  const std::vector<Weight>& weights = graph.Weights();
 
-  // тип данных для веса вершин
-  std::unordered_map<size_t , std::pair<bool, int>>
-  Belmanf(const WeightedOrientedGraph<int>& wog, size_t v) {
-  // заполнение вектора для сортировки
+  result->Reset(n, source);
 
-    std::unordered_map<size_t , std::pair<bool, int>> res;
-    size_t c = 0;
-  for (size_t v2 : wog.Vertices()) {
-    if (v2 > c)
-      c = v2;
-  }
-  for (size_t i = 0; i < c; i++)
-    if (wog.HasVertex(i))
-      res[i].first = 0;
-  res[v].second = 0;
-  res[v].first = 1;
-  for (size_t v1 : wog.Vertices()) {
-    for (size_t neighbour : wog.Edges(v1)) {
-      if (res[v1].first != 0) {
-        if (res[neighbour].first != 0) {
-          res[neighbour].second = std::min(res[neighbour].second,
-          res[v1].second + wog.EdgeWeight(v1, neighbour));
-          res[neighbour].first = 1;
-        } else {
-          res[neighbour].second = res[v1].second +
-          wog.EdgeWeight(v1, neighbour);
-          res[neighbour].first = 1;
+  bool changed = true;
+
+  for (size_t round = 0; round < n && changed; round++) {
+    changed = false;
+
+    for (size_t v = 0; v < n; v++) {
+      if (!result->reached[v])
+        continue;
+
+      for (size_t k = offsets[v]; k < offsets[v + 1]; k++) {
+        const size_t to = neighbours[k];
+        const Weight candidate = result->distance[v] + weights[k];
+
+        if (!result->reached[to] || candidate < result->distance[to]) {
+          result->reached[to] = true;
+          result->distance[to] = candidate;
+          result->parent[to] = v;
+          changed = true;
         }
       }
     }
   }
 
+  result->negativeCycle = changed;
+}
+
+/**
+ * @brief Алгоритм Беллмана-Форда с очередью (SPFA).
+ *
+ * @tparam Weight Тип веса рёбер.
+ *
+ * @param graph Граф в формате CSR.
+ * @param source Индекс начальной вершины.
+ * @param result Результат.
+ *
+ * Рёбра вершины релаксируются только тогда, когда расстояние до неё
+ * уменьшилось, поэтому на разреженных графах алгоритм работает
+ * значительно быстрее N * M. Для каждой вершины хранится количество рёбер
+ * в найденном пути до неё: если оно достигло N, то путь содержит цикл
+ * отрицательного веса.
+ */
+template<typename Weight>
+void Spfa(const CsrGraph<Weight>& graph, size_t source,
+          ShortestPaths<Weight>* result) {
+  const size_t n = graph.NumVertices();
+  const std::vector<size_t>& offsets = graph.Offsets();
+  const std::vector<size_t>& neighbours = graph.Neighbours();
+  const std::vector<Weight>& weights = graph.Weights();
+
+  result->Reset(n, source);
+
+  // Циклическая очередь: каждая вершина находится в ней не более одного раза.
+  std::vector<size_t> queue(n);
+  std::vector<bool> queued(n, false);
+  std::vector<size_t> length(n, 0);
+  size_t head = 0, size = 0;
+
+  queue[0] = source;
+  queued[source] = true;
+  size = 1;
+
+  while (size > 0) {
+    const size_t v = queue[head];
+    head = (head + 1) % n;
+    size--;
+    queued[v] = false;
+
+    for (size_t k = offsets[v]; k < offsets[v + 1]; k++) {
+      const size_t to = neighbours[k];
+      const Weight candidate = result->distance[v] + weights[k];
+
+      if (result->reached[to] && !(candidate < result->distance[to]))
+        continue;
+
+      result->reached[to] = true;
+      result->distance[to] = candidate;
+      result->parent[to] = v;
+      length[to] = length[v] + 1;
+
+      if (length[to] >= n) {
+        result->negativeCycle = true;
+        return;
+      }
+
+      if (!queued[to]) {
+        queue[(head + size) % n] = to;
+        queued[to] = true;
+        size++;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Алгоритм Беллмана-Форда.
+ *
+ * @tparam Weight Тип веса рёбер.
+ *
+ * @param wog Взвешенный ориентируемый граф
+ * @param v Начальная вершина.
+ * @param parents Если указатель не нулевой, то в него записываются
+ *        предки вершин в дереве кратчайших путей.
+ * @param negativeCycle Если указатель не нулевой, то в него записывается,
+ *        достижим ли из вершины v цикл отрицательного веса.
+ *
+ * Функция находит длины кратчайших путей от вершины v до всех остальных вершин.
+ * Для каждой вершины возвращается пара (достижима ли вершина, расстояние).
+ */
+template<typename Weight>
+std::unordered_map<size_t , std::pair<bool, Weight>>
+Belmanf(const WeightedOrientedGraph<Weight>& wog, size_t v,
+        std::unordered_map<size_t, size_t>* parents = nullptr,
+        bool* negativeCycle = nullptr) {
+  // граф в плоском виде, состояние вершин хранится в векторах
+  const CsrGraph<Weight> csr(wog);
+  const size_t n = csr.NumVertices();
+
+  std::unordered_map<size_t , std::pair<bool, Weight>> res;
+  res.reserve(n + 1);
+
+  if (negativeCycle)
+    *negativeCycle = false;
+
+  if (!csr.HasVertex(v)) {
+    res[v] = std::make_pair(true, Weight());
+    return res;
+  }
+
+  ShortestPaths<Weight> paths;
+  Spfa(csr, csr.Index(v), &paths);
+
+  if (negativeCycle)
+    *negativeCycle = paths.negativeCycle;
+
+  // перевод индексов обратно в номера вершин
+  for (size_t i = 0; i < n; i++) {
+    res[csr.Id(i)] = std::make_pair(static_cast<bool>(paths.reached[i]),
+                                    paths.distance[i]);
+
+    if (parents && paths.parent[i] != VertexIndex::npos)
+      (*parents)[csr.Id(i)] = csr.Id(paths.parent[i]);
+  }
+
   return res;
 }
 
@@ -0,0 +1,240 @@
+/**
+ * @file biconnected.hpp
+ *
+ * Поиск точек сочленения, мостов, компонент рёберной двусвязности
+ * и блоков за один обход в глубину.
+ */
+
+#ifndef INCLUDE_BICONNECTED_HPP_
+#define INCLUDE_BICONNECTED_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "csr_graph.hpp"
+#include "dfs.hpp"
+#include "vertex_index.hpp"
+
+namespace graph {
+
+/**
+ * @brief Флаги, выбирающие, что вычисляет функция Biconnected().
+ */
+enum BiconnectedOutputs : unsigned {
+  //! Точки сочленения.
+  kCutPoints = 1,
+  //! Мосты.
+  kBridges = 2,
+  //! Компоненты рёберной двусвязности.
+  kTwoEdgeComponents = 4,
+  //! Блоки (компоненты вершинной двусвязности).
+  kBlocks = 8,
+  //! Всё сразу.
+  kAllBiconnectedOutputs = 15
+};
+
+/**
+ * @brief Результат функции Biconnected().
+ *
+ * Все вершины задаются своими номерами в исходном графе.
+ */
+struct BiconnectedComponents {
+  //! Точки сочленения (каждая ровно один раз).
+  std::vector<size_t> cutPoints;
+  //! Мосты (предок в дереве обхода, потомок).
+  std::vector<std::pair<size_t, size_t>> bridges;
+  //! Компоненты рёберной двусвязности (разбиение всех вершин графа).
+  std::vector<std::vector<size_t>> twoEdgeComponents;
+  //! Блоки. Изолированная вершина образует блок из одной вершины.
+  std::vector<std::vector<size_t>> blocks;
+};
+
+/**
+ * @brief Обработчик обхода в глубину для алгоритма Тарьяна-Хопкрофта.
+ *
+ * Для каждой вершины хранятся время входа и минимальное время входа,
+ * достижимое из её поддерева по одному обратному ребру. При выходе
+ * из вершины v с предком p:
+ *
+ * - если minTime[v] >= entryTime[p], то p - точка сочленения (если p не
+ *   корень), а вершины поддерева v, ещё лежащие в стеке блоков, вместе
+ *   с p образуют блок;
+ * - если minTime[v] > entryTime[p], то (p, v) - мост, а вершины поддерева v,
+ *   ещё лежащие в стеке компонент, образуют компоненту рёберной
+ *   двусвязности.
+ *
+ * Корень - точка сочленения, если у него больше одного ребёнка. Стеки
+ * заполняются, только если запрошены соответствующие результаты.
+ */
+class BiconnectedVisitor : public DfsVisitor {
+ public:
+  /**
+   * @brief Конструктор.
+   *
+   * @param index Отображение номеров вершин в плотные индексы.
+   * @param outputs Набор флагов BiconnectedOutputs.
+   * @param result Результат.
+   */
+  BiconnectedVisitor(const VertexIndex& index, unsigned outputs,
+                     BiconnectedComponents* result) :
+    index(index),
+    outputs(outputs),
+    result(result),
+    timer(0),
+    entryTime(index.Size(), 0),
+    minTime(index.Size(), 0),
+    parent(index.Size(), VertexIndex::npos),
+    isPoint((outputs & kCutPoints) ? index.Size() : 0, false),
+    blockStack(),
+    componentStack(),
+    rootChildren(0) {
+  }
+
+  //! Вход в вершину v: запоминаем время входа.
+  void Enter(size_t v, size_t p) {
+    entryTime[v] = minTime[v] = timer++;
+    parent[v] = p;
+
+    if (p == VertexIndex::npos)
+      rootChildren = 0;
+    else if (parent[p] == VertexIndex::npos)
+      ++rootChildren;
+
+    if (outputs & kBlocks)
+      blockStack.push_back(v);
+    if (outputs & kTwoEdgeComponents)
+      componentStack.push_back(v);
+  }
+
+  //! Обратное ребро (кроме ребра в предка) уменьшает minTime.
+  void BackEdge(size_t v, size_t to) {
+    if (to != parent[v])
+      minTime[v] = std::min(minTime[v], entryTime[to]);
+  }
+
+  //! Выход из вершины v.
+  void Exit(size_t v, size_t p) {
+    if (p == VertexIndex::npos) {
+      ExitRoot(v);
+      return;
+    }
+
+    minTime[p] = std::min(minTime[p], minTime[v]);
+
+    if (minTime[v] >= entryTime[p]) {
+      if ((outputs & kCutPoints) && parent[p] != VertexIndex::npos &&
+          !isPoint[p]) {
+        isPoint[p] = true;
+        result->cutPoints.push_back(index.Id(p));
+      }
+
+      if (outputs & kBlocks) {
+        result->blocks.push_back(PopUntil(&blockStack, v));
+        result->blocks.back().push_back(index.Id(p));
+      }
+    }
+
+    if (minTime[v] > entryTime[p]) {
+      if (outputs & kBridges)
+        result->bridges.push_back({index.Id(p), index.Id(v)});
+
+      if (outputs & kTwoEdgeComponents)
+        result->twoEdgeComponents.push_back(PopUntil(&componentStack, v));
+    }
+  }
+
+ private:
+  /**
+   * @brief Выход из корня дерева обхода.
+   *
+   * @param v Индекс корня.
+   */
+  void ExitRoot(size_t v) {
+    if ((outputs & kCutPoints) && rootChildren > 1) {
+      isPoint[v] = true;
+      result->cutPoints.push_back(index.Id(v));
+    }
+
+    // Блоки всех детей корня уже сняты со стека, остался только сам корень.
+    if (outputs & kBlocks) {
+      blockStack.pop_back();
+
+      if (rootChildren == 0)
+        result->blocks.push_back({index.Id(v)});
+    }
+
+    if (outputs & kTwoEdgeComponents)
+      result->twoEdgeComponents.push_back(PopUntil(&componentStack, v));
+  }
+
+  /**
+   * @brief Снять со стека вершины до v включительно.
+   *
+   * @param stack Стек индексов вершин.
+   * @param v Индекс вершины.
+   *
+   * Функция возвращает номера снятых вершин.
+   */
+  std::vector<size_t> PopUntil(std::vector<size_t>* stack, size_t v) const {
+    std::vector<size_t> ids;
+    size_t top;
+
+    do {
+      top = stack->back();
+      stack->pop_back();
+      ids.push_back(index.Id(top));
+    } while (top != v);
+
+    return ids;
+  }
+
+  //! Отображение номеров вершин в плотные индексы.
+  const VertexIndex& index;
+  //! Набор флагов BiconnectedOutputs.
+  unsigned outputs;
+  //! Результат.
+  BiconnectedComponents* result;
+  //! Счётчик времени входа.
+  size_t timer;
+  //! Времена входа в вершины.
+  std::vector<size_t> entryTime;
+  //! Минимальные времена входа, достижимые из поддерева вершины.
+  std::vector<size_t> minTime;
+  //! Предки вершин в дереве обхода.
+  std::vector<size_t> parent;
+  //! Флаги вершин, уже добавленных в список точек сочленения.
+  std::vector<bool> isPoint;
+  //! Стек вершин для выделения блоков.
+  std::vector<size_t> blockStack;
+  //! Стек вершин для выделения компонент рёберной двусвязности.
+  std::vector<size_t> componentStack;
+  //! Количество детей корня текущего дерева обхода.
+  size_t rootChildren;
+};
+
+/**
+ * @brief Найти точки сочленения, мосты, компоненты рёберной двусвязности
+ *        и блоки неориентированного графа.
+ *
+ * @tparam T Тип графа.
+ *
+ * @param graph Граф.
+ * @param outputs Набор флагов BiconnectedOutputs.
+ * @param result Результат. Заполняются только запрошенные поля.
+ *
+ * Все результаты вычисляются за один нерекурсивный обход в глубину
+ * (см. DepthFirstSearch()) за время O(N + M).
+ */
+template<class T>
+void Biconnected(const T& graph, unsigned outputs,
+                 BiconnectedComponents* result) {
+  const CsrGraph<> csr(graph);
+  BiconnectedVisitor visitor(csr.Indices(), outputs, result);
+
+  DepthFirstSearch(csr.Offsets(), csr.Neighbours(), &visitor);
+}
+
+}  // namespace graph
+
+#endif  // INCLUDE_BICONNECTED_HPP_
@@ -0,0 +1,183 @@
+/**
+ * @file boruvka.hpp
+ *
+ * Реализация параллельного алгоритма Борувки.
+ */
+
+#ifndef INCLUDE_BORUVKA_HPP_
+#define INCLUDE_BORUVKA_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include "graph.hpp"
+#include "weighted_graph.hpp"
+#include "vertex_index.hpp"
+#include "disjoint_set.hpp"
+#include "parallel.hpp"
+
+namespace graph {
+
+/**
+ * @brief Ребро для алгоритма Борувки.
+ *
+ * @tparam T Тип веса ребра.
+ *
+ * Концы ребра задаются плотными индексами вершин, a < b.
+ */
+template<typename T>
+struct BoruvkaEdge {
+  //! Вес ребра.
+  T weight;
+  //! Индекс первого конца ребра.
+  size_t a;
+  //! Индекс второго конца ребра.
+  size_t b;
+
+  /**
+   * @brief Сравнение рёбер по весу, а при равных весах - по концам.
+   *
+   * @param other Другое ребро.
+   *
+   * Это тот же порядок, в котором рёбра перебирает Maximal(), поэтому
+   * минимальный остов при таком порядке единственный и оба алгоритма
+   * находят одно и то же дерево.
+   */
+  bool operator<(const BoruvkaEdge& other) const {
+    if (weight < other.weight)
+      return true;
+    if (other.weight < weight)
+      return false;
+    if (a != other.a)
+      return a < other.a;
+    return b < other.b;
+  }
+};
+
+/**
+ * @brief Параллельный алгоритм Борувки.
+ *
+ * @tparam T Тип веса рёбер.
+ *
+ * @param wGraph Взвешенный граф.
+ * @param numThreads Количество потоков (0 - количество ядер процессора).
+ *
+ * На каждой фазе для каждой компоненты параллельно выбирается самое лёгкое
+ * ребро, выходящее из неё (минимум обновляется атомарно), затем компоненты
+ * объединяются по выбранным рёбрам, а рёбра внутри компонент параллельно
+ * отфильтровываются. Количество компонент на каждой фазе уменьшается хотя
+ * бы вдвое, поэтому фаз не больше log N. Функция возвращает тот же
+ * остовный лес, что и Maximal().
+ */
+template<typename T>
+Graph Boruvka(const WeightedGraph<T>& wGraph, size_t numThreads = 0) {
+  using Edge = BoruvkaEdge<T>;
+
+  const VertexIndex index(wGraph);
+  const size_t n = index.Size();
+  const size_t none = VertexIndex::npos;
+
+  if (numThreads == 0)
+    numThreads = DefaultNumThreads();
+
+  // Список рёбер собирается параллельно по отрезкам вершин.
+  std::vector<std::vector<Edge>> parts(NumParallelChunks(n, numThreads,
+                                                         256));
+  const size_t used = ParallelFor(n, numThreads,
+      [&](size_t thread, size_t begin, size_t end) {
+    for (size_t v = begin; v < end; v++) {
+      for (const auto& [neighbour, weight] :
+           wGraph.WeightedEdges(index.Id(v))) {
+        const size_t to = index.Index(neighbour);
+
+        if (to > v)
+          parts[thread].push_back({weight, v, to});
+      }
+    }
+  }, 256);
+
+  std::vector<Edge> edges;
+  for (size_t thread = 0; thread < used; thread++)
+    edges.insert(edges.end(), parts[thread].begin(), parts[thread].end());
+
+  Graph res;
+  DisjointSet trees(n);
+  std::vector<size_t> component(n);
+  std::vector<std::atomic<size_t>> best(n);
+  std::vector<size_t> counts;
+  std::vector<Edge> remaining;
+
+  for (size_t v = 0; v < n; v++)
+    component[v] = v;
+
+  while (!edges.empty() && trees.NumSets() > 1) {
+    ParallelFor(n, numThreads, [&](size_t, size_t begin, size_t end) {
+      for (size_t v = begin; v < end; v++)
+        best[v].store(none, std::memory_order_relaxed);
+    });
+
+    // Выбор самого лёгкого ребра для каждой компоненты.
+    ParallelFor(edges.size(), numThreads,
+        [&](size_t, size_t begin, size_t end) {
+      auto offer = [&](std::atomic<size_t>* slot, size_t e) {
+        size_t current = slot->load(std::memory_order_relaxed);
+
+        while ((current == none || edges[e] < edges[current]) &&
+               !slot->compare_exchange_weak(current, e,
+                                            std::memory_order_relaxed)) {
+        }
+      };
+
+      for (size_t e = begin; e < end; e++) {
+        offer(&best[component[edges[e].a]], e);
+        offer(&best[component[edges[e].b]], e);
+      }
+    });
+
+    // Объединение компонент. Если две компоненты выбрали одно и то же
+    // ребро, то второе объединение ничего не делает.
+    for (size_t v = 0; v < n; v++) {
+      const size_t e = best[v].load(std::memory_order_relaxed);
+
+      if (e != none && trees.Union(edges[e].a, edges[e].b))
+        res.AddEdge(index.Id(edges[e].a), index.Id(edges[e].b));
+    }
+
+    for (size_t v = 0; v < n; v++)
+      component[v] = trees.Find(v);
+
+    // Параллельная фильтрация рёбер, ставших внутренними.
+    auto external = [&](const Edge& edge) {
+      return component[edge.a] != component[edge.b];
+    };
+
+    counts.assign(NumParallelChunks(edges.size(), numThreads) + 1, 0);
+    const size_t chunks = ParallelFor(edges.size(), numThreads,
+        [&](size_t thread, size_t begin, size_t end) {
+      for (size_t e = begin; e < end; e++)
+        counts[thread + 1] += external(edges[e]);
+    });
+
+    for (size_t thread = 0; thread < chunks; thread++)
+      counts[thread + 1] += counts[thread];
+
+    remaining.resize(counts[chunks]);
+    ParallelFor(edges.size(), chunks,
+        [&](size_t thread, size_t begin, size_t end) {
+      size_t position = counts[thread];
+
+      for (size_t e = begin; e < end; e++)
+        if (external(edges[e]))
+          remaining[position++] = edges[e];
+    });
+
+    edges.swap(remaining);
+  }
+
+  return res;
+}
+
+}  // namespace graph
+
+#endif  // INCLUDE_BORUVKA_HPP_
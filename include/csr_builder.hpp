@@ -0,0 +1,471 @@
+/**
+ * @file csr_builder.hpp
+ *
+ * Многопоточное построение графа из списка рёбер: сначала строится CSR
+ * представление, из которого затем можно заполнить любой из классов
+ * графов с заранее известными степенями вершин.
+ */
+
+#ifndef INCLUDE_CSR_BUILDER_HPP_
+#define INCLUDE_CSR_BUILDER_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "csr_graph.hpp"
+#include "graph.hpp"
+#include "parallel.hpp"
+#include "vertex_index.hpp"
+#include "weighted_graph.hpp"
+
+namespace graph {
+
+/**
+ * @brief Проверка того, что класс графа является неориентированным.
+ *
+ * Неориентированные графы хранят каждое ребро в списках смежности обоих
+ * концов, а ориентированные - в списках исходящих и входящих рёбер.
+ */
+template<typename T>
+struct IsUndirectedGraph : std::false_type {
+};
+
+/**
+ * @brief Специализация для невзвешенных неориентированных графов.
+ */
+template<typename Containers>
+struct IsUndirectedGraph<BasicGraph<Containers>> : std::true_type {
+};
+
+/**
+ * @brief Специализация для взвешенных неориентированных графов.
+ */
+template<typename Weight, typename Containers>
+struct IsUndirectedGraph<WeightedGraph<Weight, Containers>> :
+    std::true_type {
+};
+
+/**
+ * @brief Многопоточное построение CsrGraph из списка рёбер.
+ *
+ * Рёбра делятся между потоками поровну. Степени вершин считаются
+ * атомарными счётчиками, смещения получаются префиксной суммой, после
+ * чего каждый поток раскладывает свои рёбра по отрезкам их начал. Порядок
+ * рёбер внутри отрезка при этом зависит от потоков, поэтому затем отрезки
+ * (поделённые между потоками по количеству рёбер, а не вершин)
+ * сортируются по индексу соседа и номеру ребра в списке, и из повторных
+ * рёбер остаётся последнее.
+ *
+ * Результат совпадает с CsrGraph, построенным из графа, в который рёбра
+ * добавлены по порядку функцией AddEdge(), и не зависит от количества
+ * потоков.
+ */
+class ParallelCsrBuilder {
+ public:
+  /**
+   * @brief Конструктор.
+   *
+   * @param numThreads Количество потоков (0 - количество ядер процессора).
+   */
+  explicit ParallelCsrBuilder(size_t numThreads = 0) :
+    numThreads(numThreads == 0 ? DefaultNumThreads() : numThreads) {
+  }
+
+  /**
+   * @brief Построить CSR граф.
+   *
+   * @tparam Weight Тип веса рёбер CSR графа.
+   * @tparam Iterator Итератор произвольного доступа по рёбрам: парам
+   *         [откуда, куда] или тройкам [откуда, куда, вес].
+   *
+   * @param first Начало списка рёбер.
+   * @param last Конец списка рёбер.
+   * @param undirected Если true, то каждое ребро, кроме петель, хранится
+   *        в обоих направлениях, как в классах Graph и WeightedGraph.
+   * @param vertices Вершины, которые нужно добавить помимо концов рёбер
+   *        (например, изолированные).
+   */
+  template<typename Weight, typename Iterator>
+  CsrGraph<Weight> Build(Iterator first, Iterator last, bool undirected,
+                         const std::vector<size_t>& vertices = {}) const {
+    using Edge = typename std::iterator_traits<Iterator>::value_type;
+    constexpr bool weighted = std::tuple_size<Edge>::value == 3;
+
+    const size_t m = static_cast<size_t>(last - first);
+    CsrGraph<Weight> csr;
+
+    csr.weighted = weighted;
+    csr.index = VertexIndex(CollectIds(first, m, vertices));
+
+    const size_t n = csr.index.Size();
+
+    // Плотные индексы концов рёбер.
+    std::vector<size_t> sources(m);
+    std::vector<size_t> targets(m);
+
+    ParallelFor(m, numThreads, [&](size_t, size_t begin, size_t end) {
+      for (size_t e = begin; e < end; e++) {
+        const Edge edge = EdgeAt(first, e);
+
+        sources[e] = csr.index.Find(std::get<0>(edge));
+        targets[e] = csr.index.Find(std::get<1>(edge));
+      }
+    });
+
+    // Степени вершин вместе с повторными рёбрами.
+    std::vector<std::atomic<size_t>> cursors(n);
+
+    ParallelFor(m, numThreads, [&](size_t, size_t begin, size_t end) {
+      for (size_t e = begin; e < end; e++) {
+        cursors[sources[e]].fetch_add(1, std::memory_order_relaxed);
+        if (undirected && sources[e] != targets[e])
+          cursors[targets[e]].fetch_add(1, std::memory_order_relaxed);
+      }
+    });
+
+    const std::vector<size_t> offsets = StartCursors(&cursors);
+    std::vector<Arc<Weight>> arcs(offsets[n]);
+
+    ParallelFor(m, numThreads, [&](size_t, size_t begin, size_t end) {
+      for (size_t e = begin; e < end; e++) {
+        Weight weight = Weight();
+        if constexpr (weighted)
+          weight = static_cast<Weight>(std::get<2>(EdgeAt(first, e)));
+
+        const size_t s = sources[e];
+        const size_t t = targets[e];
+
+        arcs[cursors[s].fetch_add(1, std::memory_order_relaxed)] =
+            Arc<Weight>{t, e, weight};
+        if (undirected && s != t)
+          arcs[cursors[t].fetch_add(1, std::memory_order_relaxed)] =
+              Arc<Weight>{s, e, weight};
+      }
+    });
+
+    // Упорядочить отрезки и оставить последнее из повторных рёбер.
+    std::vector<size_t> degrees(n, 0);
+
+    ForEachVertexRange(offsets, [&](size_t begin, size_t end) {
+      for (size_t v = begin; v < end; v++) {
+        auto segment = arcs.begin() + offsets[v];
+        auto segmentEnd = arcs.begin() + offsets[v + 1];
+
+        std::sort(segment, segmentEnd,
+                  [](const Arc<Weight>& a, const Arc<Weight>& b) {
+          return a.target < b.target ||
+                 (a.target == b.target && a.order < b.order);
+        });
+
+        auto out = segment;
+        for (auto it = segment; it != segmentEnd; ++it)
+          if (it + 1 == segmentEnd || (it + 1)->target != it->target)
+            *out++ = *it;
+
+        degrees[v] = static_cast<size_t>(out - segment);
+      }
+    });
+
+    csr.offsets.assign(n + 1, 0);
+    for (size_t v = 0; v < n; v++)
+      csr.offsets[v + 1] = csr.offsets[v] + degrees[v];
+
+    csr.neighbours.resize(csr.offsets[n]);
+    if (weighted)
+      csr.weights.resize(csr.offsets[n]);
+
+    ForEachVertexRange(offsets, [&](size_t begin, size_t end) {
+      for (size_t v = begin; v < end; v++) {
+        for (size_t k = 0; k < degrees[v]; k++) {
+          const Arc<Weight>& arc = arcs[offsets[v] + k];
+
+          csr.neighbours[csr.offsets[v] + k] = arc.target;
+          if (weighted)
+            csr.weights[csr.offsets[v] + k] = arc.weight;
+        }
+      }
+    });
+
+    arcs.clear();
+    arcs.shrink_to_fit();
+
+    if (undirected) {
+      // Граф симметричен: входящие рёбра совпадают с исходящими.
+      csr.reverseOffsets = csr.offsets;
+      csr.reverseNeighbours = csr.neighbours;
+      csr.reverseWeights = csr.weights;
+    } else {
+      BuildReverse(&csr, &cursors);
+    }
+
+    return csr;
+  }
+
+ private:
+  /**
+   * @brief Дуга, разложенная по отрезку своего начала.
+   */
+  template<typename Weight>
+  struct Arc {
+    //! Индекс конца дуги.
+    size_t target;
+    //! Номер ребра в списке.
+    size_t order;
+    //! Вес ребра.
+    Weight weight;
+  };
+
+  /**
+   * @brief Прочитать ребро с номером e.
+   */
+  template<typename Iterator>
+  static auto EdgeAt(Iterator first, size_t e) {
+    using Difference =
+        typename std::iterator_traits<Iterator>::difference_type;
+
+    return typename std::iterator_traits<Iterator>::value_type(
+        first[static_cast<Difference>(e)]);
+  }
+
+  /**
+   * @brief Собрать упорядоченные номера всех вершин без повторов.
+   *
+   * @param first Начало списка рёбер.
+   * @param m Количество рёбер.
+   * @param vertices Дополнительные вершины.
+   *
+   * Каждый поток упорядочивает концы своих рёбер, после чего части
+   * попарно сливаются, тоже параллельно.
+   */
+  template<typename Iterator>
+  std::vector<size_t> CollectIds(Iterator first, size_t m,
+                                 const std::vector<size_t>& vertices) const {
+    std::vector<std::vector<size_t>> parts(numThreads);
+
+    const size_t used = ParallelFor(m, numThreads,
+                                    [&](size_t thread, size_t begin,
+                                        size_t end) {
+      std::vector<size_t>& part = parts[thread];
+
+      part.reserve(2 * (end - begin));
+      for (size_t e = begin; e < end; e++) {
+        const auto edge = EdgeAt(first, e);
+
+        part.push_back(std::get<0>(edge));
+        part.push_back(std::get<1>(edge));
+      }
+
+      std::sort(part.begin(), part.end());
+      part.erase(std::unique(part.begin(), part.end()), part.end());
+    });
+
+    parts.resize(used);
+    parts.emplace_back(vertices);
+    std::sort(parts.back().begin(), parts.back().end());
+    parts.back().erase(std::unique(parts.back().begin(), parts.back().end()),
+                       parts.back().end());
+
+    while (parts.size() > 1) {
+      std::vector<std::vector<size_t>> merged((parts.size() + 1) / 2);
+
+      ParallelFor(merged.size(), numThreads,
+                  [&](size_t, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++) {
+          if (2 * i + 1 == parts.size()) {
+            merged[i] = std::move(parts[2 * i]);
+            continue;
+          }
+
+          const std::vector<size_t>& a = parts[2 * i];
+          const std::vector<size_t>& b = parts[2 * i + 1];
+
+          merged[i].reserve(a.size() + b.size());
+          std::set_union(a.begin(), a.end(), b.begin(), b.end(),
+                         std::back_inserter(merged[i]));
+        }
+      }, 1);
+
+      parts = std::move(merged);
+    }
+
+    return std::move(parts.front());
+  }
+
+  /**
+   * @brief Превратить счётчики в позиции для раскладки.
+   *
+   * @param cursors Количество элементов каждого отрезка. Функция заменяет
+   *        их началами отрезков.
+   *
+   * Функция возвращает смещения отрезков (на один элемент больше).
+   */
+  static std::vector<size_t> StartCursors(
+      std::vector<std::atomic<size_t>>* cursors) {
+    const size_t n = cursors->size();
+    std::vector<size_t> offsets(n + 1, 0);
+
+    for (size_t v = 0; v < n; v++) {
+      offsets[v + 1] = offsets[v] +
+                       (*cursors)[v].load(std::memory_order_relaxed);
+      (*cursors)[v].store(offsets[v], std::memory_order_relaxed);
+    }
+
+    return offsets;
+  }
+
+  /**
+   * @brief Выполнить функцию параллельно для отрезков вершин.
+   *
+   * @param offsets Смещения рёбер вершин.
+   * @param function Функция function(begin, end), которая обрабатывает
+   *        вершины с индексами [begin, end).
+   *
+   * Вершины делятся между потоками так, чтобы на каждый поток пришлось
+   * примерно одинаковое количество рёбер.
+   */
+  template<typename Function>
+  void ForEachVertexRange(const std::vector<size_t>& offsets,
+                          Function function) const {
+    const size_t n = offsets.size() - 1;
+    const auto vertexEnd = offsets.begin() + static_cast<std::ptrdiff_t>(n);
+
+    ParallelFor(offsets[n], numThreads,
+                [&](size_t, size_t begin, size_t end) {
+      const size_t first = static_cast<size_t>(
+          std::lower_bound(offsets.begin(), vertexEnd, begin) -
+          offsets.begin());
+      const size_t last = end == offsets[n] ? n : static_cast<size_t>(
+          std::lower_bound(offsets.begin(), vertexEnd, end) -
+          offsets.begin());
+
+      function(first, last);
+    });
+  }
+
+  /**
+   * @brief Построить обратный CSR.
+   *
+   * @param csr CSR граф с заполненными исходящими рёбрами.
+   * @param cursors Рабочий массив счётчиков по числу вершин.
+   *
+   * Входящие рёбра раскладываются так же, как исходящие, и затем
+   * упорядочиваются по индексу начала. Повторов среди них уже нет.
+   */
+  template<typename Weight>
+  void BuildReverse(CsrGraph<Weight>* csr,
+                    std::vector<std::atomic<size_t>>* cursors) const {
+    const std::vector<size_t>& offsets = csr->offsets;
+    const std::vector<size_t>& neighbours = csr->neighbours;
+
+    for (auto& cursor : *cursors)
+      cursor.store(0, std::memory_order_relaxed);
+
+    ParallelFor(neighbours.size(), numThreads,
+                [&](size_t, size_t begin, size_t end) {
+      for (size_t k = begin; k < end; k++)
+        (*cursors)[neighbours[k]].fetch_add(1, std::memory_order_relaxed);
+    });
+
+    csr->reverseOffsets = StartCursors(cursors);
+
+    std::vector<std::pair<size_t, Weight>> incoming(neighbours.size());
+
+    ForEachVertexRange(offsets, [&](size_t begin, size_t end) {
+      for (size_t v = begin; v < end; v++) {
+        for (size_t k = offsets[v]; k < offsets[v + 1]; k++) {
+          const size_t p = (*cursors)[neighbours[k]].fetch_add(
+              1, std::memory_order_relaxed);
+
+          incoming[p].first = v;
+          incoming[p].second = csr->weighted ? csr->weights[k] : Weight();
+        }
+      }
+    });
+
+    const std::vector<size_t>& reverseOffsets = csr->reverseOffsets;
+
+    csr->reverseNeighbours.resize(neighbours.size());
+    if (csr->weighted)
+      csr->reverseWeights.resize(neighbours.size());
+
+    ForEachVertexRange(reverseOffsets, [&](size_t begin, size_t end) {
+      for (size_t v = begin; v < end; v++) {
+        auto segment = incoming.begin() + reverseOffsets[v];
+        auto segmentEnd = incoming.begin() + reverseOffsets[v + 1];
+
+        std::sort(segment, segmentEnd,
+                  [](const std::pair<size_t, Weight>& a,
+                     const std::pair<size_t, Weight>& b) {
+          return a.first < b.first;
+        });
+
+        for (size_t k = reverseOffsets[v]; k < reverseOffsets[v + 1]; k++) {
+          csr->reverseNeighbours[k] = incoming[k].first;
+          if (csr->weighted)
+            csr->reverseWeights[k] = incoming[k].second;
+        }
+      }
+    });
+  }
+
+  //! Количество потоков.
+  size_t numThreads;
+};
+
+/**
+ * @brief Заполнить граф вершинами и рёбрами CSR графа.
+ *
+ * @tparam Graph Тип графа.
+ * @tparam Weight Тип веса рёбер CSR графа.
+ *
+ * @param csr CSR граф (для неориентированного графа - симметричный,
+ *        см. ParallelCsrBuilder::Build()).
+ * @param graph Граф.
+ *
+ * Степени всех вершин уже известны, поэтому место под вершины
+ * резервируется заранее, а рёбра добавляются одним вызовом AddEdges()
+ * в порядке возрастания начала: соседи каждой вершины резервируются
+ * точно по её степени и добавляются за один проход. В неориентированный
+ * граф добавляется по одной дуге каждого ребра.
+ */
+template<typename Graph, typename Weight>
+void FillGraphFromCsr(const CsrGraph<Weight>& csr, Graph* graph) {
+  const size_t n = csr.NumVertices();
+  const std::vector<size_t>& offsets = csr.Offsets();
+  const std::vector<size_t>& neighbours = csr.Neighbours();
+
+  graph->Reserve(n, csr.NumEdges());
+  for (size_t i = 0; i < n; i++)
+    graph->AddVertex(csr.Id(i));
+
+  using Edge = std::conditional_t<IsWeightedGraph<Graph>::value,
+                                  std::tuple<size_t, size_t, Weight>,
+                                  std::pair<size_t, size_t>>;
+  std::vector<Edge> edges;
+
+  edges.reserve(neighbours.size());
+  for (size_t i = 0; i < n; i++) {
+    for (size_t k = offsets[i]; k < offsets[i + 1]; k++) {
+      const size_t j = neighbours[k];
+
+      if (IsUndirectedGraph<Graph>::value && j < i)
+        continue;
+
+      if constexpr (IsWeightedGraph<Graph>::value)
+        edges.emplace_back(csr.Id(i), csr.Id(j), csr.Weights()[k]);
+      else
+        edges.emplace_back(csr.Id(i), csr.Id(j));
+    }
+  }
+
+  graph->AddEdges(edges.begin(), edges.end());
+}
+
+}  // namespace graph
+
+#endif  // INCLUDE_CSR_BUILDER_HPP_
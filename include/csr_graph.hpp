@@ -0,0 +1,521 @@
+/**
+ * @file csr_graph.hpp
+ *
+ * Реализация неизменяемого представления графа в формате CSR
+ * (compressed sparse row).
+ */
+
+#ifndef INCLUDE_CSR_GRAPH_HPP_
+#define INCLUDE_CSR_GRAPH_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "vertex_index.hpp"
+
+namespace graph {
+
+/**
+ * @brief Проверка того, что класс графа является взвешенным.
+ *
+ * Взвешенными считаются классы, в которых определён тип WeightType.
+ */
+template<typename T, typename = void>
+struct IsWeightedGraph : std::false_type {
+};
+
+/**
+ * @brief Специализация для взвешенных графов.
+ */
+template<typename T>
+struct IsWeightedGraph<T, std::void_t<typename T::WeightType>> :
+    std::true_type {
+};
+
+/**
+ * @brief Класс-промежуток для итерирования по соседям вершины в CSR графе.
+ *
+ * Соседи хранятся в виде плотных индексов, итератор переводит их
+ * в исходные номера вершин.
+ */
+class CsrNeighboursRange {
+ public:
+  /**
+   * @brief Итератор по соседям вершины.
+   */
+  class Iterator {
+   public:
+    //! Категория итератора.
+    using iterator_category = std::forward_iterator_tag;
+    //! Тип значения итератора.
+    using value_type = size_t;
+    //! Тип разности итераторов.
+    using difference_type = std::ptrdiff_t;
+    //! Тип указателя.
+    using pointer = const size_t*;
+    //! Тип ссылки.
+    using reference = size_t;
+
+    /**
+     * @brief Конструктор итератора.
+     *
+     * @param pos Текущая позиция в массиве соседей.
+     * @param ids Массив исходных номеров вершин.
+     */
+    Iterator(const size_t* pos, const size_t* ids) :
+      pos(pos),
+      ids(ids) {
+    }
+
+    /**
+     * @brief Оператор сравнения == для итератора.
+     * @param other Другой итератор.
+     */
+    bool operator==(const Iterator& other) const {
+      return pos == other.pos;
+    }
+
+    /**
+     * @brief Оператор сравнения != для итератора.
+     * @param other Другой итератор.
+     */
+    bool operator!=(const Iterator& other) const {
+      return pos != other.pos;
+    }
+
+    /**
+     * @brief Префиксная операция инкремента для итератора.
+     */
+    Iterator& operator++() {
+      ++pos;
+      return *this;
+    }
+
+    /**
+     * @brief Постфиксная операция инкремента для итератора.
+     */
+    Iterator operator++(int) {
+      Iterator retval(*this);
+      ++pos;
+      return retval;
+    }
+
+    /**
+     * @brief Функция возвращает номер вершины, на которую
+     *        в данный момент указывает итератор.
+     */
+    size_t operator*() const {
+      return ids[*pos];
+    }
+
+   private:
+    //! Текущая позиция.
+    const size_t* pos;
+    //! Массив исходных номеров вершин.
+    const size_t* ids;
+  };
+
+  /**
+   * @brief Конструктор класса.
+   *
+   * @param first Указатель на первого соседа.
+   * @param last Указатель на соседа "после последнего".
+   * @param ids Массив исходных номеров вершин.
+   */
+  CsrNeighboursRange(const size_t* first, const size_t* last,
+                     const size_t* ids) :
+    first(first),
+    last(last),
+    ids(ids) {
+  }
+
+  /**
+   * @brief Возвращает итератор на первого соседа.
+   */
+  Iterator begin() const {
+    return Iterator(first, ids);
+  }
+
+  /**
+   * @brief Возвращает итератор на соседа "после последнего".
+   */
+  Iterator end() const {
+    return Iterator(last, ids);
+  }
+
+  /**
+   * @brief Функция возвращает количество соседей.
+   */
+  size_t size() const {
+    return static_cast<size_t>(last - first);
+  }
+
+  /**
+   * @brief Функция возвращает true, если соседей нет.
+   */
+  bool empty() const {
+    return first == last;
+  }
+
+ private:
+  //! Указатель на первого соседа.
+  const size_t* first;
+  //! Указатель на соседа "после последнего".
+  const size_t* last;
+  //! Массив исходных номеров вершин.
+  const size_t* ids;
+};
+
+class ParallelCsrBuilder;
+
+/**
+ * @brief Неизменяемое представление графа в формате CSR.
+ *
+ * @tparam Weight Тип веса рёбер.
+ *
+ * Вершины графа нумеруются плотными индексами 0..N-1 в порядке возрастания
+ * исходных номеров (см. VertexIndex). Исходящие рёбра вершины с индексом i занимают отрезок
+ * [offsets[i], offsets[i + 1]) массивов neighbours и weights. Аналогично
+ * хранятся входящие рёбра (обратный CSR). Соседи каждой вершины упорядочены
+ * по возрастанию индексов.
+ *
+ * Класс можно построить из любого из классов Graph, OrientedGraph,
+ * WeightedGraph и WeightedOrientedGraph. Для невзвешенных графов массивы
+ * весов пусты. Класс поддерживает те же функции Vertices(), Edges(),
+ * IncomingEdges(), HasVertex(), HasEdge() и EdgeWeight(), что и исходные
+ * классы, поэтому алгоритмы могут работать с ним без изменений.
+ *
+ * Из списка рёбер граф можно построить сразу, несколькими потоками
+ * (см. ParallelCsrBuilder).
+ */
+template<typename Weight = int>
+class CsrGraph {
+ public:
+  //! Тип данных для веса ребра.
+  using WeightType = Weight;
+
+  /**
+   * @brief Конструктор пустого графа.
+   */
+  CsrGraph() :
+    index(),
+    offsets(1, 0),
+    neighbours(),
+    weights(),
+    reverseOffsets(1, 0),
+    reverseNeighbours(),
+    reverseWeights(),
+    weighted(false) {
+  }
+
+  /**
+   * @brief Построить CSR представление графа.
+   *
+   * @tparam Graph Тип исходного графа.
+   *
+   * @param graph Исходный граф.
+   *
+   * Функция выполняет один проход по рёбрам исходного графа. Если граф
+   * взвешенный, то веса рёбер копируются в параллельные массивы.
+   */
+  template<typename Graph>
+  explicit CsrGraph(const Graph& graph) :
+    CsrGraph() {
+    weighted = IsWeightedGraph<Graph>::value;
+
+    index = VertexIndex(graph);
+
+    const std::vector<size_t>& ids = index.Ids();
+    const size_t n = ids.size();
+
+    offsets.assign(n + 1, 0);
+    for (size_t i = 0; i < n; i++)
+      offsets[i + 1] = offsets[i] + graph.Edges(ids[i]).size();
+
+    neighbours.resize(offsets[n]);
+    if (weighted)
+      weights.resize(offsets[n]);
+
+    std::vector<std::pair<size_t, Weight>> row;
+
+    for (size_t i = 0; i < n; i++) {
+      row.clear();
+
+      if constexpr (IsWeightedGraph<Graph>::value) {
+        for (const auto& [to, weight] : graph.WeightedEdges(ids[i]))
+          row.emplace_back(Index(to), static_cast<Weight>(weight));
+      } else {
+        for (size_t to : graph.Edges(ids[i]))
+          row.emplace_back(Index(to), Weight());
+      }
+
+      std::sort(row.begin(), row.end(),
+                [](const std::pair<size_t, Weight>& a,
+                   const std::pair<size_t, Weight>& b) {
+        return a.first < b.first;
+      });
+
+      for (size_t k = 0; k < row.size(); k++) {
+        neighbours[offsets[i] + k] = row[k].first;
+        if (weighted)
+          weights[offsets[i] + k] = row[k].second;
+      }
+    }
+
+    BuildReverse();
+  }
+
+  /**
+   * @brief Функция проверяет, есть ли вершина в графе.
+   *
+   * @param id Номер вершины.
+   */
+  bool HasVertex(size_t id) const {
+    return index.Contains(id);
+  }
+
+  /**
+   * @brief Функция проверяет, есть ли ребро в графе.
+   *
+   * @param id1 Номер вершины, из которой выходит ребро.
+   * @param id2 Номер вершины, в которую входит ребро.
+   */
+  bool HasEdge(size_t id1, size_t id2) const {
+    const size_t i = index.Find(id1);
+    const size_t j = index.Find(id2);
+
+    if (i == VertexIndex::npos || j == VertexIndex::npos)
+      return false;
+
+    return FindEdge(i, j) != offsets.back();
+  }
+
+  /**
+   * @brief Получить соседей вершины по исходящим рёбрам.
+   *
+   * @param id Номер вершины.
+   *
+   * Если указанной вершины в графе нет, то функция выбрасывает исключение
+   * std::out_of_range.
+   */
+  CsrNeighboursRange Edges(size_t id) const {
+    const size_t i = Index(id);
+
+    return CsrNeighboursRange(neighbours.data() + offsets[i],
+                              neighbours.data() + offsets[i + 1],
+                              index.Ids().data());
+  }
+
+  /**
+   * @brief Получить соседей вершины по входящим рёбрам.
+   *
+   * @param id Номер вершины.
+   *
+   * Если указанной вершины в графе нет, то функция выбрасывает исключение
+   * std::out_of_range.
+   */
+  CsrNeighboursRange IncomingEdges(size_t id) const {
+    const size_t i = Index(id);
+
+    return CsrNeighboursRange(reverseNeighbours.data() + reverseOffsets[i],
+                              reverseNeighbours.data() + reverseOffsets[i + 1],
+                              index.Ids().data());
+  }
+
+  /**
+   * @brief Получить вес ребра.
+   *
+   * @param id1 Номер вершины, из которой выходит ребро.
+   * @param id2 Номер вершины, в которую входит ребро.
+   *
+   * Если такого ребра в графе нет или граф невзвешенный, то функция
+   * генерирует исключение std::out_of_range.
+   */
+  const Weight& EdgeWeight(size_t id1, size_t id2) const {
+    if (!weighted)
+      throw std::out_of_range("CsrGraph: the graph is not weighted");
+
+    const size_t pos = FindEdge(Index(id1), Index(id2));
+
+    if (pos == offsets.back())
+      throw std::out_of_range("CsrGraph: no such edge");
+
+    return weights[pos];
+  }
+
+  /**
+   * @brief Функция для итерирования по вершинам графа.
+   *
+   * Вершины перечисляются в порядке возрастания номеров.
+   */
+  const std::vector<size_t>& Vertices() const {
+    return index.Ids();
+  }
+
+  /**
+   * @brief Функция возвращает количество вершин в графе.
+   */
+  size_t NumVertices() const {
+    return index.Size();
+  }
+
+  /**
+   * @brief Функция возвращает количество рёбер в графе.
+   *
+   * Для неориентированных графов каждое ребро учитывается дважды.
+   */
+  size_t NumEdges() const {
+    return neighbours.size();
+  }
+
+  /**
+   * @brief Функция возвращает true, если граф взвешенный.
+   */
+  bool Weighted() const {
+    return weighted;
+  }
+
+  /**
+   * @brief Получить плотный индекс вершины.
+   *
+   * @param id Номер вершины.
+   *
+   * Если указанной вершины в графе нет, то функция выбрасывает исключение
+   * std::out_of_range.
+   */
+  size_t Index(size_t id) const {
+    return index.Index(id);
+  }
+
+  /**
+   * @brief Получить исходный номер вершины по плотному индексу.
+   *
+   * @param i Плотный индекс вершины.
+   */
+  size_t Id(size_t i) const {
+    return index.Id(i);
+  }
+
+  /**
+   * @brief Отображение номеров вершин в плотные индексы.
+   */
+  const VertexIndex& Indices() const {
+    return index;
+  }
+
+  //! Массив смещений исходящих рёбер (размер N + 1).
+  const std::vector<size_t>& Offsets() const {
+    return offsets;
+  }
+
+  //! Массив индексов соседей по исходящим рёбрам.
+  const std::vector<size_t>& Neighbours() const {
+    return neighbours;
+  }
+
+  //! Массив весов исходящих рёбер.
+  const std::vector<Weight>& Weights() const {
+    return weights;
+  }
+
+  //! Массив смещений входящих рёбер (размер N + 1).
+  const std::vector<size_t>& ReverseOffsets() const {
+    return reverseOffsets;
+  }
+
+  //! Массив индексов соседей по входящим рёбрам.
+  const std::vector<size_t>& ReverseNeighbours() const {
+    return reverseNeighbours;
+  }
+
+  //! Массив весов входящих рёбер.
+  const std::vector<Weight>& ReverseWeights() const {
+    return reverseWeights;
+  }
+
+ private:
+  friend class ParallelCsrBuilder;
+
+  /**
+   * @brief Найти позицию ребра в массиве соседей.
+   *
+   * @param i Индекс вершины, из которой выходит ребро.
+   * @param j Индекс вершины, в которую входит ребро.
+   *
+   * Функция возвращает позицию ребра или offsets.back(), если ребра нет.
+   */
+  size_t FindEdge(size_t i, size_t j) const {
+    auto first = neighbours.begin() + offsets[i];
+    auto last = neighbours.begin() + offsets[i + 1];
+    auto it = std::lower_bound(first, last, j);
+
+    if (it == last || *it != j)
+      return offsets.back();
+
+    return static_cast<size_t>(it - neighbours.begin());
+  }
+
+  /**
+   * @brief Построить обратный CSR сортировкой подсчётом.
+   *
+   * Поскольку исходящие рёбра перебираются в порядке возрастания индекса
+   * начала, входящие рёбра каждой вершины также оказываются упорядоченными.
+   */
+  void BuildReverse() {
+    const size_t n = index.Size();
+
+    reverseOffsets.assign(n + 1, 0);
+    for (size_t to : neighbours)
+      reverseOffsets[to + 1]++;
+    for (size_t i = 0; i < n; i++)
+      reverseOffsets[i + 1] += reverseOffsets[i];
+
+    reverseNeighbours.resize(neighbours.size());
+    if (weighted)
+      reverseWeights.resize(neighbours.size());
+
+    std::vector<size_t> pos(reverseOffsets.begin(), reverseOffsets.end() - 1);
+
+    for (size_t i = 0; i < n; i++) {
+      for (size_t k = offsets[i]; k < offsets[i + 1]; k++) {
+        const size_t p = pos[neighbours[k]]++;
+
+        reverseNeighbours[p] = i;
+        if (weighted)
+          reverseWeights[p] = weights[k];
+      }
+    }
+  }
+
+  //! Отображение номеров вершин в плотные индексы.
+  VertexIndex index;
+
+  //! Смещения исходящих рёбер.
+  std::vector<size_t> offsets;
+
+  //! Индексы соседей по исходящим рёбрам.
+  std::vector<size_t> neighbours;
+
+  //! Веса исходящих рёбер.
+  std::vector<Weight> weights;
+
+  //! Смещения входящих рёбер.
+  std::vector<size_t> reverseOffsets;
+
+  //! Индексы соседей по входящим рёбрам.
+  std::vector<size_t> reverseNeighbours;
+
+  //! Веса входящих рёбер.
+  std::vector<Weight> reverseWeights;
+
+  //! Признак взвешенного графа.
+  bool weighted;
+};
+
+}  // namespace graph
+
+#endif  // INCLUDE_CSR_GRAPH_HPP_
@@ -0,0 +1,109 @@
+/**
+ * @file d_ary_heap.hpp
+ *
+ * Реализация d-арной кучи.
+ */
+
+#ifndef INCLUDE_D_ARY_HEAP_HPP_
+#define INCLUDE_D_ARY_HEAP_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+/**
+ * @brief Неявная d-арная куча с минимумом в корне.
+ *
+ * @tparam Key Тип ключа.
+ * @tparam Value Тип значения.
+ * @tparam D Количество детей у каждого узла.
+ *
+ * По сравнению с двоичной кучей высота дерева меньше в log2(D) раз,
+ * а дети узла лежат в памяти подряд, поэтому при D = 4 добавление
+ * и просеивание вниз работают быстрее.
+ */
+template<typename Key, typename Value, size_t D = 4>
+class DAryHeap {
+  static_assert(D >= 2, "DAryHeap requires at least two children per node");
+
+ public:
+  /**
+   * @brief Функция возвращает true, если куча пуста.
+   */
+  bool Empty() const {
+    return items.empty();
+  }
+
+  /**
+   * @brief Функция возвращает количество элементов в куче.
+   */
+  size_t Size() const {
+    return items.size();
+  }
+
+  /**
+   * @brief Добавить элемент.
+   *
+   * @param key Ключ.
+   * @param value Значение.
+   */
+  void Push(Key key, Value value) {
+    items.emplace_back(std::move(key), std::move(value));
+
+    size_t i = items.size() - 1;
+    while (i > 0) {
+      const size_t parent = (i - 1) / D;
+
+      if (!(items[i].first < items[parent].first))
+        break;
+
+      std::swap(items[i], items[parent]);
+      i = parent;
+    }
+  }
+
+  /**
+   * @brief Извлечь элемент с минимальным ключом.
+   *
+   * Куча не должна быть пустой.
+   */
+  std::pair<Key, Value> Pop() {
+    std::pair<Key, Value> result = std::move(items[0]);
+
+    if (items.size() > 1)
+      items[0] = std::move(items.back());
+    items.pop_back();
+
+    size_t i = 0;
+    while (true) {
+      const size_t first = i * D + 1;
+      if (first >= items.size())
+        break;
+
+      const size_t end = std::min(first + D, items.size());
+      size_t best = first;
+      for (size_t child = first + 1; child < end; child++)
+        if (items[child].first < items[best].first)
+          best = child;
+
+      if (!(items[best].first < items[i].first))
+        break;
+
+      std::swap(items[i], items[best]);
+      i = best;
+    }
+
+    return result;
+  }
+
+ private:
+  //! Элементы кучи в порядке обхода в ширину.
+  std::vector<std::pair<Key, Value>> items;
+};
+
+}  // namespace graph
+
+#endif  // INCLUDE_D_ARY_HEAP_HPP_
@@ -0,0 +1,123 @@
+/**
+ * @file dfs.hpp
+ *
+ * Нерекурсивный обход графа в глубину.
+ */
+
+#ifndef INCLUDE_DFS_HPP_
+#define INCLUDE_DFS_HPP_
+
+#include <cstddef>
+#include <vector>
+#include "vertex_index.hpp"
+
+namespace graph {
+
+/**
+ * @brief Обработчик событий обхода в глубину, который ничего не делает.
+ *
+ * Классы-обработчики для DepthFirstSearch() наследуются от него
+ * и переопределяют (скрывают) только нужные им функции.
+ */
+struct DfsVisitor {
+  /**
+   * @brief Вход в вершину.
+   *
+   * @param v Индекс вершины.
+   * @param parent Индекс предка в дереве обхода (VertexIndex::npos
+   *        для корня).
+   */
+  void Enter(size_t /* v */, size_t /* parent */) {
+  }
+
+  /**
+   * @brief Выход из вершины: все её потомки уже обработаны.
+   *
+   * @param v Индекс вершины.
+   * @param parent Индекс предка в дереве обхода (VertexIndex::npos
+   *        для корня).
+   */
+  void Exit(size_t /* v */, size_t /* parent */) {
+  }
+
+  /**
+   * @brief Обратное ребро: ребро в вершину, которая ещё находится в стеке
+   *        обхода (в том числе в предка v).
+   *
+   * @param v Индекс вершины, из которой идёт ребро.
+   * @param to Индекс вершины, в которую идёт ребро.
+   */
+  void BackEdge(size_t /* v */, size_t /* to */) {
+  }
+};
+
+/**
+ * @brief Обход в глубину всех вершин графа с явным стеком.
+ *
+ * @tparam Visitor Тип обработчика событий (см. DfsVisitor).
+ *
+ * @param offsets Смещения списков соседей (размер N + 1, как в CsrGraph).
+ * @param neighbours Индексы соседей.
+ * @param visitor Обработчик событий.
+ *
+ * Обход запускается по очереди из всех ещё не посещённых вершин
+ * в порядке возрастания индексов. Вместо рекурсии используется стек
+ * кадров (вершина, предок, позиция следующего ребра), поэтому глубина
+ * обхода ограничена только памятью, а не размером стека вызовов. Рёбра
+ * в уже полностью обработанные вершины пропускаются.
+ */
+template<typename Visitor>
+void DepthFirstSearch(const std::vector<size_t>& offsets,
+                      const std::vector<size_t>& neighbours,
+                      Visitor* visitor) {
+  // Кадр стека обхода.
+  struct Frame {
+    size_t v;
+    size_t parent;
+    size_t next;
+  };
+
+  // Состояния вершин: не посещена, в стеке, обработана.
+  enum : char { kWhite, kGray, kBlack };
+
+  const size_t n = offsets.size() - 1;
+  std::vector<char> state(n, kWhite);
+  std::vector<Frame> stack;
+
+  for (size_t root = 0; root < n; root++) {
+    if (state[root] != kWhite)
+      continue;
+
+    state[root] = kGray;
+    visitor->Enter(root, VertexIndex::npos);
+    stack.push_back({root, VertexIndex::npos, offsets[root]});
+
+    while (!stack.empty()) {
+      Frame& frame = stack.back();
+      const size_t v = frame.v;
+
+      if (frame.next == offsets[v + 1]) {
+        const size_t parent = frame.parent;
+
+        stack.pop_back();
+        state[v] = kBlack;
+        visitor->Exit(v, parent);
+        continue;
+      }
+
+      const size_t to = neighbours[frame.next++];
+
+      if (state[to] == kWhite) {
+        state[to] = kGray;
+        visitor->Enter(to, v);
+        stack.push_back({to, v, offsets[to]});
+      } else if (state[to] == kGray) {
+        visitor->BackEdge(v, to);
+      }
+    }
+  }
+}
+
+}  // namespace graph
+
+#endif  // INCLUDE_DFS_HPP_
@@ -0,0 +1,80 @@
+/**
+ * @file dijkstra.hpp
+ *
+ * Реализация алгоритма Дейкстры.
+ */
+
+#ifndef INCLUDE_DIJKSTRA_HPP_
+#define INCLUDE_DIJKSTRA_HPP_
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+#include "belmanf.hpp"
+#include "csr_graph.hpp"
+#include "d_ary_heap.hpp"
+#include "radix_heap.hpp"
+
+namespace graph {
+
+/**
+ * @brief Алгоритм Дейкстры.
+ *
+ * @tparam Weight Тип веса рёбер.
+ *
+ * @param graph Граф в формате CSR. Веса всех рёбер должны быть
+ *        неотрицательными.
+ * @param source Индекс начальной вершины.
+ * @param result Результат в том же формате, что и у BellmanFord().
+ *
+ * Для целых весов используется поразрядная куча (RadixHeap), для дробных -
+ * 4-арная куча (DAryHeap). Вместо уменьшения ключа в кучу добавляется
+ * новый элемент, а устаревшие элементы пропускаются при извлечении.
+ * Алгоритм выполняется за O(M log N).
+ */
+template<typename Weight>
+void Dijkstra(const CsrGraph<Weight>& graph, size_t source,
+              ShortestPaths<Weight>* result) {
+  using Key = typename std::conditional<std::is_integral<Weight>::value,
+      std::make_unsigned<Weight>, std::common_type<Weight>>::type::type;
+  using Heap = typename std::conditional<std::is_integral<Weight>::value,
+      RadixHeap<Key, size_t>, DAryHeap<Key, size_t, 4>>::type;
+
+  const size_t n = graph.NumVertices();
+  const std::vector<size_t>& offsets = graph.Offsets();
+  const std::vector<size_t>& neighbours = graph.Neighbours();
+  const std::vector<Weight>& weights = graph.Weights();
+
+  result->Reset(n, source);
+
+  std::vector<bool> done(n, false);
+  Heap heap;
+
+  heap.Push(Key(), source);
+
+  while (!heap.Empty()) {
+    const size_t v = heap.Pop().second;
+
+    if (done[v])
+      continue;
+    done[v] = true;
+
+    for (size_t k = offsets[v]; k < offsets[v + 1]; k++) {
+      const size_t to = neighbours[k];
+      const Weight candidate = result->distance[v] + weights[k];
+
+      if (done[to] ||
+          (result->reached[to] && !(candidate < result->distance[to])))
+        continue;
+
+      result->reached[to] = true;
+      result->distance[to] = candidate;
+      result->parent[to] = v;
+      heap.Push(static_cast<Key>(candidate), to);
+    }
+  }
+}
+
+}  // namespace graph
+
+#endif  // INCLUDE_DIJKSTRA_HPP_
@@ -9,193 +9,179 @@
 #define INCLUDE_DINIC_HPP_
 
 #include <cstddef>
-#include <cassert>
-#include <unordered_map>
-#include <list>
-#include <stdexcept>
-#include <limits>
 #include <vector>
-#include <utility>
 #include "weighted_oriented_graph.hpp"
+#include "flow_network.hpp"
+#include "vertex_index.hpp"
 
 namespace graph {
 
+/**
+ * @brief Построить слоистую сеть обходом в ширину.
+ *
+ * @tparam Weight Тип пропускной способности рёбер.
+ *
+ * @param network Остаточная сеть.
+ * @param s Индекс истока.
+ * @param t Индекс стока.
+ * @param level Расстояния от истока по дугам с положительной остаточной
+ *        пропускной способностью (-1 для недостижимых вершин).
+ * @param queue Буфер для очереди обхода.
+ *
+ * Функция возвращает true, если сток достижим из истока.
+ */
 template<typename Weight>
-void Dinic(const graph::WeightedOrientedGraph<Weight> &g,
-  graph::WeightedOrientedGraph<Weight> *result,
-  const size_t s, const size_t t);
-template<typename Weight>
-bool BFS(const size_t cur, graph::WeightedOrientedGraph<Weight> *level,
-  graph::WeightedOrientedGraph<Weight> *result,
-  const size_t s, const size_t t, Weight *min);
+bool DinicLevels(const FlowNetwork<Weight>& network, size_t s, size_t t,
+                 std::vector<int>* level, std::vector<size_t>* queue) {
+  level->assign(network.NumVertices(), -1);
+  queue->clear();
 
+  (*level)[s] = 0;
+  queue->push_back(s);
 
+  for (size_t head = 0; head < queue->size(); head++) {
+    const size_t v = (*queue)[head];
+
+    for (size_t i = network.Begin(v); i < network.End(v); i++) {
+      const size_t e = network.Adjacency()[i];
+      const size_t to = network.Head(e);
+
+      if ((*level)[to] == -1 && network.Residual(e) > Weight()) {
+        (*level)[to] = (*level)[v] + 1;
+        queue->push_back(to);
+      }
+    }
+  }
+
+  return (*level)[t] != -1;
+}
 
-template<typename Weight>
 /**
- * @brief Алгоритма Диница.
+ * @brief Найти блокирующий поток в слоистой сети.
  *
- * @param g исходный граф.
- * @param result поток.
- * @param s исток.
- * @param t сток.
+ * @tparam Weight Тип пропускной способности рёбер.
+ *
+ * @param network Остаточная сеть.
+ * @param s Индекс истока.
+ * @param t Индекс стока.
+ * @param level Слоистая сеть (см. DinicLevels()). Тупиковые вершины
+ *        помечаются значением -1.
+ * @param current Указатели на текущую дугу каждой вершины (позиции
+ *        в массиве FlowNetwork::Adjacency()).
+ * @param path Буфер для стека дуг текущего пути.
+ *
+ * Поиск в глубину выполняется без рекурсии: путь от истока хранится в стеке
+ * дуг. Дуга, по которой нельзя дойти до стока, больше не просматривается
+ * в этой фазе (указатель текущей дуги сдвигается), поэтому фаза выполняется
+ * за O(nm). Функция возвращает величину найденного блокирующего потока.
  */
-void Dinic(const graph::WeightedOrientedGraph<Weight> &g,
-  graph::WeightedOrientedGraph<Weight> *result,
-  const size_t s, const size_t t) {
-#ifdef DINIC_DEBUG
-  printf("\nDINIC\n");
-  printf("SIZE: %d\n", g.NumVertices());
-  printf("INPUT:\n");
-  for (size_t v : g.Vertices())
-  for (size_t e : g.Edges(v))
-    printf("Edge: (%zu, %zu, %zu)\n",
-      v, e, g.EdgeWeight(v, e));
-#endif  // DINIC_DEBUG
-
-  std::vector<std::pair<size_t, size_t>> edges;
-  std::vector<size_t> verts;
-
-  for (size_t v : result->Vertices()) {
-    for (size_t e : result->Edges(v))
-      edges.push_back(std::pair<size_t, size_t>(v, e));
-    verts.push_back(v);
-  }
-
-  for (auto e : edges)
-    result->RemoveEdge(std::get<0>(e), std::get<1>(e));
-
-  for (size_t v : verts)
-    result->RemoveVertex(v);
-
-  // Создать копию графа g с нулевыми весами
-  for (size_t v : g.Vertices())
-    result->AddVertex(v);
-  for (size_t v : g.Vertices())
-    for (size_t e : g.Edges(v))
-      result->AddEdge(v, e, 0);
-  assert(g.NumVertices() == result->NumVertices());
-
-  // Построить остаточную сеть с нулевыми весами
-  graph::WeightedOrientedGraph<Weight> residual;
-  for (size_t v : g.Vertices())
-    residual.AddVertex(v);
-  for (size_t v : g.Vertices())
-    for (size_t e : g.Edges(v)) {
-      residual.AddEdge(v, e, 0);
-      residual.AddEdge(e, v, 0);
-    }
+template<typename Weight>
+Weight DinicBlockingFlow(FlowNetwork<Weight>* network, size_t s, size_t t,
+                         std::vector<int>* level,
+                         std::vector<size_t>* current,
+                         std::vector<size_t>* path) {
+  Weight total = Weight();
+  size_t v = s;
 
-  // Слоистая сеть
-  graph::WeightedOrientedGraph<Weight> level;
-  for (size_t v : g.Vertices())
-    level.AddVertex(v);
+  path->clear();
 
   while (true) {
-    // Обновить остаточную сеть
-    for (size_t v : g.Vertices())
-      for (size_t e : g.Edges(v)) {
-        residual.EdgeWeight(v, e) = 0;
-        residual.EdgeWeight(e, v) = 0;
-      }
-    for (size_t v : g.Vertices())
-      for (size_t e : g.Edges(v)) {
-        residual.EdgeWeight(v, e) +=
-          g.EdgeWeight(v, e) -
-          result->EdgeWeight(v, e);
-        residual.EdgeWeight(e, v) +=
-         result->EdgeWeight(v, e);
-      }
-#ifdef DINIC_DEBUG
-    printf("\nRESIDUAL:\n");
-    for (size_t v : residual.Vertices())
-      for (size_t e : residual.Edges(v))
-        printf("Edge: (%zu, %zu, %zu)\n", v, e,
-            residual.EdgeWeight(v, e));
-#endif  // DINIC_DEBUG
-
-    // Обновить слоистую сеть
-    std::unordered_map<size_t, int> distance;
-    for (size_t v : g.Vertices())
-      distance[v] = -1;
-    std::list<size_t> queue;
-    queue.push_back(s);
-    distance[s] = 0;
-    while (!queue.empty()) {
-    const size_t cur = queue.front();
-      queue.pop_front();
-      for (size_t child : residual.Edges(cur)) {
-        const Weight weight =
-          residual.EdgeWeight(cur, child);
-        if ((distance[child] == -1 || distance[child] ==
-          distance[cur] + 1) &&
-          weight > 0) {
-          level.AddEdge(cur, child, weight);
-          distance[child] = distance[cur] + 1;
-          queue.push_back(child);
-        }
+    if (v == t) {
+      // Дошли до стока: проталкиваем поток вдоль пути.
+      Weight delta = network->Residual(path->front());
+      for (size_t e : *path)
+        if (network->Residual(e) < delta)
+          delta = network->Residual(e);
+
+      size_t saturated = path->size();
+      for (size_t i = 0; i < path->size(); i++) {
+        network->Push((*path)[i], delta);
+        if (saturated == path->size() &&
+            !(network->Residual((*path)[i]) > Weight()))
+          saturated = i;
       }
+      total += delta;
+
+      // Возвращаемся к началу первой насыщенной дуги.
+      path->resize(saturated);
+      v = path->empty() ? s : network->Head(path->back());
+      continue;
+    }
+
+    size_t& i = (*current)[v];
+    for (; i < network->End(v); i++) {
+      const size_t e = network->Adjacency()[i];
+
+      if (network->Residual(e) > Weight() &&
+          (*level)[network->Head(e)] == (*level)[v] + 1)
+        break;
     }
-#ifdef DINIC_DEBUG
-    printf("LEVEL:\n");
-    for (size_t v : level.Vertices())
-      for (size_t e : level.Edges(v))
-        printf("Edge: (%zu, %zu, %zu)\n", v, e,
-          level.EdgeWeight(v, e));
-#endif  // DINIC_DEBUG
-
-    // Прибавить блокирующий поток
-    int min = std::numeric_limits<int>::max();
-    if (!BFS(s, &level, result, s, t, &min))
-      return;
-    do {
-      min = std::numeric_limits<int>::max();;
-    } while (BFS(s, &level, result, s, t, &min));
-
-#ifdef DINIC_DEBUG
-    printf("RESULT:\n");
-    for (size_t v : result.Vertices())
-      for (size_t e : result.Edges(v))
-        printf("Edge: (%zu, %zu, %zu)\n", v, e,
-          result.EdgeWeight(v, e));
-#endif  // DINIC_DEBUG
+
+    if (i < network->End(v)) {
+      const size_t e = network->Adjacency()[i];
+
+      path->push_back(e);
+      v = network->Head(e);
+      continue;
+    }
+
+    // Из вершины v сток недостижим: убираем её из слоистой сети.
+    (*level)[v] = -1;
+
+    if (path->empty())
+      break;
+
+    v = network->Tail(path->back());
+    path->pop_back();
+    (*current)[v]++;
   }
+
+  return total;
 }
 
 /**
- * @brief Обход в глубину с выбором минимальног веса.
- * @param level слоистая сеть.
+ * @brief Алгоритма Диница.
+ *
+ * @tparam Weight Тип пропускной способности рёбер.
+ *
+ * @param g исходный граф.
  * @param result поток.
  * @param s исток.
  * @param t сток.
- * @param t минимальный вес ребра в цепочке рёбер.
- * @param cur текущая вершина.
+ *
+ * Граф result заменяется копией графа g, в которой вес каждого ребра равен
+ * потоку по нему. Функция возвращает величину максимального потока. Если
+ * истока или стока нет в графе, то поток нулевой.
  */
 template<typename Weight>
-bool BFS(const size_t cur, graph::WeightedOrientedGraph<Weight> *level,
-    graph::WeightedOrientedGraph<Weight> *result,
-    const size_t s, const size_t t, Weight *min) {
-  if (cur == t)
-    return true;
-  for (size_t child : level->Edges(cur)) {
-    const Weight weight = level->EdgeWeight(cur, child);
-    if (weight <= Weight())
-      continue;
-    if (weight < *min)
-      *min = weight;
-    const int tmp = *min;
-    if (BFS(child, level, result, s, t, min)) {
-      level->EdgeWeight(cur, child) -= *min;
-      try {
-        result->EdgeWeight(cur, child) += *min;
-      } catch (std::out_of_range &e) {
-      result->EdgeWeight(child, cur) -= *min;
-      }
-      return true;
+Weight Dinic(const graph::WeightedOrientedGraph<Weight> &g,
+  graph::WeightedOrientedGraph<Weight> *result,
+  const size_t s, const size_t t) {
+  FlowNetwork<Weight> network(g);
+  const VertexIndex& index = network.Index();
+
+  Weight flow = Weight();
+  const size_t source = index.Find(s), sink = index.Find(t);
+
+  if (source != VertexIndex::npos && sink != VertexIndex::npos &&
+      source != sink) {
+    std::vector<int> level;
+    std::vector<size_t> queue;
+    std::vector<size_t> current(network.NumVertices());
+    std::vector<size_t> path;
+
+    while (DinicLevels(network, source, sink, &level, &queue)) {
+      for (size_t v = 0; v < network.NumVertices(); v++)
+        current[v] = network.Begin(v);
+
+      flow += DinicBlockingFlow(&network, source, sink, &level, &current,
+                                &path);
     }
-    *min = tmp;
   }
-  return false;
+
+  network.ExtractFlow(result);
+
+  return flow;
 }
 
 }  //  namespace graph
@@ -0,0 +1,137 @@
+/**
+ * @file disjoint_set.hpp
+ *
+ * Реализация системы непересекающихся множеств.
+ */
+
+#ifndef INCLUDE_DISJOINT_SET_HPP_
+#define INCLUDE_DISJOINT_SET_HPP_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+/**
+ * @brief Система непересекающихся множеств (union-find).
+ *
+ * Элементы пронумерованы числами 0..N-1, например плотными индексами
+ * вершин графа (см. VertexIndex). Используются эвристики сжатия путей
+ * и объединения по рангу, поэтому амортизированное время каждой операции
+ * равно O(α(N)), где α - обратная функция Аккермана.
+ */
+class DisjointSet {
+ public:
+  /**
+   * @brief Создать N одноэлементных множеств.
+   *
+   * @param n Количество элементов.
+   */
+  explicit DisjointSet(size_t n = 0) :
+    parent(n),
+    rank(n, 0),
+    size(n, 1),
+    numSets(n) {
+    for (size_t i = 0; i < n; i++)
+      parent[i] = i;
+  }
+
+  /**
+   * @brief Функция возвращает количество элементов.
+   */
+  size_t NumElements() const {
+    return parent.size();
+  }
+
+  /**
+   * @brief Функция возвращает количество множеств.
+   */
+  size_t NumSets() const {
+    return numSets;
+  }
+
+  /**
+   * @brief Найти представителя множества, содержащего элемент.
+   *
+   * @param x Элемент.
+   *
+   * Все элементы на пути от x до корня подвешиваются прямо к корню.
+   */
+  size_t Find(size_t x) {
+    size_t root = x;
+
+    while (parent[root] != root)
+      root = parent[root];
+
+    while (parent[x] != root) {
+      const size_t next = parent[x];
+      parent[x] = root;
+      x = next;
+    }
+
+    return root;
+  }
+
+  /**
+   * @brief Объединить множества, содержащие элементы x и y.
+   *
+   * @param x Первый элемент.
+   * @param y Второй элемент.
+   *
+   * Функция возвращает true, если элементы лежали в разных множествах,
+   * и false, если они уже были в одном множестве.
+   */
+  bool Union(size_t x, size_t y) {
+    x = Find(x);
+    y = Find(y);
+
+    if (x == y)
+      return false;
+
+    if (rank[x] < rank[y])
+      std::swap(x, y);
+
+    parent[y] = x;
+    size[x] += size[y];
+    if (rank[x] == rank[y])
+      rank[x]++;
+
+    numSets--;
+
+    return true;
+  }
+
+  /**
+   * @brief Функция проверяет, лежат ли элементы в одном множестве.
+   *
+   * @param x Первый элемент.
+   * @param y Второй элемент.
+   */
+  bool Connected(size_t x, size_t y) {
+    return Find(x) == Find(y);
+  }
+
+  /**
+   * @brief Функция возвращает размер множества, содержащего элемент.
+   *
+   * @param x Элемент.
+   */
+  size_t SetSize(size_t x) {
+    return size[Find(x)];
+  }
+
+ private:
+  //! Родитель элемента в дереве множества.
+  std::vector<size_t> parent;
+  //! Ранг корня (верхняя оценка высоты дерева).
+  std::vector<unsigned char> rank;
+  //! Размер множества (корректен только для корней).
+  std::vector<size_t> size;
+  //! Количество множеств.
+  size_t numSets;
+};
+
+}  // namespace graph
+
+#endif  // INCLUDE_DISJOINT_SET_HPP_
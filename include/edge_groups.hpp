@@ -0,0 +1,123 @@
+/**
+ * @file edge_groups.hpp
+ *
+ * Вспомогательные функции для массового добавления рёбер в граф: дуги
+ * группируются по началу, и каждая вершина заполняется за один проход.
+ */
+
+#ifndef INCLUDE_EDGE_GROUPS_HPP_
+#define INCLUDE_EDGE_GROUPS_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace graph {
+
+/**
+ * @brief Вектор дуг, память для которого берётся из аллокатора графа.
+ *
+ * @tparam Arc Тип дуги: пара (откуда, куда) или тройка (откуда, куда, вес).
+ * @tparam Allocator Аллокатор графа.
+ */
+template<typename Arc, typename Allocator>
+using ArcVector = std::vector<Arc, typename std::allocator_traits<Allocator>::
+                                       template rebind_alloc<Arc>>;
+
+/**
+ * @brief Зарезервировать место под рёбра промежутка.
+ *
+ * @param arcs Вектор дуг.
+ * @param first Начало промежутка рёбер.
+ * @param last Конец промежутка рёбер.
+ * @param perEdge Сколько дуг получается из одного ребра.
+ *
+ * Для однопроходных итераторов функция ничего не делает.
+ */
+template<typename Vector, typename Iterator>
+void ReserveArcs(Vector* arcs, Iterator first, Iterator last,
+                 size_t perEdge) {
+  using Category = typename std::iterator_traits<Iterator>::iterator_category;
+
+  if constexpr (std::is_base_of<std::forward_iterator_tag, Category>::value)
+    arcs->reserve(perEdge * static_cast<size_t>(std::distance(first, last)));
+}
+
+/**
+ * @brief Упорядочить дуги по началу.
+ *
+ * @param arcs Вектор дуг.
+ *
+ * Дуги с общим началом остаются в исходном порядке, поэтому при
+ * повторном ребре побеждает последний вес, как и при вызовах AddEdge().
+ * Уже упорядоченные дуги (например, из CSR графа) не сортируются.
+ */
+template<typename Vector>
+void SortArcsBySource(Vector* arcs) {
+  using Arc = typename Vector::value_type;
+
+  auto bySource = [](const Arc& a, const Arc& b) {
+    return std::get<0>(a) < std::get<0>(b);
+  };
+
+  if (!std::is_sorted(arcs->begin(), arcs->end(), bySource))
+    std::stable_sort(arcs->begin(), arcs->end(), bySource);
+}
+
+/**
+ * @brief Обойти группы дуг с общим началом.
+ *
+ * @param arcs Упорядоченный функцией SortArcsBySource() вектор дуг.
+ * @param visit Функция visit(source, first, last), которая вызывается для
+ *        каждой группы [first, last) дуг, выходящих из вершины source.
+ */
+template<typename Vector, typename Visit>
+void ForEachArcGroup(const Vector& arcs, Visit visit) {
+  auto first = arcs.begin();
+
+  while (first != arcs.end()) {
+    const size_t source = std::get<0>(*first);
+    auto last = first;
+
+    while (last != arcs.end() && std::get<0>(*last) == source)
+      ++last;
+
+    visit(source, first, last);
+    first = last;
+  }
+}
+
+/**
+ * @brief Добавить в словарь смежности начала всех дуг.
+ *
+ * @param map Словарь смежности графа.
+ * @param arcs Упорядоченный функцией SortArcsBySource() вектор дуг.
+ *
+ * Словарь перестраивается не более одного раза: сначала считаются
+ * вершины, которых в нём ещё нет, и место под них резервируется заранее.
+ */
+template<typename Map, typename Vector>
+void AddArcSources(Map* map, const Vector& arcs) {
+  size_t added = 0;
+
+  ForEachArcGroup(arcs, [&](size_t source, auto, auto) {
+    if (map->find(source) == map->end())
+      added++;
+  });
+
+  if (added == 0)
+    return;
+
+  map->reserve(map->size() + added);
+  ForEachArcGroup(arcs, [&](size_t source, auto, auto) {
+    (*map)[source];
+  });
+}
+
+}  // namespace graph
+
+#endif  // INCLUDE_EDGE_GROUPS_HPP_
@@ -0,0 +1,833 @@
+/**
+ * @file flat_hash.hpp
+ *
+ * Хеш-таблицы с открытой адресацией (Robin Hood hashing) и политики
+ * контейнеров для классов графов.
+ */
+
+#ifndef INCLUDE_FLAT_HASH_HPP_
+#define INCLUDE_FLAT_HASH_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+
+namespace graph {
+
+/**
+ * @brief Заменить аллокатор контейнера копией другого аллокатора.
+ *
+ * @tparam Alloc Тип аллокатора.
+ *
+ * @param target Аллокатор контейнера.
+ * @param source Новый аллокатор.
+ *
+ * Контейнеры этой библиотеки при перемещении забирают аллокатор вместе
+ * с памятью, но у std::pmr::polymorphic_allocator нет оператора
+ * присваивания, поэтому аллокатор пересоздаётся на месте.
+ */
+template<typename Alloc>
+void ReplaceAllocator(Alloc* target, const Alloc& source) {
+  if (target == &source)
+    return;
+  target->~Alloc();
+  new (target) Alloc(source);
+}
+
+/**
+ * @brief Хеш-таблица с открытой адресацией.
+ *
+ * @tparam Key Тип ключа.
+ * @tparam Entry Тип элемента таблицы (ключ или пара ключ-значение).
+ * @tparam KeyOf Функциональный объект, возвращающий ключ элемента.
+ * @tparam Hash Хеш-функция.
+ * @tparam Allocator Аллокатор (например, std::pmr::polymorphic_allocator).
+ *
+ * Все элементы лежат в одном массиве ячеек, поэтому таблица не выделяет
+ * память на каждый элемент, а поиск читает соседние ячейки. Коллизии
+ * разрешаются линейным пробированием по схеме Robin Hood: элемент,
+ * который дальше от своей ячейки, вытесняет более близкий. Благодаря
+ * этому поиск отсутствующего ключа заканчивается рано, а при удалении
+ * следующие элементы сдвигаются назад без специальных меток.
+ *
+ * Хеш ключа перемешивается умножением на константу Фибоначчи, поэтому
+ * номера вершин с постоянным шагом не собираются в одних ячейках.
+ * Вставка может переместить все элементы, удаление - соседние
+ * элементы, поэтому итераторы и ссылки на элементы после изменения
+ * таблицы недействительны. Пустая таблица не занимает памяти.
+ *
+ * Массив ячеек выделяется аллокатором таблицы. При перемещении таблица
+ * забирает аллокатор вместе с элементами, а копия получает аллокатор
+ * из select_on_container_copy_construction() (для std::pmr - память
+ * по умолчанию), поэтому копия не зависит от памяти оригинала.
+ */
+template<typename Key, typename Entry, typename KeyOf, typename Hash,
+         typename Allocator>
+class FlatHashTable {
+ private:
+  //! Ячейка таблицы.
+  struct Slot {
+    //! 0 для пустой ячейки, иначе расстояние от своей ячейки плюс один.
+    uint32_t distance = 0;
+    //! Элемент (значение по умолчанию в пустой ячейке).
+    Entry entry = Entry();
+  };
+
+  //! Аллокатор ячеек.
+  using SlotAllocator =
+      typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+  //! Операции аллокатора ячеек.
+  using SlotTraits = std::allocator_traits<SlotAllocator>;
+
+ public:
+  /**
+   * @brief Итератор по элементам таблицы.
+   *
+   * @tparam Const Является ли итератор константным.
+   */
+  template<bool Const>
+  class Iterator {
+   public:
+    //! Категория итератора.
+    using iterator_category = std::forward_iterator_tag;
+    //! Тип значения итератора.
+    using value_type = Entry;
+    //! Тип разности итераторов.
+    using difference_type = std::ptrdiff_t;
+    //! Тип указателя.
+    using pointer = std::conditional_t<Const, const Entry*, Entry*>;
+    //! Тип ссылки.
+    using reference = std::conditional_t<Const, const Entry&, Entry&>;
+
+    //! Тип указателя на ячейку.
+    using SlotPointer = std::conditional_t<Const, const Slot*, Slot*>;
+
+    /**
+     * @brief Конструктор итератора, не связанного с таблицей.
+     */
+    Iterator() :
+      pos(nullptr),
+      last(nullptr) {
+    }
+
+    /**
+     * @brief Конструктор итератора.
+     *
+     * @param pos Текущая ячейка.
+     * @param last Ячейка "после последней".
+     *
+     * Итератор сразу переходит к первой непустой ячейке.
+     */
+    Iterator(SlotPointer pos, SlotPointer last) :
+      pos(pos),
+      last(last) {
+      Skip();
+    }
+
+    /**
+     * @brief Преобразование в константный итератор.
+     */
+    template<bool C = Const, typename = std::enable_if_t<!C>>
+    operator Iterator<true>() const {
+      return Iterator<true>(pos, last);
+    }
+
+    /**
+     * @brief Оператор сравнения == для итератора.
+     * @param other Другой итератор.
+     */
+    bool operator==(const Iterator& other) const {
+      return pos == other.pos;
+    }
+
+    /**
+     * @brief Оператор сравнения != для итератора.
+     * @param other Другой итератор.
+     */
+    bool operator!=(const Iterator& other) const {
+      return pos != other.pos;
+    }
+
+    /**
+     * @brief Префиксная операция инкремента для итератора.
+     */
+    Iterator& operator++() {
+      pos++;
+      Skip();
+      return *this;
+    }
+
+    /**
+     * @brief Постфиксная операция инкремента для итератора.
+     */
+    Iterator operator++(int) {
+      Iterator retval(*this);
+      ++*this;
+      return retval;
+    }
+
+    /**
+     * @brief Функция возвращает элемент, на который указывает итератор.
+     */
+    reference operator*() const {
+      return pos->entry;
+    }
+
+    /**
+     * @brief Функция возвращает указатель на элемент.
+     */
+    pointer operator->() const {
+      return &pos->entry;
+    }
+
+   private:
+    //! Пропустить пустые ячейки.
+    void Skip() {
+      while (pos != last && pos->distance == 0)
+        pos++;
+    }
+
+    //! Текущая ячейка.
+    SlotPointer pos;
+    //! Ячейка "после последней".
+    SlotPointer last;
+  };
+
+  //! Тип итератора.
+  using iterator = Iterator<false>;
+  //! Тип константного итератора.
+  using const_iterator = Iterator<true>;
+  //! Тип элемента.
+  using value_type = Entry;
+  //! Тип ключа.
+  using key_type = Key;
+  //! Тип размера.
+  using size_type = size_t;
+  //! Тип аллокатора.
+  using allocator_type = Allocator;
+
+  /**
+   * @brief Конструктор пустой таблицы.
+   */
+  FlatHashTable() :
+    FlatHashTable(Allocator()) {
+  }
+
+  /**
+   * @brief Конструктор пустой таблицы с заданным аллокатором.
+   *
+   * @param alloc Аллокатор.
+   */
+  explicit FlatHashTable(const Allocator& alloc) :
+    slots(nullptr),
+    numEntries(0),
+    capacityLog(0),
+    allocator(alloc) {
+  }
+
+  /**
+   * @brief Конструктор копирования.
+   * @param other Другая таблица.
+   */
+  FlatHashTable(const FlatHashTable& other) :
+    slots(nullptr),
+    numEntries(other.numEntries),
+    capacityLog(other.capacityLog),
+    allocator(SlotTraits::select_on_container_copy_construction(
+        other.allocator)) {
+    if (!other.slots)
+      return;
+
+    slots = AllocateSlots(other.Capacity());
+    for (size_t i = 0; i < Capacity(); i++)
+      slots[i] = other.slots[i];
+  }
+
+  /**
+   * @brief Конструктор перемещения.
+   * @param other Другая таблица.
+   */
+  FlatHashTable(FlatHashTable&& other) noexcept :
+    slots(other.slots),
+    numEntries(other.numEntries),
+    capacityLog(other.capacityLog),
+    allocator(std::move(other.allocator)) {
+    other.slots = nullptr;
+    other.numEntries = 0;
+    other.capacityLog = 0;
+  }
+
+  /**
+   * @brief Деструктор.
+   */
+  ~FlatHashTable() {
+    FreeSlots(slots, Capacity());
+  }
+
+  /**
+   * @brief Оператор присваивания.
+   * @param other Другая таблица.
+   */
+  FlatHashTable& operator=(const FlatHashTable& other) {
+    if (this != &other)
+      *this = FlatHashTable(other);
+    return *this;
+  }
+
+  /**
+   * @brief Оператор перемещения.
+   * @param other Другая таблица.
+   */
+  FlatHashTable& operator=(FlatHashTable&& other) noexcept {
+    if (this == &other)
+      return *this;
+
+    FreeSlots(slots, Capacity());
+    slots = other.slots;
+    numEntries = other.numEntries;
+    capacityLog = other.capacityLog;
+    ReplaceAllocator(&allocator, other.allocator);
+    other.slots = nullptr;
+    other.numEntries = 0;
+    other.capacityLog = 0;
+    return *this;
+  }
+
+  /**
+   * @brief Функция возвращает аллокатор таблицы.
+   */
+  Allocator get_allocator() const {
+    return Allocator(allocator);
+  }
+
+  /**
+   * @brief Функция возвращает итератор на первый элемент.
+   */
+  iterator begin() {
+    return iterator(slots, slots + Capacity());
+  }
+
+  /**
+   * @brief Функция возвращает итератор на элемент "после последнего".
+   */
+  iterator end() {
+    return iterator(slots + Capacity(), slots + Capacity());
+  }
+
+  /**
+   * @brief Функция возвращает итератор на первый элемент.
+   */
+  const_iterator begin() const {
+    return const_iterator(slots, slots + Capacity());
+  }
+
+  /**
+   * @brief Функция возвращает итератор на элемент "после последнего".
+   */
+  const_iterator end() const {
+    return const_iterator(slots + Capacity(), slots + Capacity());
+  }
+
+  /**
+   * @brief Функция возвращает количество элементов.
+   */
+  size_t size() const {
+    return numEntries;
+  }
+
+  /**
+   * @brief Функция возвращает true, если таблица пуста.
+   */
+  bool empty() const {
+    return numEntries == 0;
+  }
+
+  /**
+   * @brief Удалить все элементы и освободить память.
+   */
+  void clear() {
+    FreeSlots(slots, Capacity());
+    slots = nullptr;
+    numEntries = 0;
+    capacityLog = 0;
+  }
+
+  /**
+   * @brief Подготовить таблицу к хранению n элементов без перестроения.
+   *
+   * @param n Количество элементов.
+   */
+  void reserve(size_t n) {
+    if (n == 0)
+      return;
+
+    size_t log = capacityLog == 0 ? kMinCapacityLog : capacityLog;
+    while (!Fits(n, log))
+      log++;
+    if (log != capacityLog)
+      Rehash(log);
+  }
+
+  /**
+   * @brief Найти элемент по ключу.
+   *
+   * @param key Ключ.
+   */
+  iterator find(const Key& key) {
+    const size_t pos = Find(key);
+    if (pos == kNotFound)
+      return end();
+    return iterator(slots + pos, slots + Capacity());
+  }
+
+  /**
+   * @brief Найти элемент по ключу.
+   *
+   * @param key Ключ.
+   */
+  const_iterator find(const Key& key) const {
+    const size_t pos = Find(key);
+    if (pos == kNotFound)
+      return end();
+    return const_iterator(slots + pos, slots + Capacity());
+  }
+
+  /**
+   * @brief Функция возвращает 1, если ключ есть в таблице, и 0 иначе.
+   *
+   * @param key Ключ.
+   */
+  size_t count(const Key& key) const {
+    return Find(key) == kNotFound ? 0 : 1;
+  }
+
+  /**
+   * @brief Удалить элемент по ключу.
+   *
+   * @param key Ключ.
+   * @return Функция возвращает количество удалённых элементов (0 или 1).
+   */
+  size_t erase(const Key& key) {
+    size_t pos = Find(key);
+    if (pos == kNotFound)
+      return 0;
+
+    // Следующие элементы, стоящие не на своих местах, сдвигаются назад.
+    const size_t mask = Capacity() - 1;
+    size_t next = (pos + 1) & mask;
+    while (slots[next].distance > 1) {
+      slots[pos].entry = std::move(slots[next].entry);
+      slots[pos].distance = slots[next].distance - 1;
+      pos = next;
+      next = (next + 1) & mask;
+    }
+
+    slots[pos] = Slot();
+    numEntries--;
+    return 1;
+  }
+
+ protected:
+  /**
+   * @brief Вставить элемент, если его ключа ещё нет в таблице.
+   *
+   * @param key Ключ.
+   * @param make Функция, создающая элемент.
+   * @return Функция возвращает номер ячейки элемента с этим ключом
+   * и true, если элемент был вставлен.
+   */
+  template<typename Make>
+  std::pair<size_t, bool> Insert(const Key& key, Make make) {
+    size_t pos = Find(key);
+    if (pos != kNotFound)
+      return {pos, false};
+
+    if (!Fits(numEntries + 1, capacityLog))
+      Rehash(capacityLog == 0 ? kMinCapacityLog : capacityLog + 1);
+
+    numEntries++;
+    return {Place(Slot{1, make()}, Home(key)), true};
+  }
+
+  /**
+   * @brief Функция возвращает элемент в ячейке pos.
+   *
+   * @param pos Номер ячейки.
+   */
+  Entry& At(size_t pos) {
+    return slots[pos].entry;
+  }
+
+  /**
+   * @brief Функция возвращает итератор на ячейку pos.
+   *
+   * @param pos Номер ячейки.
+   */
+  iterator IteratorAt(size_t pos) {
+    return iterator(slots + pos, slots + Capacity());
+  }
+
+  /**
+   * @brief Найти ячейку с ключом.
+   *
+   * @param key Ключ.
+   * @return Номер ячейки или kNotFound.
+   */
+  size_t Find(const Key& key) const {
+    if (numEntries == 0)
+      return kNotFound;
+
+    const size_t mask = Capacity() - 1;
+    size_t pos = Home(key);
+
+    // Элементы в цепочке стоят не дальше от своих ячеек, чем искомый
+    // стоял бы от своей, поэтому поиск заканчивается на первом более
+    // близком элементе.
+    for (uint32_t distance = 1; slots[pos].distance >= distance;
+         distance++) {
+      if (KeyOf()(slots[pos].entry) == key)
+        return pos;
+      pos = (pos + 1) & mask;
+    }
+
+    return kNotFound;
+  }
+
+  //! Номер ячейки, означающий отсутствие ключа.
+  static constexpr size_t kNotFound = static_cast<size_t>(-1);
+
+ private:
+  //! Логарифм минимального размера массива ячеек.
+  static constexpr unsigned char kMinCapacityLog = 2;
+
+  //! Размер массива ячеек.
+  size_t Capacity() const {
+    return slots ? size_t{1} << capacityLog : 0;
+  }
+
+  /**
+   * @brief Выделить массив пустых ячеек.
+   *
+   * @param n Количество ячеек.
+   */
+  Slot* AllocateSlots(size_t n) {
+    Slot* result = SlotTraits::allocate(allocator, n);
+    for (size_t i = 0; i < n; i++)
+      new (result + i) Slot();
+    return result;
+  }
+
+  /**
+   * @brief Освободить массив ячеек.
+   *
+   * @param array Массив ячеек (может быть nullptr).
+   * @param n Количество ячеек.
+   */
+  void FreeSlots(Slot* array, size_t n) {
+    if (!array)
+      return;
+    for (size_t i = 0; i < n; i++)
+      array[i].~Slot();
+    SlotTraits::deallocate(allocator, array, n);
+  }
+
+  /**
+   * @brief Функция возвращает true, если n элементов помещаются
+   *        в 2^log ячеек с заполнением не больше 7/8.
+   */
+  static bool Fits(size_t n, size_t log) {
+    if (n == 0)
+      return true;
+    return log != 0 && n * 8 <= (size_t{7} << log);
+  }
+
+  /**
+   * @brief Функция возвращает ячейку, в которой должен стоять ключ.
+   *
+   * @param key Ключ.
+   */
+  size_t Home(const Key& key) const {
+    const uint64_t hash = static_cast<uint64_t>(Hash()(key));
+    return static_cast<size_t>((hash * 0x9E3779B97F4A7C15ULL) >>
+                               (64 - capacityLog));
+  }
+
+  /**
+   * @brief Поставить элемент в таблицу.
+   *
+   * @param slot Ячейка с элементом (distance равно 1).
+   * @param pos Ячейка, в которой должен стоять элемент.
+   * @return Функция возвращает номер ячейки, в которую попал элемент.
+   */
+  size_t Place(Slot slot, size_t pos) {
+    const size_t mask = Capacity() - 1;
+    size_t result = kNotFound;
+
+    while (slots[pos].distance != 0) {
+      // Элемент, стоящий ближе к своей ячейке, уступает место.
+      if (slots[pos].distance < slot.distance) {
+        std::swap(slot, slots[pos]);
+        if (result == kNotFound)
+          result = pos;
+      }
+      pos = (pos + 1) & mask;
+      slot.distance++;
+    }
+
+    slots[pos] = std::move(slot);
+    return result == kNotFound ? pos : result;
+  }
+
+  /**
+   * @brief Перестроить таблицу с новым размером массива ячеек.
+   *
+   * @param log Логарифм нового размера.
+   */
+  void Rehash(size_t log) {
+    Slot* old = slots;
+    const size_t oldCapacity = Capacity();
+
+    slots = AllocateSlots(size_t{1} << log);
+    capacityLog = static_cast<unsigned char>(log);
+
+    for (size_t i = 0; i < oldCapacity; i++) {
+      if (old[i].distance == 0)
+        continue;
+      const size_t home = Home(KeyOf()(old[i].entry));
+      old[i].distance = 1;
+      Place(std::move(old[i]), home);
+    }
+
+    FreeSlots(old, oldCapacity);
+  }
+
+  //! Массив ячеек (nullptr для пустой таблицы).
+  Slot* slots;
+  //! Количество элементов.
+  size_t numEntries;
+  //! Логарифм размера массива ячеек.
+  unsigned char capacityLog;
+  //! Аллокатор ячеек.
+  SlotAllocator allocator;
+};
+
+/**
+ * @brief Ключ элемента множества.
+ */
+struct FlatSetKey {
+  template<typename Key>
+  const Key& operator()(const Key& key) const {
+    return key;
+  }
+};
+
+/**
+ * @brief Ключ элемента словаря.
+ */
+struct FlatMapKey {
+  template<typename Pair>
+  const typename Pair::first_type& operator()(const Pair& entry) const {
+    return entry.first;
+  }
+};
+
+/**
+ * @brief Множество на основе хеш-таблицы с открытой адресацией.
+ *
+ * @tparam Key Тип ключа.
+ * @tparam Hash Хеш-функция.
+ * @tparam Allocator Аллокатор.
+ *
+ * Интерфейс повторяет основные функции std::unordered_set.
+ */
+template<typename Key, typename Hash = std::hash<Key>,
+         typename Allocator = std::allocator<Key>>
+class FlatHashSet :
+    public FlatHashTable<Key, Key, FlatSetKey, Hash, Allocator> {
+ private:
+  //! Базовый класс.
+  using Base = FlatHashTable<Key, Key, FlatSetKey, Hash, Allocator>;
+
+ public:
+  using Base::Base;
+
+  //! Элементы множества менять нельзя.
+  using iterator = typename Base::const_iterator;
+
+  /**
+   * @brief Функция возвращает итератор на первый элемент.
+   */
+  iterator begin() const {
+    return Base::begin();
+  }
+
+  /**
+   * @brief Функция возвращает итератор на элемент "после последнего".
+   */
+  iterator end() const {
+    return Base::end();
+  }
+
+  /**
+   * @brief Найти ключ.
+   *
+   * @param key Ключ.
+   */
+  iterator find(const Key& key) const {
+    return Base::find(key);
+  }
+
+  /**
+   * @brief Добавить ключ.
+   *
+   * @param key Ключ.
+   * @return Функция возвращает итератор на ключ и true, если ключа
+   * в множестве не было.
+   */
+  std::pair<iterator, bool> insert(const Key& key) {
+    auto [pos, inserted] = Base::Insert(key, [&] { return key; });
+    return {Base::IteratorAt(pos), inserted};
+  }
+};
+
+/**
+ * @brief Словарь на основе хеш-таблицы с открытой адресацией.
+ *
+ * @tparam Key Тип ключа.
+ * @tparam Value Тип значения.
+ * @tparam Hash Хеш-функция.
+ * @tparam Allocator Аллокатор.
+ *
+ * Интерфейс повторяет основные функции std::unordered_map. Элементы
+ * хранятся как std::pair<Key, Value>; ключ элемента менять нельзя.
+ * Если значение само использует аллокатор (например, множество соседей
+ * вершины), то operator[] создаёт его с аллокатором словаря.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>,
+         typename Allocator = std::allocator<std::pair<Key, Value>>>
+class FlatHashMap :
+    public FlatHashTable<Key, std::pair<Key, Value>, FlatMapKey, Hash,
+                         Allocator> {
+ private:
+  //! Базовый класс.
+  using Base = FlatHashTable<Key, std::pair<Key, Value>, FlatMapKey, Hash,
+                             Allocator>;
+
+ public:
+  using Base::Base;
+
+  //! Тип значения.
+  using mapped_type = Value;
+
+  /**
+   * @brief Получить значение по ключу, добавив его, если ключа нет.
+   *
+   * @param key Ключ.
+   */
+  Value& operator[](const Key& key) {
+    const size_t pos = Base::Insert(key, [&] {
+      return std::pair<Key, Value>(key, MakeValue());
+    }).first;
+    return Base::At(pos).second;
+  }
+
+  /**
+   * @brief Получить значение по ключу.
+   *
+   * @param key Ключ.
+   *
+   * Если ключа нет, то функция выбрасывает исключение std::out_of_range.
+   */
+  Value& at(const Key& key) {
+    const size_t pos = Base::Find(key);
+    if (pos == Base::kNotFound)
+      throw std::out_of_range("FlatHashMap::at");
+    return Base::At(pos).second;
+  }
+
+  /**
+   * @brief Получить значение по ключу.
+   *
+   * @param key Ключ.
+   *
+   * Если ключа нет, то функция выбрасывает исключение std::out_of_range.
+   */
+  const Value& at(const Key& key) const {
+    return const_cast<FlatHashMap*>(this)->at(key);
+  }
+
+  /**
+   * @brief Добавить значение, если ключа ещё нет в словаре.
+   *
+   * @param key Ключ.
+   * @param value Значение.
+   * @return Функция возвращает итератор на элемент с этим ключом и true,
+   * если элемент был добавлен.
+   */
+  std::pair<typename Base::iterator, bool> emplace(const Key& key,
+                                                  Value value) {
+    auto [pos, inserted] = Base::Insert(key, [&] {
+      return std::pair<Key, Value>(key, std::move(value));
+    });
+    return {Base::IteratorAt(pos), inserted};
+  }
+
+ private:
+  /**
+   * @brief Создать значение по умолчанию.
+   *
+   * Значение, использующее аллокатор, получает аллокатор словаря.
+   */
+  Value MakeValue() const {
+    if constexpr (std::uses_allocator<Value, Allocator>::value)
+      return Value(typename Value::allocator_type(Base::get_allocator()));
+    else
+      return Value();
+  }
+};
+
+/**
+ * @brief Политика контейнеров на основе std::unordered_map
+ *        и std::unordered_set.
+ *
+ * Каждый элемент хранится в отдельном узле, зато ссылки на элементы
+ * не меняются при вставке.
+ */
+struct StdHashContainers {
+  //! Множество.
+  template<typename Key>
+  using Set = std::unordered_set<Key>;
+
+  //! Словарь.
+  template<typename Key, typename Value>
+  using Map = std::unordered_map<Key, Value>;
+};
+
+/**
+ * @brief Политика контейнеров на основе хеш-таблиц с открытой адресацией.
+ *
+ * Списки смежности лежат в непрерывных массивах, поэтому граф занимает
+ * в несколько раз меньше памяти, чем с StdHashContainers, а HasEdge()
+ * и обход соседей реже промахиваются мимо кэша.
+ */
+struct FlatHashContainers {
+  //! Множество.
+  template<typename Key>
+  using Set = FlatHashSet<Key>;
+
+  //! Словарь.
+  template<typename Key, typename Value>
+  using Map = FlatHashMap<Key, Value>;
+};
+
+}  // namespace graph
+
+#endif  // INCLUDE_FLAT_HASH_HPP_
@@ -0,0 +1,178 @@
+/**
+ * @file flow_network.hpp
+ *
+ * Остаточная сеть для алгоритмов поиска максимального потока.
+ */
+
+#ifndef INCLUDE_FLOW_NETWORK_HPP_
+#define INCLUDE_FLOW_NETWORK_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+#include "weighted_oriented_graph.hpp"
+#include "vertex_index.hpp"
+
+namespace graph {
+
+/**
+ * @brief Остаточная сеть, хранящаяся в плоских массивах.
+ *
+ * @tparam Weight Тип пропускной способности рёбер.
+ *
+ * Каждое ребро (u, v) исходного графа превращается в пару дуг с номерами
+ * 2k и 2k + 1: прямую дугу u -> v с пропускной способностью ребра
+ * и обратную дугу v -> u с нулевой пропускной способностью. Обратная дуга
+ * для дуги e имеет номер e ^ 1, поэтому при проталкивании потока не нужен
+ * ни поиск по хеш-таблице, ни обработка исключений. Дуги каждой вершины
+ * перечислены в массиве adjacency (в формате CSR), а вершины пронумерованы
+ * плотными индексами (см. VertexIndex).
+ */
+template<typename Weight>
+class FlowNetwork {
+ public:
+  /**
+   * @brief Построить остаточную сеть для графа.
+   *
+   * @param graph Исходный граф. Веса рёбер задают пропускные способности.
+   */
+  explicit FlowNetwork(const WeightedOrientedGraph<Weight>& graph) :
+    index(graph) {
+    const size_t n = index.Size();
+
+    for (size_t v = 0; v < n; v++) {
+      for (const auto& [to, capacity] : graph.WeightedEdges(index.Id(v))) {
+        head.push_back(index.Index(to));
+        residual.push_back(capacity);
+        head.push_back(v);
+        residual.push_back(Weight());
+      }
+    }
+
+    // Раскладываем дуги по вершинам (сортировка подсчётом).
+    offsets.assign(n + 1, 0);
+    for (size_t e = 0; e < head.size(); e++)
+      offsets[Tail(e) + 1]++;
+    for (size_t v = 0; v < n; v++)
+      offsets[v + 1] += offsets[v];
+
+    adjacency.resize(head.size());
+    std::vector<size_t> position(offsets.begin(), offsets.end() - 1);
+    for (size_t e = 0; e < head.size(); e++)
+      adjacency[position[Tail(e)]++] = e;
+  }
+
+  //! Отображение номеров вершин в плотные индексы.
+  const VertexIndex& Index() const {
+    return index;
+  }
+
+  //! Количество вершин.
+  size_t NumVertices() const {
+    return index.Size();
+  }
+
+  //! Количество дуг (вдвое больше количества рёбер).
+  size_t NumArcs() const {
+    return head.size();
+  }
+
+  //! Начало списка дуг вершины v в массиве Adjacency().
+  size_t Begin(size_t v) const {
+    return offsets[v];
+  }
+
+  //! Конец списка дуг вершины v в массиве Adjacency().
+  size_t End(size_t v) const {
+    return offsets[v + 1];
+  }
+
+  //! Номера дуг, сгруппированные по вершинам.
+  const std::vector<size_t>& Adjacency() const {
+    return adjacency;
+  }
+
+  //! Вершина, в которую входит дуга e.
+  size_t Head(size_t e) const {
+    return head[e];
+  }
+
+  //! Вершина, из которой выходит дуга e.
+  size_t Tail(size_t e) const {
+    return head[e ^ 1];
+  }
+
+  //! Остаточная пропускная способность дуги e.
+  const Weight& Residual(size_t e) const {
+    return residual[e];
+  }
+
+  /**
+   * @brief Протолкнуть поток по дуге.
+   *
+   * @param e Номер дуги.
+   * @param delta Величина потока.
+   */
+  void Push(size_t e, Weight delta) {
+    residual[e] -= delta;
+    residual[e ^ 1] += delta;
+  }
+
+  /**
+   * @brief Записать поток в граф-результат.
+   *
+   * @param result Граф-результат.
+   *
+   * В результат попадают все вершины и рёбра исходного графа, вес ребра
+   * равен потоку по нему. Если по двум встречным рёбрам u -> v и v -> u
+   * идёт положительный поток, то меньший из них вычитается из обоих:
+   * величина потока при этом не меняется. Граф-результат сохраняет свой
+   * аллокатор.
+   */
+  void ExtractFlow(WeightedOrientedGraph<Weight>* result) const {
+    *result = WeightedOrientedGraph<Weight>(
+        result->get_allocator());
+
+    for (size_t id : index.Ids())
+      result->AddVertex(id);
+
+    for (size_t e = 0; e < head.size(); e += 2)
+      result->AddEdge(index.Id(Tail(e)), index.Id(head[e]), residual[e + 1]);
+
+    for (size_t e = 0; e < head.size(); e += 2) {
+      const size_t u = index.Id(Tail(e)), v = index.Id(head[e]);
+
+      if (u >= v || !result->HasEdge(v, u))
+        continue;
+
+      Weight& forward = result->EdgeWeight(u, v);
+      Weight& backward = result->EdgeWeight(v, u);
+      const Weight common = std::min(forward, backward);
+
+      if (common > Weight()) {
+        forward -= common;
+        backward -= common;
+      }
+    }
+  }
+
+ private:
+  //! Отображение номеров вершин в плотные индексы.
+  VertexIndex index;
+
+  //! Вершина, в которую входит дуга.
+  std::vector<size_t> head;
+
+  //! Остаточная пропускная способность дуги.
+  std::vector<Weight> residual;
+
+  //! Начала списков дуг вершин в массиве adjacency.
+  std::vector<size_t> offsets;
+
+  //! Номера дуг, сгруппированные по вершинам.
+  std::vector<size_t> adjacency;
+};
+
+}  // namespace graph
+
+#endif  // INCLUDE_FLOW_NETWORK_HPP_
@@ -8,26 +8,70 @@
 #ifndef INCLUDE_GRAPH_HPP_
 #define INCLUDE_GRAPH_HPP_
 
-#include <unordered_map>
-#include <unordered_set>
 #include <vector>
 #include <utility>
+#include <small_flat_set.hpp>
+#include <edge_groups.hpp>
 #include <iterators.hpp>
 
 namespace graph {
 
 /**
  * @brief Простой неориентированный граф.
+ *
+ * @tparam Containers Политика контейнеров для списков смежности
+ * (SmallFlatContainers, FlatHashContainers или StdHashContainers).
  */
-class Graph {
+template<typename Containers = SmallFlatContainers<>>
+class BasicGraph {
  public:
+  //! Множество соседей вершины.
+  using NeighboursSet = typename Containers::template Set<size_t>;
+
+  //! Словарь смежности: номер вершины -> множество соседей.
+  using AdjacencyMap = typename Containers::template Map<size_t,
+                                                         NeighboursSet>;
+
+  //! Промежуток вершин графа.
+  using VerticesRange = graph::VerticesRange<AdjacencyMap>;
+
+  //! Тип аллокатора, из памяти которого берутся вершины и рёбра.
+  using allocator_type = typename AdjacencyMap::allocator_type;
+
   /**
-   * @brief Конструктор класса Graph.
+   * @brief Конструктор класса BasicGraph.
    */
-  Graph() :
+  BasicGraph() :
     edges() {
   }
 
+  /**
+   * @brief Конструктор графа, хранящего вершины и рёбра в памяти
+   *        аллокатора.
+   *
+   * @param alloc Аллокатор (например, std::pmr::polymorphic_allocator
+   *        над ареной запроса).
+   */
+  explicit BasicGraph(const allocator_type& alloc) :
+    edges(alloc) {
+  }
+
+  /**
+   * @brief Конструктор графа по промежутку рёбер.
+   *
+   * @param first Начало промежутка рёбер (пар [откуда, куда]).
+   * @param last Конец промежутка рёбер.
+   * @param alloc Аллокатор.
+   *
+   * Граф заполняется функцией AddEdges().
+   */
+  template<typename Iterator>
+  BasicGraph(Iterator first, Iterator last,
+             const allocator_type& alloc = allocator_type()) :
+    edges(alloc) {
+    AddEdges(first, last);
+  }
+
   /**
    * @brief Добавить вершину в граф.
    *
@@ -54,6 +98,52 @@ class Graph {
     edges[id2].insert(id1);
   }
 
+  /**
+   * @brief Зарезервировать место под вершины.
+   *
+   * @param numVertices Ожидаемое количество вершин.
+   * @param numEdges Ожидаемое количество рёбер; пока не используется
+   *        (соседи резервируются в AddEdges()).
+   */
+  void Reserve(size_t numVertices, [[maybe_unused]] size_t numEdges) {
+    edges.reserve(numVertices);
+  }
+
+  /**
+   * @brief Добавить в граф промежуток рёбер.
+   *
+   * @param first Начало промежутка рёбер.
+   * @param last Конец промежутка рёбер.
+   *
+   * Элементы промежутка - пары [id1, id2] (например,
+   * std::pair<size_t, size_t>). Результат тот же, что у вызовов AddEdge()
+   * для каждого ребра по порядку, но рёбра сначала группируются по
+   * вершинам, и соседи каждой вершины резервируются и добавляются за один
+   * проход.
+   */
+  template<typename Iterator>
+  void AddEdges(Iterator first, Iterator last) {
+    using Arc = std::pair<size_t, size_t>;
+    ArcVector<Arc, allocator_type> arcs(get_allocator());
+
+    ReserveArcs(&arcs, first, last, 2);
+    for (; first != last; ++first) {
+      const auto& [id1, id2] = *first;
+      arcs.emplace_back(id1, id2);
+      if (id1 != id2)
+        arcs.emplace_back(id2, id1);
+    }
+
+    SortArcsBySource(&arcs);
+    AddArcSources(&edges, arcs);
+    ForEachArcGroup(arcs, [this](size_t source, auto begin, auto end) {
+      NeighboursSet& neighbours = edges[source];
+      neighbours.reserve(neighbours.size() + (end - begin));
+      for (auto it = begin; it != end; ++it)
+        neighbours.insert(it->second);
+    });
+  }
+
   /**
    * @brief Функция проверяет, есть ли вершина в графе.
    *
@@ -81,7 +171,7 @@ class Graph {
     if (it == edges.end())
       return false;
 
-    return it->second.find(id2) != it->second.end();
+    return it->second.count(id2) != 0;
   }
 
   /**
@@ -134,7 +224,7 @@ class Graph {
    * присутствует в графе. Если указанной вершини в графе нет, то функция
    * выбрасывает исключение std::out_of_range.
    */
-  const std::unordered_set<size_t>& Edges(size_t id) const {
+  const NeighboursSet& Edges(size_t id) const {
     return edges.at(id);
   }
 
@@ -148,7 +238,7 @@ class Graph {
    * присутствует в графе. Если указанной вершини в графе нет, то функция
    * выбрасывает исключение std::out_of_range.
    */
-  const std::unordered_set<size_t>& IncomingEdges(size_t id) const {
+  const NeighboursSet& IncomingEdges(size_t id) const {
     return edges.at(id);
   }
 
@@ -169,6 +259,13 @@ class Graph {
     return edges.size();
   }
 
+  /**
+   * @brief Функция возвращает аллокатор графа.
+   */
+  allocator_type get_allocator() const {
+    return edges.get_allocator();
+  }
+
  private:
   /**
    * @brief Вспомогательная функция для получения идентификатора ребра.
@@ -186,9 +283,12 @@ class Graph {
   }
 
   //! Разреженная матрица связности.
-  std::unordered_map<size_t, std::unordered_set<size_t>> edges;
+  AdjacencyMap edges;
 };
 
+//! Простой неориентированный граф с политикой контейнеров по умолчанию.
+using Graph = BasicGraph<>;
+
 }  // namespace graph
 
 #endif  // INCLUDE_GRAPH_HPP_
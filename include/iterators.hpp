@@ -9,22 +9,35 @@
 #define INCLUDE_ITERATORS_HPP_
 
 #include <cstddef>
-#include <unordered_set>
-#include <unordered_map>
+#include <iterator>
 
 namespace graph {
 
 /**
- * @brief Класс позволяет проитерироваться по всем вершинам в графе.
+ * @brief Класс позволяет проитерироваться по ключам словаря смежности графа.
+ *
+ * @tparam InternalIterator Тип итератора словаря.
  *
  * Этот класс является простой оболочкой над итератором словаря
- * в матрице смежности графа.
+ * в матрице смежности графа, которая возвращает только ключи словаря:
+ * номера вершин графа или номера соседей вершины во взвешенном графе.
  */
-class VertexIterator {
+template<typename InternalIterator>
+class KeyIterator {
  public:
   //! Внутренний тип итератора.
-  using InternalIteratorType =
-      std::unordered_map<size_t, std::unordered_set<size_t>>::const_iterator;
+  using InternalIteratorType = InternalIterator;
+
+  //! Категория итератора.
+  using iterator_category = std::forward_iterator_tag;
+  //! Тип значения итератора.
+  using value_type = size_t;
+  //! Тип разности итераторов.
+  using difference_type = std::ptrdiff_t;
+  //! Тип указателя.
+  using pointer = const size_t*;
+  //! Тип ссылки.
+  using reference = size_t;
 
  private:
   //! Текущая позиция.
@@ -35,7 +48,7 @@ class VertexIterator {
    * @brief Функция создаёт итератор из текущей позиции.
    * @param pos Текущая позиция.
    */
-  explicit VertexIterator(InternalIteratorType pos) :
+  explicit KeyIterator(InternalIteratorType pos) :
     pos(pos) {
   }
 
@@ -43,7 +56,7 @@ class VertexIterator {
    * @brief Оператор сравнения == для итератора.
    * @param other Другой итератор.
    */
-  bool operator==(const VertexIterator& other) const {
+  bool operator==(const KeyIterator& other) const {
     return pos == other.pos;
   }
 
@@ -51,14 +64,14 @@ class VertexIterator {
    * @brief Оператор сравнения == для итератора.
    * @param other Другой итератор.
    */
-  bool operator!=(const VertexIterator& other) const {
+  bool operator!=(const KeyIterator& other) const {
     return pos != other.pos;
   }
 
   /**
    * @brief Префиксная операция инкремента для итератора.
    */
-  VertexIterator& operator++() {
+  KeyIterator& operator++() {
     pos++;
     return *this;
   }
@@ -66,8 +79,8 @@ class VertexIterator {
   /**
    * @brief Постфиксная операция инкремента для итератора.
    */
-  VertexIterator operator++(int) {
-    VertexIterator retval(*this);
+  KeyIterator operator++(int) {
+    KeyIterator retval(*this);
     pos++;
     return retval;
   }
@@ -84,25 +97,29 @@ class VertexIterator {
 /**
  * @brief Класс-адаптер, предназначенный для использования в циклах
  *        range-based for.
+ *
+ * @tparam InternalIterator Тип итератора словаря матрицы смежности.
  */
-class VerticesRange {
+template<typename InternalIterator>
+class BasicVerticesRange {
+ public:
+  //! Внутренний тип итератора.
+  using InternalIteratorType = InternalIterator;
+
  private:
   //! Итератор на первую вершину.
-  VertexIterator beginIt;
+  KeyIterator<InternalIterator> beginIt;
   //! Итератор на вершину "после последней".
-  VertexIterator endIt;
+  KeyIterator<InternalIterator> endIt;
 
  public:
-  //! Внутренний тип итератора.
-  using InternalIteratorType =
-      std::unordered_map<size_t, std::unordered_set<size_t>>::const_iterator;
-
   /**
     * @brief Конструктор класса.
     * @param beginIt Итератор на начало в словаре матрицы смежности.
     * @param endIt Итератор на конец в словаре матрицы смежности.
     */
-  VerticesRange(InternalIteratorType beginIt, InternalIteratorType endIt) :
+  BasicVerticesRange(InternalIteratorType beginIt,
+                     InternalIteratorType endIt) :
     beginIt(beginIt),
     endIt(endIt) {
   }
@@ -110,18 +127,88 @@ class VerticesRange {
   /**
    * @brief Возвращает итератор на первую вершину.
    */
-  VertexIterator begin() const {
+  KeyIterator<InternalIterator> begin() const {
     return beginIt;
   }
 
   /**
    * @brief Возвращает итератор на вершину "после последней".
    */
-  VertexIterator end() const {
+  KeyIterator<InternalIterator> end() const {
     return endIt;
   }
 };
 
+/**
+ * @brief Итератор по вершинам графа.
+ *
+ * @tparam Map Тип словаря смежности графа (номер вершины -> соседи).
+ */
+template<typename Map>
+using VertexIterator = KeyIterator<typename Map::const_iterator>;
+
+/**
+ * @brief Промежуток вершин графа.
+ *
+ * @tparam Map Тип словаря смежности графа (номер вершины -> соседи).
+ */
+template<typename Map>
+using VerticesRange = BasicVerticesRange<typename Map::const_iterator>;
+
+/**
+ * @brief Класс-адаптер для итерирования по соседям вершины во взвешенном
+ *        графе при помощи циклов range-based for.
+ *
+ * @tparam Map Тип словаря соседей (номер соседа -> вес ребра).
+ */
+template<typename Map>
+class NeighboursRange {
+ public:
+  //! Тип итератора по соседям.
+  using Iterator = KeyIterator<typename Map::const_iterator>;
+
+ private:
+  //! Словарь соседей.
+  const Map* neighbours;
+
+ public:
+  /**
+    * @brief Конструктор класса.
+    * @param neighbours Словарь соседей вершины.
+    */
+  explicit NeighboursRange(const Map& neighbours) :
+    neighbours(&neighbours) {
+  }
+
+  /**
+   * @brief Возвращает итератор на первого соседа.
+   */
+  Iterator begin() const {
+    return Iterator(neighbours->begin());
+  }
+
+  /**
+   * @brief Возвращает итератор на соседа "после последнего".
+   */
+  Iterator end() const {
+    return Iterator(neighbours->end());
+  }
+
+  /**
+   * @brief Функция возвращает количество соседей.
+   */
+  size_t size() const {
+    return neighbours->size();
+  }
+
+  /**
+   * @brief Функция возвращает true, если соседей нет.
+   */
+  bool empty() const {
+    return neighbours->empty();
+  }
+};
+
 }  // namespace graph
 
 #endif  // INCLUDE_ITERATORS_HPP_
@@ -5,11 +5,11 @@
 #include <iostream>
 #include <algorithm>
 #include <utility>
-#include <unordered_map>
-#include <unordered_set>
 #include "iterators.hpp"
 #include "graph.hpp"
 #include "weighted_graph.hpp"
+#include "vertex_index.hpp"
+#include "disjoint_set.hpp"
 
 namespace graph {
 
@@ -34,9 +34,9 @@ Graph Maximal(const WeightedGraph<T>& wGraph) {
 
   // заполнение вектора для сортировки
   for (size_t v : wGraph.Vertices()) {
-    for (size_t neighbour : wGraph.Edges(v)) {
+    for (const auto& [neighbour, weight] : wGraph.WeightedEdges(v)) {
       if (neighbour > v)
-        g.push_back({ wGraph.EdgeWeight(v, neighbour), {v, neighbour}});
+        g.push_back({ weight, {v, neighbour}});
     }
   }
   // структура граф не подойдет т.к. алгоритм работает
@@ -46,31 +46,23 @@ Graph Maximal(const WeightedGraph<T>& wGraph) {
   T cost = 0;
   Graph res;
 
-  size_t n = 1;
-  for (size_t v : wGraph.Vertices()) {
-    if (v > n)
-      n = v;
-  }
-  std::unordered_map<size_t, size_t> treeId;
-  for (size_t i = 0; i <= n; ++i)
-    if (wGraph.HasVertex(i))
-      treeId[i] = i;
-  // для каждой вершины хранит номер дерева, которому она принадлежит
+  // деревья хранятся в системе непересекающихся множеств
+  // (вершины пронумерованы плотными индексами)
+  const VertexIndex index(wGraph);
+  const size_t n = index.Size();
+  DisjointSet trees(n);
+  size_t accepted = 0;
 
-  for (size_t i = 0; i < g.size(); ++i) {
+  // остов содержит не более n - 1 рёбер
+  for (size_t i = 0; i < g.size() && accepted + 1 < n; ++i) {
     size_t a = g[i].second.first,  b = g[i].second.second;
     T l = g[i].first;
 
-    // определяем, принадлежат ли его концы разным деревьям
-    if (treeId[a] != treeId[b]) {
+    // если концы ребра принадлежат разным деревьям, то объединяем их
+    if (trees.Union(index.Index(a), index.Index(b))) {
       cost += l;
       res.AddEdge(a, b);
-      size_t oldId = treeId[b],  newId = treeId[a];
-
-      // объединение двух деревьев
-      for (size_t j = 0; j <= n; ++j)
-        if ((treeId[j] == oldId) && (wGraph.HasVertex(j)))
-          treeId[j] = newId;
+      accepted++;
     }
   }
   /* for (size_t v : res.Vertices()) {
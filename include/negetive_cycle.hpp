@@ -6,86 +6,294 @@
 **/
 #ifndef INCLUDE_NEGETIVE_CYCLE_HPP_
 #define INCLUDE_NEGETIVE_CYCLE_HPP_
-#include <iostream>
-#include <unordered_map>
 #include <vector>
 #include <algorithm>
 #include <cstddef>
 #include "iterators.hpp"
 #include "weighted_oriented_graph.hpp"
+#include "csr_graph.hpp"
+#include "vertex_index.hpp"
 
 namespace graph {
 /**
- * @brief Алгоритм поиска отрицательного цикла в графе.
+ * @brief Найти цикл в графе предков.
+ *
+ * @param parent Предки вершин (VertexIndex::npos, если предка нет).
+ * @param start Индекс вершины, с которой начинается поиск.
+ * @param cycle Найденный цикл в виде замкнутого пути v1, ..., vk, v1
+ *        (в порядке рёбер исходного графа).
+ *
+ * Функция идёт от вершины start по предкам. Если путь зациклился, то
+ * функция записывает цикл и возвращает true.
+**/
+inline bool ParentCycle(const std::vector<size_t>& parent, size_t start,
+                        std::vector<size_t>* cycle) {
+    std::vector<size_t> path;
+    std::vector<size_t> position(parent.size(), VertexIndex::npos);
+    size_t v = start;
+
+    while (v != VertexIndex::npos && position[v] == VertexIndex::npos) {
+        position[v] = path.size();
+        path.push_back(v);
+        v = parent[v];
+    }
+
+    if (v == VertexIndex::npos)
+        return false;
+
+    // Путь идёт против рёбер, поэтому цикл выписывается в обратном порядке.
+    cycle->clear();
+    for (size_t i = path.size(); i > position[v]; i--)
+        cycle->push_back(path[i - 1]);
+    cycle->push_back(cycle->front());
+
+    return true;
+}
+
+/**
+ * @brief Поиск антицикла алгоритмом Форда-Беллмана.
  *
- * @tparam T Тип графа.
  * @tparam Weight Тип веса ребер графа.
  *
- * @param path Искомый путь (антицикл).
- * @param v Вершина, в которой мы находимся.
- * @param p предок.
+ * @param graph Граф в формате CSR.
+ * @param cycle Найденный антицикл (индексы вершин, см. ParentCycle()).
  *
+ * Все вершины считаются достижимыми из фиктивного истока по рёбрам
+ * нулевого веса. Фазы релаксации прекращаются, как только очередная фаза
+ * ничего не изменила: в этом случае антицикла нет. Если изменения есть
+ * и на N-й фазе, то, пройдя N раз по предкам от последней изменённой
+ * вершины, попадаем на антицикл. Функция возвращает true, если антицикл
+ * найден.
 **/
-template<class T>
-void NegCycle(size_t size, const T& graph, std::vector<size_t>* path) {
-    // заводим массив расстояний от вершины v до других вершин
-    std::unordered_map<size_t, typename T::WeightType> d;
-    // для каждой вершины антицикла будем хранить его предка
-    std::unordered_map<size_t, size_t> p;
-    // индикатор отсутствия антицикла
-    // (нумерация вершин начинается как мининимум с 1)
-    size_t x = 0, j = 0;
-    /* Запускаем алгоритм Форда-Беллмана */
-    for (size_t i = 0; i < size; i++) {
-        x = 0;
-        for (size_t elem : graph.Vertices()) {
-            size_t v = elem;
-            if (j == 0) {
-                d[v] = 0;
-            }
-            for (auto neighbourId : graph.Edges(v)) {
-                size_t to = neighbourId;
-                auto it1 = d.find(to);
-                std::unordered_map<size_t, size_t>::iterator it;
-                if (it1 == d.end()) {
-                    d[to] = d[v] + graph.EdgeWeight(v, to);
-                    it = p.find(to);
-                    if (it == p.end()) {
-                        p.insert({to, v});
-                    } else {
-                        p[to] = v;
-                    }
-                } else {
-                    if (d[to] > d[v] + graph.EdgeWeight(v, to)) {
-                        d[to] = d[v] + graph.EdgeWeight(v, to);
-                        it = p.find(to);
-                        if (it == p.end()) {
-                            p.insert({to, v});
-                        } else {
-                            p[to] = v;
-                        }
-                        x = to;
-                    }
+template<typename Weight>
+bool NegCycleBellmanFord(const CsrGraph<Weight>& graph,
+                         std::vector<size_t>* cycle) {
+    const size_t n = graph.NumVertices();
+    const std::vector<size_t>& offsets = graph.Offsets();
+    const std::vector<size_t>& neighbours = graph.Neighbours();
+    const std::vector<Weight>& weights = graph.Weights();
+
+    std::vector<Weight> d(n, Weight());
+    std::vector<size_t> p(n, VertexIndex::npos);
+    // индекс вершины, расстояние до которой уменьшилось на последней фазе
+    size_t x = VertexIndex::npos;
+
+    for (size_t phase = 0; phase < n; phase++) {
+        x = VertexIndex::npos;
+        for (size_t v = 0; v < n; v++) {
+            for (size_t k = offsets[v]; k < offsets[v + 1]; k++) {
+                const size_t to = neighbours[k];
+                const Weight candidate = d[v] + weights[k];
+                if (candidate < d[to]) {
+                    d[to] = candidate;
+                    p[to] = v;
+                    x = to;
                 }
             }
-            j++;
         }
+        if (x == VertexIndex::npos)
+            return false;
     }
-    if (x == 0) {
-        (*path) = std::vector<size_t>();
-    } else {
-        size_t y = x;
-        for (size_t i = 0; i < p.size(); ++i) {
-            y = p[y];
+
+    for (size_t i = 0; i < n && x != VertexIndex::npos; ++i)
+        x = p[x];
+
+    return ParentCycle(p, x, cycle);
+}
+
+/**
+ * @brief Поиск антицикла алгоритмом Форда-Беллмана с очередью (SPFA).
+ *
+ * @tparam Weight Тип веса ребер графа.
+ *
+ * @param graph Граф в формате CSR.
+ * @param cycle Найденный антицикл (индексы вершин, см. ParentCycle()).
+ *
+ * Вначале в очереди все вершины. Очередь обрабатывается так же, как фазы
+ * алгоритма Форда-Беллмана, и за одну фазу каждая вершина попадает
+ * в очередь не более одного раза, поэтому без антициклов вершина
+ * добавляется в очередь не более N раз. Если счётчик добавлений вершины
+ * превысил N, то антицикл есть, и после каждого уменьшения расстояния
+ * до этой вершины проверяется, не замкнулся ли через неё цикл в графе
+ * предков (цикл в графе предков всегда имеет отрицательный вес). Функция
+ * возвращает true, если антицикл найден.
+**/
+template<typename Weight>
+bool NegCycleSpfa(const CsrGraph<Weight>& graph, std::vector<size_t>* cycle) {
+    const size_t n = graph.NumVertices();
+    const std::vector<size_t>& offsets = graph.Offsets();
+    const std::vector<size_t>& neighbours = graph.Neighbours();
+    const std::vector<Weight>& weights = graph.Weights();
+
+    std::vector<Weight> d(n, Weight());
+    std::vector<size_t> p(n, VertexIndex::npos);
+    std::vector<size_t> count(n, 1);
+    std::vector<bool> queued(n, true);
+    // циклическая очередь: каждая вершина находится в ней не более раза
+    std::vector<size_t> queue(n);
+    size_t head = 0, size = n;
+
+    for (size_t v = 0; v < n; v++)
+        queue[v] = v;
+
+    while (size > 0) {
+        const size_t v = queue[head];
+        head = (head + 1) % n;
+        size--;
+        queued[v] = false;
+
+        for (size_t k = offsets[v]; k < offsets[v + 1]; k++) {
+            const size_t to = neighbours[k];
+            const Weight candidate = d[v] + weights[k];
+            if (!(candidate < d[to]))
+                continue;
+
+            d[to] = candidate;
+            p[to] = v;
+
+            if (count[to] > n && ParentCycle(p, to, cycle))
+                return true;
+
+            if (!queued[to]) {
+                count[to]++;
+                queue[(head + size) % n] = to;
+                queued[to] = true;
+                size++;
+            }
         }
-        for (size_t tmp = y; ; tmp = p[tmp]) {
-            (*path).push_back(tmp);
-            if (tmp == y && (*path).size() > 1) {
-                break;
+    }
+
+    return false;
+}
+
+/**
+ * @brief Поиск антицикла с разборкой поддеревьев (алгоритм Тарьяна).
+ *
+ * @tparam Weight Тип веса ребер графа.
+ *
+ * @param graph Граф в формате CSR.
+ * @param cycle Найденный антицикл (индексы вершин, см. ParentCycle()).
+ *
+ * Алгоритм работает как SPFA, но дополнительно хранит дерево кратчайших
+ * путей в виде списка вершин в порядке обхода в глубину с глубинами.
+ * Когда расстояние до вершины v уменьшается по ребру (u, v), всё
+ * поддерево v удаляется из дерева: расстояния в нём устарели, и вершины
+ * поддерева не просматриваются, пока их расстояние снова не уменьшится.
+ * Если в поддереве v оказалась вершина u, то путь по дереву от v до u
+ * вместе с ребром (u, v) - антицикл, и он находится сразу же, без
+ * подсчёта фаз. Функция возвращает true, если антицикл найден.
+**/
+template<typename Weight>
+bool NegCycleTarjan(const CsrGraph<Weight>& graph,
+                    std::vector<size_t>* cycle) {
+    const size_t n = graph.NumVertices();
+    const std::vector<size_t>& offsets = graph.Offsets();
+    const std::vector<size_t>& neighbours = graph.Neighbours();
+    const std::vector<Weight>& weights = graph.Weights();
+
+    // фиктивный исток с индексом n - корень дерева
+    const size_t root = n;
+    std::vector<Weight> d(n, Weight());
+    std::vector<size_t> p(n + 1, root);
+    std::vector<size_t> depth(n + 1, 1);
+    // двусвязный список вершин дерева в порядке обхода в глубину
+    std::vector<size_t> next(n + 1), prev(n + 1);
+    std::vector<bool> inTree(n + 1, true);
+    std::vector<bool> queued(n, true);
+    std::vector<size_t> queue(n);
+    size_t head = 0, size = n;
+
+    p[root] = VertexIndex::npos;
+    depth[root] = 0;
+    for (size_t v = 0; v <= n; v++) {
+        next[v] = v == n ? 0 : v + 1;
+        prev[v] = v == 0 ? n : v - 1;
+    }
+    for (size_t v = 0; v < n; v++)
+        queue[v] = v;
+
+    while (size > 0) {
+        const size_t u = queue[head];
+        head = (head + 1) % n;
+        size--;
+        queued[u] = false;
+
+        if (!inTree[u])
+            continue;
+
+        for (size_t k = offsets[u]; k < offsets[u + 1]; k++) {
+            const size_t v = neighbours[k];
+            const Weight candidate = d[u] + weights[k];
+            if (!(candidate < d[v]))
+                continue;
+
+            if (v == u) {
+                *cycle = {u, u};
+                return true;
+            }
+
+            // Удаляем v вместе с поддеревом из списка.
+            size_t last = v;
+            if (inTree[v]) {
+                for (size_t w = next[v]; depth[w] > depth[v]; w = next[w]) {
+                    if (w == u) {
+                        std::vector<size_t> path;
+                        for (size_t x = u; x != v; x = p[x])
+                            path.push_back(x);
+                        path.push_back(v);
+                        cycle->assign(path.rbegin(), path.rend());
+                        cycle->push_back(v);
+                        return true;
+                    }
+                    inTree[w] = false;
+                    last = w;
+                }
+                next[prev[v]] = next[last];
+                prev[next[last]] = prev[v];
+            }
+
+            // Вставляем v в список сразу после u.
+            d[v] = candidate;
+            p[v] = u;
+            depth[v] = depth[u] + 1;
+            inTree[v] = true;
+            next[v] = next[u];
+            prev[next[u]] = v;
+            next[u] = v;
+            prev[v] = u;
+
+            if (!queued[v]) {
+                queue[(head + size) % n] = v;
+                queued[v] = true;
+                size++;
             }
         }
-        reverse((*path).begin(), (*path).end());
     }
+
+    return false;
+}
+
+/**
+ * @brief Алгоритм поиска отрицательного цикла в графе.
+ *
+ * @tparam T Тип графа.
+ *
+ * @param graph Граф.
+ * @param path Искомый путь (антицикл) v1, ..., vk, v1 или пустой вектор,
+ *        если антицикла нет.
+ *
+ * Используется алгоритм с разборкой поддеревьев (NegCycleTarjan()).
+ * Номера вершин могут быть любыми, в том числе нулевыми.
+**/
+template<class T>
+void NegCycle(const T& graph, std::vector<size_t>* path) {
+    const CsrGraph<typename T::WeightType> csr(graph);
+    std::vector<size_t> cycle;
+
+    path->clear();
+    if (NegCycleTarjan(csr, &cycle))
+        for (size_t v : cycle)
+            path->push_back(csr.Id(v));
 }
 }  // namespace graph
 
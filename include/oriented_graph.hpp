@@ -8,25 +8,72 @@
 #ifndef INCLUDE_ORIENTED_GRAPH_HPP_
 #define INCLUDE_ORIENTED_GRAPH_HPP_
 
-#include <unordered_map>
-#include <unordered_set>
+#include <utility>
+#include <small_flat_set.hpp>
+#include <edge_groups.hpp>
 #include <iterators.hpp>
 
 namespace graph {
 
 /**
  * @brief Простой ориентированный граф.
+ *
+ * @tparam Containers Политика контейнеров для списков смежности
+ * (SmallFlatContainers, FlatHashContainers или StdHashContainers).
  */
-class OrientedGraph {
+template<typename Containers = SmallFlatContainers<>>
+class BasicOrientedGraph {
  public:
+  //! Множество соседей вершины.
+  using NeighboursSet = typename Containers::template Set<size_t>;
+
+  //! Словарь смежности: номер вершины -> множество соседей.
+  using AdjacencyMap = typename Containers::template Map<size_t,
+                                                         NeighboursSet>;
+
+  //! Промежуток вершин графа.
+  using VerticesRange = graph::VerticesRange<AdjacencyMap>;
+
+  //! Тип аллокатора, из памяти которого берутся вершины и рёбра.
+  using allocator_type = typename AdjacencyMap::allocator_type;
+
   /**
-   * @brief Конструктор класса OrientedGraph.
+   * @brief Конструктор класса BasicOrientedGraph.
    */
-  OrientedGraph() :
+  BasicOrientedGraph() :
     edges(),
     incomingEdges() {
   }
 
+  /**
+   * @brief Конструктор графа, хранящего вершины и рёбра в памяти
+   *        аллокатора.
+   *
+   * @param alloc Аллокатор (например, std::pmr::polymorphic_allocator
+   *        над ареной запроса).
+   */
+  explicit BasicOrientedGraph(const allocator_type& alloc) :
+    edges(alloc),
+    incomingEdges(alloc) {
+  }
+
+  /**
+   * @brief Конструктор графа по промежутку рёбер.
+   *
+   * @param first Начало промежутка рёбер (пар [откуда, куда]).
+   * @param last Конец промежутка рёбер.
+   * @param alloc Аллокатор.
+   *
+   * Граф заполняется функцией AddEdges().
+   */
+  template<typename Iterator>
+  BasicOrientedGraph(Iterator first, Iterator last,
+                     const allocator_type& alloc = allocator_type()) :
+    edges(alloc),
+    incomingEdges(alloc) {
+    AddEdges(first, last);
+  }
+
   /**
    * @brief Добавить вершину в граф.
    *
@@ -48,10 +95,74 @@ class OrientedGraph {
    *
    * Функция добавляет ребро, выходящее из вершины id1 и входящее в вершину id2
    * в граф. Если такое ребро в графе уже есть, то функция ничего не делает.
+   * Если вершин id1 и id2 в графе нет, то они добавляются.
    */
   void AddEdge(size_t id1, size_t id2) {
     edges[id1].insert(id2);
+    edges[id2];
     incomingEdges[id2].insert(id1);
+    incomingEdges[id1];
+  }
+
+  /**
+   * @brief Зарезервировать место под вершины.
+   *
+   * @param numVertices Ожидаемое количество вершин.
+   * @param numEdges Ожидаемое количество рёбер; пока не используется
+   *        (соседи резервируются в AddEdges()).
+   */
+  void Reserve(size_t numVertices, [[maybe_unused]] size_t numEdges) {
+    edges.reserve(numVertices);
+    incomingEdges.reserve(numVertices);
+  }
+
+  /**
+   * @brief Добавить в граф промежуток рёбер.
+   *
+   * @param first Начало промежутка рёбер.
+   * @param last Конец промежутка рёбер.
+   *
+   * Элементы промежутка - пары [откуда, куда] (например,
+   * std::pair<size_t, size_t>). Результат тот же, что у вызовов AddEdge()
+   * для каждого ребра по порядку, но рёбра сначала группируются по
+   * вершинам, и соседи каждой вершины резервируются и добавляются за один
+   * проход.
+   */
+  template<typename Iterator>
+  void AddEdges(Iterator first, Iterator last) {
+    using Arc = std::pair<size_t, size_t>;
+    ArcVector<Arc, allocator_type> outgoing(get_allocator());
+    ArcVector<Arc, allocator_type> incoming(get_allocator());
+
+    ReserveArcs(&outgoing, first, last, 1);
+    ReserveArcs(&incoming, first, last, 1);
+    for (; first != last; ++first) {
+      const auto& [id1, id2] = *first;
+      outgoing.emplace_back(id1, id2);
+      incoming.emplace_back(id2, id1);
+    }
+
+    SortArcsBySource(&outgoing);
+    SortArcsBySource(&incoming);
+
+    // Оба конца каждого ребра становятся вершинами в обоих словарях.
+    AddArcSources(&edges, outgoing);
+    AddArcSources(&edges, incoming);
+    AddArcSources(&incomingEdges, incoming);
+    AddArcSources(&incomingEdges, outgoing);
+
+    ForEachArcGroup(outgoing, [this](size_t source, auto begin, auto end) {
+      NeighboursSet& neighbours = edges[source];
+      neighbours.reserve(neighbours.size() + (end - begin));
+      for (auto it = begin; it != end; ++it)
+        neighbours.insert(it->second);
+    });
+    ForEachArcGroup(incoming, [this](size_t target, auto begin, auto end) {
+      NeighboursSet& neighbours = incomingEdges[target];
+      neighbours.reserve(neighbours.size() + (end - begin));
+      for (auto it = begin; it != end; ++it)
+        neighbours.insert(it->second);
+    });
   }
 
   /**
@@ -81,7 +192,7 @@ class OrientedGraph {
     if (it == edges.end())
       return false;
 
-    return it->second.find(id2) != it->second.end();
+    return it->second.count(id2) != 0;
   }
 
   /**
@@ -145,7 +256,7 @@ class OrientedGraph {
    * присутствует в графе. Если указанной вершини в графе нет, то функция
    * выбрасывает исключение std::out_of_range.
    */
-  const std::unordered_set<size_t>& Edges(size_t id) const {
+  const NeighboursSet& Edges(size_t id) const {
     return edges.at(id);
   }
 
@@ -159,7 +270,7 @@ class OrientedGraph {
    * присутствует в графе. Если указанной вершини в графе нет, то функция
    * выбрасывает исключение std::out_of_range.
    */
-  const std::unordered_set<size_t>& IncomingEdges(size_t id) const {
+  const NeighboursSet& IncomingEdges(size_t id) const {
     return incomingEdges.at(id);
   }
 
@@ -180,14 +291,24 @@ class OrientedGraph {
     return edges.size();
   }
 
+  /**
+   * @brief Функция возвращает аллокатор графа.
+   */
+  allocator_type get_allocator() const {
+    return edges.get_allocator();
+  }
+
  private:
   //! Разреженная матрица связности. Словарь исходящих рёбер.
-  std::unordered_map<size_t, std::unordered_set<size_t>> edges;
+  AdjacencyMap edges;
 
   //! Разреженная матрица связности. Словарь входящих рёбер.
-  std::unordered_map<size_t, std::unordered_set<size_t>> incomingEdges;
+  AdjacencyMap incomingEdges;
 };
 
+//! Простой ориентированный граф с политикой контейнеров по умолчанию.
+using OrientedGraph = BasicOrientedGraph<>;
+
 }  // namespace graph
 
 #endif  // INCLUDE_ORIENTED_GRAPH_HPP_
@@ -0,0 +1,246 @@
+/**
+ * @file parallel.hpp
+ *
+ * Вспомогательные функции для многопоточных алгоритмов.
+ */
+
+#ifndef INCLUDE_PARALLEL_HPP_
+#define INCLUDE_PARALLEL_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace graph {
+
+/**
+ * @brief Функция возвращает количество потоков по умолчанию (количество
+ *        ядер процессора).
+ */
+inline size_t DefaultNumThreads() {
+  const size_t hardware = std::thread::hardware_concurrency();
+
+  return hardware == 0 ? 1 : hardware;
+}
+
+/**
+ * @brief Функция возвращает количество потоков, которое ParallelFor()
+ *        использует для промежутка [0, size).
+ *
+ * @param size Длина промежутка.
+ * @param numThreads Количество потоков (0 - количество ядер процессора).
+ * @param grain Минимальная длина отрезка на один поток.
+ *
+ * По этому количеству, а не по numThreads, следует выделять рабочие
+ * массивы, в которые пишет каждый поток.
+ */
+inline size_t NumParallelChunks(size_t size, size_t numThreads,
+                                size_t grain = 1024) {
+  if (numThreads == 0)
+    numThreads = DefaultNumThreads();
+
+  return std::max<size_t>(1, std::min(numThreads, size / grain));
+}
+
+/**
+ * @brief Выполнить функцию параллельно для отрезков промежутка [0, size).
+ *
+ * @tparam Function Тип функции.
+ *
+ * @param size Длина промежутка.
+ * @param numThreads Количество потоков (0 - количество ядер процессора).
+ * @param function Функция function(thread, begin, end), которая
+ *        обрабатывает отрезок [begin, end). Номер потока thread меньше
+ *        числа, которое возвращает функция.
+ * @param grain Минимальная длина отрезка на один поток. Короткие
+ *        промежутки обрабатываются меньшим числом потоков.
+ *
+ * Промежуток делится на отрезки почти равной длины, последний отрезок
+ * обрабатывается вызывающим потоком. Если функция выбросила исключение,
+ * то оно передаётся вызывающему потоку после завершения всех потоков.
+ * Функция возвращает количество использованных потоков.
+ */
+template<typename Function>
+size_t ParallelFor(size_t size, size_t numThreads, Function function,
+                   size_t grain = 1024) {
+  numThreads = NumParallelChunks(size, numThreads, grain);
+
+  if (numThreads == 1) {
+    function(0, 0, size);
+    return 1;
+  }
+
+  std::vector<std::thread> threads;
+  std::vector<std::exception_ptr> errors(numThreads);
+
+  auto run = [&](size_t thread) {
+    try {
+      function(thread, thread * size / numThreads,
+               (thread + 1) * size / numThreads);
+    } catch (...) {
+      errors[thread] = std::current_exception();
+    }
+  };
+
+  threads.reserve(numThreads - 1);
+  for (size_t thread = 0; thread + 1 < numThreads; thread++)
+    threads.emplace_back(run, thread);
+
+  run(numThreads - 1);
+
+  for (auto& thread : threads)
+    thread.join();
+
+  for (auto& error : errors)
+    if (error)
+      std::rethrow_exception(error);
+
+  return numThreads;
+}
+
+/**
+ * @brief Пул потоков для многократного вызова ParallelFor().
+ *
+ * В отличие от функции ParallelFor(), которая создаёт потоки при каждом
+ * вызове, пул создаёт их один раз. ParallelFor() можно вызывать
+ * одновременно из разных потоков: отрезки всех вызовов ставятся в общую
+ * очередь, а последний отрезок каждого вызова обрабатывает вызывающий
+ * поток.
+ */
+class ThreadPool {
+ public:
+  /**
+   * @brief Конструктор.
+   *
+   * @param numThreads Количество потоков вместе с вызывающим
+   *        (0 - количество ядер процессора).
+   */
+  explicit ThreadPool(size_t numThreads = 0) :
+    numThreads(numThreads == 0 ? DefaultNumThreads() : numThreads),
+    stopping(false) {
+    for (size_t i = 1; i < this->numThreads; i++)
+      threads.emplace_back([this] { Run(); });
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      stopping = true;
+    }
+    condition.notify_all();
+
+    for (std::thread& thread : threads)
+      thread.join();
+  }
+
+  /**
+   * @brief Функция возвращает количество потоков вместе с вызывающим.
+   */
+  size_t NumThreads() const {
+    return numThreads;
+  }
+
+  /**
+   * @brief Выполнить функцию параллельно для отрезков промежутка
+   *        [0, size).
+   *
+   * Параметры и результат те же, что и у функции ParallelFor() с числом
+   * потоков NumThreads().
+   */
+  template<typename Function>
+  size_t ParallelFor(size_t size, Function function, size_t grain = 1024) {
+    const size_t numChunks = NumParallelChunks(size, numThreads, grain);
+
+    if (numChunks == 1) {
+      function(0, 0, size);
+      return 1;
+    }
+
+    std::vector<std::exception_ptr> errors(numChunks);
+    std::mutex doneMutex;
+    std::condition_variable doneCondition;
+    size_t remaining = numChunks - 1;
+
+    auto run = [&](size_t chunk) {
+      try {
+        function(chunk, chunk * size / numChunks,
+                 (chunk + 1) * size / numChunks);
+      } catch (...) {
+        errors[chunk] = std::current_exception();
+      }
+    };
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (size_t chunk = 0; chunk + 1 < numChunks; chunk++) {
+        tasks.push_back([&, chunk] {
+          run(chunk);
+          // Уведомление под мьютексом: после него вызывающий поток может
+          // сразу выйти и уничтожить doneCondition.
+          std::lock_guard<std::mutex> doneLock(doneMutex);
+          if (--remaining == 0)
+            doneCondition.notify_one();
+        });
+      }
+    }
+    condition.notify_all();
+
+    run(numChunks - 1);
+
+    {
+      std::unique_lock<std::mutex> lock(doneMutex);
+      doneCondition.wait(lock, [&] { return remaining == 0; });
+    }
+
+    for (auto& error : errors)
+      if (error)
+        std::rethrow_exception(error);
+
+    return numChunks;
+  }
+
+ private:
+  /**
+   * @brief Цикл потока пула.
+   */
+  void Run() {
+    while (true) {
+      std::function<void()> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return stopping || !tasks.empty(); });
+        if (tasks.empty())
+          return;
+        task = std::move(tasks.front());
+        tasks.pop_front();
+      }
+      task();
+    }
+  }
+
+  //! Количество потоков вместе с вызывающим.
+  size_t numThreads;
+  //! Отрезки, ожидающие потока.
+  std::deque<std::function<void()>> tasks;
+  //! Потоки пула.
+  std::vector<std::thread> threads;
+  //! Мьютекс для очереди.
+  std::mutex mutex;
+  //! Условная переменная для ожидания отрезков.
+  std::condition_variable condition;
+  //! Флаг остановки.
+  bool stopping;
+};
+
+}  // namespace graph
+
+#endif  // INCLUDE_PARALLEL_HPP_
@@ -0,0 +1,331 @@
+/**
+ * @file push_relabel.hpp
+ *
+ * Реализация алгоритма проталкивания предпотока.
+ */
+
+#ifndef INCLUDE_PUSH_RELABEL_HPP_
+#define INCLUDE_PUSH_RELABEL_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <vector>
+#include "weighted_oriented_graph.hpp"
+#include "flow_network.hpp"
+#include "vertex_index.hpp"
+
+namespace graph {
+
+/**
+ * @brief Состояние алгоритма проталкивания предпотока.
+ *
+ * @tparam Weight Тип пропускной способности рёбер.
+ *
+ * Активные вершины (с положительным избытком) хранятся в корзинах по высоте,
+ * и на каждом шаге разряжается активная вершина с наибольшей высотой.
+ * Используются две эвристики:
+ *
+ * - глобальная перемаркировка: высоты периодически пересчитываются
+ *   обходом в ширину от стока (и от истока для вершин, из которых сток
+ *   недостижим);
+ * - разрыв: если на высоте h < n не осталось вершин, то все вершины
+ *   с высотой между h и n не могут достичь стока и сразу поднимаются
+ *   на высоту n + 1.
+ *
+ * Алгоритм выполняется за O(n^2 sqrt(m)).
+ */
+template<typename Weight>
+class PushRelabelSolver {
+ public:
+  /**
+   * @brief Конструктор.
+   *
+   * @param network Остаточная сеть.
+   * @param s Индекс истока.
+   * @param t Индекс стока.
+   */
+  PushRelabelSolver(FlowNetwork<Weight>* network, size_t s, size_t t) :
+    network(network),
+    n(network->NumVertices()),
+    s(s),
+    t(t),
+    height(n, 0),
+    excess(n, Weight()),
+    current(n, 0),
+    count(2 * n + 1, 0),
+    active(2 * n + 1),
+    highest(0),
+    relabels(0) {
+  }
+
+  /**
+   * @brief Найти максимальный поток.
+   *
+   * Функция возвращает величину потока. После её завершения избыток
+   * всех вершин, кроме истока и стока, равен нулю.
+   */
+  Weight Run() {
+    for (size_t i = network->Begin(s); i < network->End(s); i++) {
+      const size_t e = network->Adjacency()[i];
+      const Weight delta = network->Residual(e);
+
+      if (delta > Weight()) {
+        network->Push(e, delta);
+        excess[network->Head(e)] += delta;
+        excess[s] -= delta;
+      }
+    }
+
+    GlobalRelabel();
+
+    while (true) {
+      while (highest > 0 && active[highest].empty())
+        highest--;
+
+      if (active[highest].empty())
+        break;
+
+      const size_t v = active[highest].back();
+      active[highest].pop_back();
+
+      if (height[v] != highest || !(excess[v] > Weight()))
+        continue;
+
+      Discharge(v);
+
+      if (relabels >= n) {
+        relabels = 0;
+        GlobalRelabel();
+      }
+    }
+
+    return excess[t];
+  }
+
+ private:
+  /**
+   * @brief Сделать вершину активной.
+   *
+   * @param v Индекс вершины.
+   */
+  void Activate(size_t v) {
+    if (v == s || v == t || height[v] >= 2 * n)
+      return;
+
+    active[height[v]].push_back(v);
+    highest = std::max(highest, height[v]);
+  }
+
+  /**
+   * @brief Изменить высоту вершины.
+   *
+   * @param v Индекс вершины.
+   * @param h Новая высота.
+   */
+  void SetHeight(size_t v, size_t h) {
+    count[height[v]]--;
+    height[v] = h;
+    count[height[v]]++;
+  }
+
+  /**
+   * @brief Разрядить вершину: протолкнуть весь её избыток.
+   *
+   * @param v Индекс вершины.
+   */
+  void Discharge(size_t v) {
+    while (excess[v] > Weight()) {
+      if (current[v] == network->End(v)) {
+        Relabel(v);
+
+        if (height[v] >= 2 * n)
+          return;
+
+        continue;
+      }
+
+      const size_t e = network->Adjacency()[current[v]];
+      const size_t to = network->Head(e);
+
+      if (network->Residual(e) > Weight() && height[v] == height[to] + 1) {
+        const Weight delta = std::min(excess[v], network->Residual(e));
+        const bool wasActive = excess[to] > Weight();
+
+        network->Push(e, delta);
+        excess[v] -= delta;
+        excess[to] += delta;
+
+        if (!wasActive)
+          Activate(to);
+      } else {
+        current[v]++;
+      }
+    }
+  }
+
+  /**
+   * @brief Поднять вершину.
+   *
+   * @param v Индекс вершины.
+   *
+   * Если после подъёма на старой высоте не осталось вершин, то применяется
+   * эвристика разрыва.
+   */
+  void Relabel(size_t v) {
+    const size_t old = height[v];
+    size_t h = 2 * n;
+
+    for (size_t i = network->Begin(v); i < network->End(v); i++) {
+      const size_t e = network->Adjacency()[i];
+
+      if (network->Residual(e) > Weight())
+        h = std::min(h, height[network->Head(e)] + 1);
+    }
+
+    SetHeight(v, h);
+    current[v] = network->Begin(v);
+    relabels++;
+
+    if (old < n && count[old] == 0)
+      Gap(old);
+  }
+
+  /**
+   * @brief Эвристика разрыва.
+   *
+   * @param gap Высота, на которой не осталось вершин.
+   */
+  void Gap(size_t gap) {
+    for (size_t u = 0; u < n; u++) {
+      if (u == s || height[u] <= gap || height[u] >= n)
+        continue;
+
+      SetHeight(u, n + 1);
+      current[u] = network->Begin(u);
+
+      if (excess[u] > Weight())
+        Activate(u);
+    }
+  }
+
+  /**
+   * @brief Обход в ширину по обратным остаточным дугам.
+   *
+   * @param root Индекс корня обхода.
+   * @param base Высота корня.
+   * @param queue Буфер для очереди обхода.
+   */
+  void ReverseBfs(size_t root, size_t base, std::vector<size_t>* queue) {
+    queue->clear();
+    queue->push_back(root);
+    height[root] = base;
+
+    for (size_t head = 0; head < queue->size(); head++) {
+      const size_t v = (*queue)[head];
+
+      for (size_t i = network->Begin(v); i < network->End(v); i++) {
+        const size_t e = network->Adjacency()[i];
+        const size_t from = network->Head(e);
+
+        // Вершина from может протолкнуть поток в v по дуге e ^ 1.
+        if (height[from] == 2 * n && network->Residual(e ^ 1) > Weight()) {
+          height[from] = height[v] + 1;
+          queue->push_back(from);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Глобальная перемаркировка.
+   *
+   * Высота каждой вершины становится равной расстоянию до стока
+   * в остаточной сети, а для вершин, из которых сток недостижим, -
+   * n плюс расстояние до истока.
+   */
+  void GlobalRelabel() {
+    std::vector<size_t> queue;
+
+    // Исток не участвует в обходе от стока: его высота всегда равна n.
+    std::fill(height.begin(), height.end(), 2 * n);
+    height[s] = n;
+    ReverseBfs(t, 0, &queue);
+    ReverseBfs(s, n, &queue);
+
+    std::fill(count.begin(), count.end(), 0);
+    for (auto& bucket : active)
+      bucket.clear();
+    highest = 0;
+
+    for (size_t v = 0; v < n; v++) {
+      count[height[v]]++;
+      current[v] = network->Begin(v);
+
+      if (excess[v] > Weight())
+        Activate(v);
+    }
+  }
+
+  //! Остаточная сеть.
+  FlowNetwork<Weight>* network;
+  //! Количество вершин.
+  size_t n;
+  //! Индекс истока.
+  size_t s;
+  //! Индекс стока.
+  size_t t;
+  //! Высоты вершин.
+  std::vector<size_t> height;
+  //! Избытки вершин.
+  std::vector<Weight> excess;
+  //! Указатели на текущую дугу (позиции в FlowNetwork::Adjacency()).
+  std::vector<size_t> current;
+  //! Количество вершин на каждой высоте.
+  std::vector<size_t> count;
+  //! Корзины активных вершин по высоте.
+  std::vector<std::vector<size_t>> active;
+  //! Наибольшая высота непустой корзины.
+  size_t highest;
+  //! Количество подъёмов с последней глобальной перемаркировки.
+  size_t relabels;
+};
+
+/**
+ * @brief Алгоритм проталкивания предпотока (с выбором наивысшей вершины).
+ *
+ * @tparam Weight Тип пропускной способности рёбер.
+ *
+ * @param g исходный граф.
+ * @param result поток.
+ * @param s исток.
+ * @param t сток.
+ *
+ * Функция имеет тот же интерфейс, что и Dinic(): граф result заменяется
+ * копией графа g, в которой вес каждого ребра равен потоку по нему.
+ * Функция возвращает величину максимального потока.
+ */
+template<typename Weight>
+Weight PushRelabel(const graph::WeightedOrientedGraph<Weight> &g,
+  graph::WeightedOrientedGraph<Weight> *result,
+  const size_t s, const size_t t) {
+  FlowNetwork<Weight> network(g);
+  const VertexIndex& index = network.Index();
+
+  Weight flow = Weight();
+  const size_t source = index.Find(s), sink = index.Find(t);
+
+  if (source != VertexIndex::npos && sink != VertexIndex::npos &&
+      source != sink) {
+    PushRelabelSolver<Weight> solver(&network, source, sink);
+
+    flow = solver.Run();
+  }
+
+  network.ExtractFlow(result);
+
+  return flow;
+}
+
+}  //  namespace graph
+
+#endif  //  INCLUDE_PUSH_RELABEL_HPP_
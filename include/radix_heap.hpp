@@ -0,0 +1,135 @@
+/**
+ * @file radix_heap.hpp
+ *
+ * Реализация поразрядной кучи (radix heap).
+ */
+
+#ifndef INCLUDE_RADIX_HEAP_HPP_
+#define INCLUDE_RADIX_HEAP_HPP_
+
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+/**
+ * @brief Поразрядная куча для монотонных очередей с приоритетом.
+ *
+ * @tparam Key Беззнаковый целый тип ключа.
+ * @tparam Value Тип значения.
+ *
+ * Куча допускает только ключи, не меньшие последнего извлечённого ключа,
+ * что выполняется в алгоритме Дейкстры. Элемент с ключом x хранится
+ * в корзине с номером, равным номеру старшего бита, в котором x отличается
+ * от последнего извлечённого ключа. При извлечении из пустой нулевой корзины
+ * первая непустая корзина перераспределяется, и каждый элемент за всё время
+ * перемещается не более чем sizeof(Key) * 8 раз.
+ */
+template<typename Key, typename Value>
+class RadixHeap {
+  static_assert(std::is_unsigned<Key>::value,
+                "RadixHeap requires an unsigned key type");
+
+ public:
+  //! Количество корзин.
+  static constexpr size_t numBuckets = std::numeric_limits<Key>::digits + 1;
+
+  /**
+   * @brief Конструктор пустой кучи.
+   */
+  RadixHeap() :
+    buckets(numBuckets),
+    last(0),
+    size(0) {
+  }
+
+  /**
+   * @brief Функция возвращает true, если куча пуста.
+   */
+  bool Empty() const {
+    return size == 0;
+  }
+
+  /**
+   * @brief Функция возвращает количество элементов в куче.
+   */
+  size_t Size() const {
+    return size;
+  }
+
+  /**
+   * @brief Добавить элемент.
+   *
+   * @param key Ключ. Должен быть не меньше последнего извлечённого ключа,
+   *        иначе функция выбрасывает исключение std::invalid_argument.
+   * @param value Значение.
+   */
+  void Push(Key key, Value value) {
+    if (key < last)
+      throw std::invalid_argument("RadixHeap: key is less than the last key");
+
+    buckets[Bucket(key)].emplace_back(key, std::move(value));
+    size++;
+  }
+
+  /**
+   * @brief Извлечь элемент с минимальным ключом.
+   *
+   * Куча не должна быть пустой.
+   */
+  std::pair<Key, Value> Pop() {
+    if (buckets[0].empty()) {
+      size_t i = 1;
+      while (buckets[i].empty())
+        i++;
+
+      last = buckets[i][0].first;
+      for (const auto& item : buckets[i])
+        if (item.first < last)
+          last = item.first;
+
+      for (auto& item : buckets[i])
+        buckets[Bucket(item.first)].push_back(std::move(item));
+      buckets[i].clear();
+    }
+
+    std::pair<Key, Value> result = std::move(buckets[0].back());
+    buckets[0].pop_back();
+    size--;
+
+    return result;
+  }
+
+ private:
+  /**
+   * @brief Номер корзины для ключа.
+   *
+   * @param key Ключ.
+   */
+  size_t Bucket(Key key) const {
+    Key diff = key ^ last;
+    size_t bucket = 0;
+
+    while (diff != 0) {
+      diff >>= 1;
+      bucket++;
+    }
+
+    return bucket;
+  }
+
+  //! Корзины элементов.
+  std::vector<std::vector<std::pair<Key, Value>>> buckets;
+  //! Последний извлечённый ключ.
+  Key last;
+  //! Количество элементов.
+  size_t size;
+};
+
+}  // namespace graph
+
+#endif  // INCLUDE_RADIX_HEAP_HPP_
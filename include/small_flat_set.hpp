@@ -0,0 +1,512 @@
+/**
+ * @file small_flat_set.hpp
+ *
+ * Множество с небольшим числом элементов внутри объекта и политика
+ * контейнеров для классов графов, используемая по умолчанию.
+ */
+
+#ifndef INCLUDE_SMALL_FLAT_SET_HPP_
+#define INCLUDE_SMALL_FLAT_SET_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <flat_hash.hpp>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace graph {
+
+/**
+ * @brief Множество, хранящее до N элементов внутри объекта.
+ *
+ * @tparam Key Тип ключа.
+ * @tparam N Количество элементов, хранящихся внутри объекта.
+ * @tparam Hash Хеш-функция.
+ * @tparam Allocator Аллокатор.
+ *
+ * У большинства вершин графа всего несколько соседей, поэтому первые N
+ * элементов лежат в массиве внутри объекта и не требуют выделения
+ * памяти. Проверка наличия ключа среди них - сравнение со всеми N
+ * ячейками без ветвлений, на x86-64 векторными инструкциями. Когда
+ * элементов становится больше N, они переносятся в graph::FlatHashSet,
+ * а когда их снова становится не больше N / 2, возвращаются в массив.
+ *
+ * Интерфейс повторяет основные функции std::unordered_set. Итераторы
+ * и ссылки на элементы после изменения множества недействительны.
+ * Аллокатор ведёт себя так же, как у graph::FlatHashTable.
+ */
+template<typename Key, size_t N = 4, typename Hash = std::hash<Key>,
+         typename Allocator = std::allocator<Key>>
+class SmallFlatSet {
+ private:
+  static_assert(N > 0 && N <= 32,
+                "SmallFlatSet keeps from 1 to 32 elements inline");
+
+  //! Множество для вершин с большим количеством соседей.
+  using LargeSet = FlatHashSet<Key, Hash, Allocator>;
+  //! Аллокатор вынесенного множества.
+  using LargeAllocator = typename std::allocator_traits<Allocator>::
+      template rebind_alloc<LargeSet>;
+  //! Операции аллокатора вынесенного множества.
+  using LargeTraits = std::allocator_traits<LargeAllocator>;
+
+ public:
+  /**
+   * @brief Итератор по элементам множества.
+   */
+  class Iterator {
+   public:
+    //! Категория итератора.
+    using iterator_category = std::forward_iterator_tag;
+    //! Тип значения итератора.
+    using value_type = Key;
+    //! Тип разности итераторов.
+    using difference_type = std::ptrdiff_t;
+    //! Тип указателя.
+    using pointer = const Key*;
+    //! Тип ссылки.
+    using reference = const Key&;
+
+    /**
+     * @brief Конструктор итератора, не связанного с множеством.
+     */
+    Iterator() :
+      pos(nullptr),
+      largeIt() {
+    }
+
+    /**
+     * @brief Конструктор итератора по элементам внутри объекта.
+     *
+     * @param pos Текущий элемент массива.
+     */
+    explicit Iterator(const Key* pos) :
+      pos(pos),
+      largeIt() {
+    }
+
+    /**
+     * @brief Конструктор итератора по вынесенному множеству.
+     *
+     * @param largeIt Итератор вынесенного множества.
+     */
+    explicit Iterator(typename LargeSet::iterator largeIt) :
+      pos(nullptr),
+      largeIt(largeIt) {
+    }
+
+    /**
+     * @brief Оператор сравнения == для итератора.
+     * @param other Другой итератор.
+     */
+    bool operator==(const Iterator& other) const {
+      return pos == other.pos && largeIt == other.largeIt;
+    }
+
+    /**
+     * @brief Оператор сравнения != для итератора.
+     * @param other Другой итератор.
+     */
+    bool operator!=(const Iterator& other) const {
+      return !(*this == other);
+    }
+
+    /**
+     * @brief Префиксная операция инкремента для итератора.
+     */
+    Iterator& operator++() {
+      if (pos)
+        pos++;
+      else
+        ++largeIt;
+      return *this;
+    }
+
+    /**
+     * @brief Постфиксная операция инкремента для итератора.
+     */
+    Iterator operator++(int) {
+      Iterator retval(*this);
+      ++*this;
+      return retval;
+    }
+
+    /**
+     * @brief Функция возвращает элемент, на который указывает итератор.
+     */
+    reference operator*() const {
+      return pos ? *pos : *largeIt;
+    }
+
+    /**
+     * @brief Функция возвращает указатель на элемент.
+     */
+    pointer operator->() const {
+      return &**this;
+    }
+
+   private:
+    //! Текущий элемент массива (nullptr для вынесенного множества).
+    const Key* pos;
+    //! Итератор вынесенного множества.
+    typename LargeSet::iterator largeIt;
+  };
+
+  //! Тип итератора (элементы множества менять нельзя).
+  using iterator = Iterator;
+  //! Тип константного итератора.
+  using const_iterator = Iterator;
+  //! Тип элемента.
+  using value_type = Key;
+  //! Тип ключа.
+  using key_type = Key;
+  //! Тип размера.
+  using size_type = size_t;
+  //! Тип аллокатора.
+  using allocator_type = Allocator;
+
+  /**
+   * @brief Конструктор пустого множества.
+   */
+  SmallFlatSet() :
+    SmallFlatSet(Allocator()) {
+  }
+
+  /**
+   * @brief Конструктор пустого множества с заданным аллокатором.
+   *
+   * @param alloc Аллокатор.
+   */
+  explicit SmallFlatSet(const Allocator& alloc) :
+    small(),
+    numSmall(0),
+    allocator(alloc),
+    large(nullptr) {
+  }
+
+  /**
+   * @brief Конструктор копирования.
+   * @param other Другое множество.
+   */
+  SmallFlatSet(const SmallFlatSet& other) :
+    numSmall(other.numSmall),
+    allocator(LargeTraits::select_on_container_copy_construction(
+        other.allocator)),
+    large(nullptr) {
+    for (size_t i = 0; i < N; i++)
+      small[i] = other.small[i];
+    if (other.large) {
+      NewLarge();
+      *large = *other.large;
+    }
+  }
+
+  /**
+   * @brief Конструктор перемещения.
+   * @param other Другое множество.
+   */
+  SmallFlatSet(SmallFlatSet&& other) noexcept :
+    numSmall(other.numSmall),
+    allocator(other.allocator),
+    large(other.large) {
+    for (size_t i = 0; i < N; i++)
+      small[i] = other.small[i];
+    other.numSmall = 0;
+    other.large = nullptr;
+  }
+
+  /**
+   * @brief Деструктор.
+   */
+  ~SmallFlatSet() {
+    FreeLarge();
+  }
+
+  /**
+   * @brief Оператор присваивания.
+   * @param other Другое множество.
+   */
+  SmallFlatSet& operator=(const SmallFlatSet& other) {
+    if (this != &other)
+      *this = SmallFlatSet(other);
+    return *this;
+  }
+
+  /**
+   * @brief Оператор перемещения.
+   * @param other Другое множество.
+   */
+  SmallFlatSet& operator=(SmallFlatSet&& other) noexcept {
+    if (this == &other)
+      return *this;
+
+    FreeLarge();
+    for (size_t i = 0; i < N; i++)
+      small[i] = other.small[i];
+    numSmall = other.numSmall;
+    large = other.large;
+    ReplaceAllocator(&allocator, other.allocator);
+    other.numSmall = 0;
+    other.large = nullptr;
+    return *this;
+  }
+
+  /**
+   * @brief Функция возвращает аллокатор множества.
+   */
+  Allocator get_allocator() const {
+    return Allocator(allocator);
+  }
+
+  /**
+   * @brief Функция возвращает итератор на первый элемент.
+   */
+  iterator begin() const {
+    return large ? Iterator(large->begin()) : Iterator(small);
+  }
+
+  /**
+   * @brief Функция возвращает итератор на элемент "после последнего".
+   */
+  iterator end() const {
+    return large ? Iterator(large->end()) : Iterator(small + numSmall);
+  }
+
+  /**
+   * @brief Функция возвращает количество элементов.
+   */
+  size_t size() const {
+    return large ? large->size() : numSmall;
+  }
+
+  /**
+   * @brief Функция возвращает true, если множество пусто.
+   */
+  bool empty() const {
+    return size() == 0;
+  }
+
+  /**
+   * @brief Удалить все элементы и освободить память.
+   */
+  void clear() {
+    numSmall = 0;
+    FreeLarge();
+  }
+
+  /**
+   * @brief Подготовить множество к хранению n элементов без перестроения.
+   *
+   * @param n Количество элементов.
+   */
+  void reserve(size_t n) {
+    if (n <= N)
+      return;
+    if (!large)
+      Spill();
+    large->reserve(n);
+  }
+
+  /**
+   * @brief Найти ключ.
+   *
+   * @param key Ключ.
+   */
+  iterator find(const Key& key) const {
+    if (large)
+      return Iterator(large->find(key));
+
+    for (size_t i = 0; i < numSmall; i++)
+      if (small[i] == key)
+        return Iterator(small + i);
+    return end();
+  }
+
+  /**
+   * @brief Функция возвращает 1, если ключ есть в множестве, и 0 иначе.
+   *
+   * @param key Ключ.
+   */
+  size_t count(const Key& key) const {
+    if (large)
+      return large->count(key);
+
+    // Незанятые ячейки массива отсекаются маской.
+    const uint32_t used = static_cast<uint32_t>((uint64_t{1} << numSmall) - 1);
+    return (MatchSmall(key) & used) != 0 ? 1 : 0;
+  }
+
+  /**
+   * @brief Добавить ключ.
+   *
+   * @param key Ключ.
+   * @return Функция возвращает итератор на ключ и true, если ключа
+   * в множестве не было.
+   */
+  std::pair<iterator, bool> insert(const Key& key) {
+    if (!large) {
+      iterator it = find(key);
+      if (it != end())
+        return {it, false};
+
+      if (numSmall < N) {
+        small[numSmall] = key;
+        return {Iterator(small + numSmall++), true};
+      }
+
+      Spill();
+    }
+
+    auto [it, inserted] = large->insert(key);
+    return {Iterator(it), inserted};
+  }
+
+  /**
+   * @brief Удалить ключ.
+   *
+   * @param key Ключ.
+   * @return Функция возвращает количество удалённых элементов (0 или 1).
+   */
+  size_t erase(const Key& key) {
+    if (large) {
+      const size_t erased = large->erase(key);
+      if (large->size() <= N / 2)
+        Unspill();
+      return erased;
+    }
+
+    for (size_t i = 0; i < numSmall; i++) {
+      if (small[i] == key) {
+        small[i] = small[--numSmall];
+        small[numSmall] = Key();
+        return 1;
+      }
+    }
+
+    return 0;
+  }
+
+ private:
+  //! Можно ли сравнивать ключи векторными инструкциями SSE2.
+  static constexpr bool kVectorMatch =
+      std::is_integral<Key>::value && sizeof(Key) == 8 && N % 2 == 0;
+
+  /**
+   * @brief Сравнить ключ со всеми N ячейками массива.
+   *
+   * @param key Ключ.
+   * @return Функция возвращает маску: бит i равен 1, если small[i] == key.
+   *
+   * Сравнение идёт без ветвлений и раннего выхода, поэтому для маленьких
+   * N оно дешевле поиска в хеш-таблице. 64-битные ключи сравниваются
+   * по два за инструкцию: SSE2 сравнивает 32-битные половины, и ячейка
+   * совпадает, если совпали обе. Незанятые ячейки инициализированы,
+   * поэтому читать их можно.
+   */
+  uint32_t MatchSmall(const Key& key) const {
+    uint32_t mask = 0;
+
+#if defined(__SSE2__)
+    if constexpr (kVectorMatch) {
+      const __m128i needle = _mm_set1_epi64x(static_cast<int64_t>(key));
+      for (size_t i = 0; i < N; i += 2) {
+        __m128i eq = _mm_cmpeq_epi32(
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(small + i)),
+            needle);
+        eq = _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+        mask |= static_cast<uint32_t>(
+            _mm_movemask_pd(_mm_castsi128_pd(eq))) << i;
+      }
+      return mask;
+    }
+#endif
+
+    for (size_t i = 0; i < N; i++)
+      mask |= static_cast<uint32_t>(small[i] == key) << i;
+    return mask;
+  }
+
+  //! Создать пустое вынесенное множество.
+  void NewLarge() {
+    large = LargeTraits::allocate(allocator, 1);
+    new (large) LargeSet(Allocator(allocator));
+  }
+
+  //! Освободить вынесенное множество.
+  void FreeLarge() {
+    if (!large)
+      return;
+    large->~LargeSet();
+    LargeTraits::deallocate(allocator, large, 1);
+    large = nullptr;
+  }
+
+  //! Перенести элементы из массива во вынесенное множество.
+  void Spill() {
+    NewLarge();
+    large->reserve(2 * N);
+    for (size_t i = 0; i < numSmall; i++)
+      large->insert(small[i]);
+    numSmall = 0;
+  }
+
+  //! Вернуть элементы из вынесенного множества в массив.
+  void Unspill() {
+    numSmall = 0;
+    for (const Key& key : *large)
+      small[numSmall++] = key;
+    for (size_t i = numSmall; i < N; i++)
+      small[i] = Key();
+    FreeLarge();
+  }
+
+  //! Элементы, хранящиеся внутри объекта.
+  Key small[N];
+  //! Количество элементов в массиве small.
+  uint32_t numSmall;
+  //! Аллокатор вынесенного множества.
+  LargeAllocator allocator;
+  //! Вынесенное множество (nullptr, пока элементы помещаются в small).
+  LargeSet* large;
+};
+
+/**
+ * @brief Политика контейнеров, используемая классами графов по умолчанию.
+ *
+ * @tparam N Количество соседей, хранящихся внутри записи вершины.
+ * @tparam Allocator Аллокатор всех контейнеров графа.
+ *
+ * Множества соседей хранят до N вершин без выделения памяти, словари
+ * устроены как в FlatHashContainers. У типичной вершины степени 1-4
+ * все соседи лежат прямо в ячейке словаря смежности.
+ *
+ * По умолчанию контейнеры используют std::pmr::polymorphic_allocator:
+ * граф, созданный без аргументов, берёт память из
+ * std::pmr::get_default_resource(), а граф, созданный с аллокатором
+ * (например, над std::pmr::monotonic_buffer_resource), держит все
+ * вершины и рёбра в этой памяти.
+ */
+template<size_t N = 4,
+         typename Allocator = std::pmr::polymorphic_allocator<std::byte>>
+struct SmallFlatContainers {
+  //! Множество.
+  template<typename Key>
+  using Set = SmallFlatSet<Key, N, std::hash<Key>, Allocator>;
+
+  //! Словарь.
+  template<typename Key, typename Value>
+  using Map = FlatHashMap<Key, Value, std::hash<Key>, Allocator>;
+};
+
+}  // namespace graph
+
+#endif  // INCLUDE_SMALL_FLAT_SET_HPP_
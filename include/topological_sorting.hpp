@@ -9,59 +9,202 @@
 #define INCLUDE_TOPOLOGICAL_SORTING_HPP_
 
 #include <algorithm>
-#include <iostream>
-#include <map>
+#include <atomic>
 #include <vector>
-#include <unordered_set>
 #include "graph.hpp"
 #include "oriented_graph.hpp"
 #include "iterators.hpp"
+#include "csr_graph.hpp"
+#include "dfs.hpp"
+#include "parallel.hpp"
+#include "vertex_index.hpp"
 
 
 namespace graph {
 
 /**
- * @brief Обход графа в глубину.
+ * @brief Обработчик обхода в глубину для топологической сортировки.
+ *
+ * Обход идёт по входящим рёбрам, поэтому вершина добавляется в ответ
+ * после всех вершин, из которых в неё можно попасть.
+ */
+class TopologicalSortingVisitor : public DfsVisitor {
+ public:
+  /**
+   * @brief Конструктор.
+   *
+   * @param index отображение номеров вершин в плотные индексы.
+   * @param points вектор-ответ.
+   */
+  TopologicalSortingVisitor(const VertexIndex& index,
+                            std::vector<size_t>* points) :
+    index(index),
+    points(points) {
+  }
+
+  //! Выход из вершины v: добавляем её в ответ.
+  void Exit(size_t v, size_t /* parent */) {
+    points->push_back(index.Id(v));
+  }
+
+ private:
+  //! Отображение номеров вершин в плотные индексы.
+  const VertexIndex& index;
+  //! Вектор-ответ.
+  std::vector<size_t>* points;
+};
+
+/**
+ * @brief Сама топологическая сортировка.
  *
  * @tparam T тип графа.
  *
- * @param used список вершин, в которых уже побывали.
- * @param v текущая вершина в обходе..
  * @param points вектор-ответ.
+ *
+ * Обход в глубину выполняется без рекурсии (см. DepthFirstSearch()).
  */
 
 template<class T>
 
-void DfsTopologicalSorting(std::unordered_set<size_t> *used,
-                           std::vector<size_t>* points,
-                           const T& oriented_graph, size_t v) {
-    used->insert(v);
-    for (size_t to : oriented_graph.IncomingEdges(v)) {
-      if ((*used).find(to) == (*used).end()) {
-      DfsTopologicalSorting(used, points, oriented_graph, to);
-      }
-    }
-    (*points).push_back(v);
+void TopologicalSorting(const T& oriented_graph, std::vector<size_t>* points) {
+    const CsrGraph<> csr(oriented_graph);
+    TopologicalSortingVisitor visitor(csr.Indices(), points);
+
+    points->reserve(points->size() + csr.NumVertices());
+    DepthFirstSearch(csr.ReverseOffsets(), csr.ReverseNeighbours(), &visitor);
 }
 
 /**
- * @brief Сама топологическая сортировка.
+ * @brief Результат топологической сортировки алгоритмом Кана.
+ */
+struct TopologicalOrder {
+  //! Вершины в топологическом порядке. Если в графе есть цикл, то здесь
+  //! только те вершины, которые удалось упорядочить.
+  std::vector<size_t> order;
+  //! Уровни вершин: levels[i] - уровень вершины order[i]. Вершины без
+  //! входящих рёбер имеют уровень 0, остальные - на единицу больше
+  //! наибольшего уровня своих предков.
+  std::vector<size_t> levels;
+  //! Цикл v1 -> v2 -> ... -> vk -> v1, если он есть, иначе пустой список.
+  std::vector<size_t> cycle;
+};
+
+/**
+ * @brief Топологическая сортировка алгоритмом Кана.
  *
  * @tparam T тип графа.
  *
- * @param points вектор-ответ.
+ * @param oriented_graph граф.
+ * @param result результат.
+ * @param numThreads количество потоков (0 - количество ядер процессора).
+ *
+ * Вершины обрабатываются уровнями: сначала все вершины без входящих рёбер,
+ * затем все вершины, у которых после удаления предыдущего уровня
+ * не осталось входящих рёбер, и так далее. Рёбра вершин одного уровня
+ * обрабатываются параллельно, счётчики входящих рёбер уменьшаются
+ * атомарно. Внутри уровня вершины упорядочены по возрастанию индексов,
+ * поэтому результат не зависит от количества потоков.
+ *
+ * Если упорядочить удалось не все вершины, то оставшиеся содержат цикл:
+ * у каждой из них есть неупорядоченный предок, и, переходя от вершины
+ * к такому предку, функция находит цикл. Функция возвращает true, если
+ * в графе нет циклов.
  */
-
 template<class T>
+bool KahnTopologicalSorting(const T& oriented_graph, TopologicalOrder* result,
+                            size_t numThreads = 0) {
+  const CsrGraph<> csr(oriented_graph);
+  const size_t n = csr.NumVertices();
+  const std::vector<size_t>& offsets = csr.Offsets();
+  const std::vector<size_t>& neighbours = csr.Neighbours();
+  const std::vector<size_t>& reverseOffsets = csr.ReverseOffsets();
+  const std::vector<size_t>& reverseNeighbours = csr.ReverseNeighbours();
 
-void TopologicalSorting(const T& oriented_graph, std::vector<size_t>* points) {
-    std::unordered_set<size_t> used;
+  if (numThreads == 0)
+    numThreads = DefaultNumThreads();
+
+  result->order.clear();
+  result->levels.clear();
+  result->cycle.clear();
+  result->order.reserve(n);
+  result->levels.reserve(n);
 
-    for (size_t v : oriented_graph.Vertices()) {
-        if (used.find(v) == (used).end()) {
-          DfsTopologicalSorting(&used, points, oriented_graph, v);
+  std::vector<std::atomic<size_t>> inDegree(n);
+  std::vector<size_t> frontier, next;
+
+  for (size_t v = 0; v < n; v++) {
+    inDegree[v].store(reverseOffsets[v + 1] - reverseOffsets[v],
+                      std::memory_order_relaxed);
+
+    if (reverseOffsets[v + 1] == reverseOffsets[v])
+      frontier.push_back(v);
+  }
+
+  // Вершины следующего уровня, найденные каждым из потоков.
+  std::vector<std::vector<size_t>> found;
+
+  for (size_t level = 0; !frontier.empty(); level++) {
+    for (size_t v : frontier) {
+      result->order.push_back(csr.Id(v));
+      result->levels.push_back(level);
+    }
+
+    found.resize(std::max(found.size(),
+                          NumParallelChunks(frontier.size(), numThreads)));
+
+    const size_t used = ParallelFor(frontier.size(), numThreads,
+        [&](size_t thread, size_t begin, size_t end) {
+      found[thread].clear();
+
+      for (size_t i = begin; i < end; i++) {
+        const size_t v = frontier[i];
+
+        for (size_t k = offsets[v]; k < offsets[v + 1]; k++) {
+          const size_t to = neighbours[k];
+
+          if (inDegree[to].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            found[thread].push_back(to);
         }
+      }
+    });
+
+    next.clear();
+    for (size_t thread = 0; thread < used; thread++)
+      next.insert(next.end(), found[thread].begin(), found[thread].end());
+    std::sort(next.begin(), next.end());
+    frontier.swap(next);
+  }
+
+  if (result->order.size() == n)
+    return true;
+
+  // Идём по неупорядоченным предкам, пока не встретим вершину повторно.
+  std::vector<size_t> position(n, VertexIndex::npos);
+  std::vector<size_t> path;
+  size_t v = 0;
+
+  while (inDegree[v].load(std::memory_order_relaxed) == 0)
+    v++;
+
+  while (position[v] == VertexIndex::npos) {
+    position[v] = path.size();
+    path.push_back(v);
+
+    for (size_t k = reverseOffsets[v]; k < reverseOffsets[v + 1]; k++) {
+      const size_t from = reverseNeighbours[k];
+
+      if (inDegree[from].load(std::memory_order_relaxed) > 0) {
+        v = from;
+        break;
+      }
     }
+  }
+
+  // Путь идёт против рёбер, поэтому цикл выписывается в обратном порядке.
+  for (size_t i = path.size(); i > position[v]; i--)
+    result->cycle.push_back(csr.Id(path[i - 1]));
+
+  return false;
 }
 
 }  // namespace graph
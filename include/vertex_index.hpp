@@ -0,0 +1,184 @@
+/**
+ * @file vertex_index.hpp
+ *
+ * Реализация отображения номеров вершин графа в плотные индексы.
+ */
+
+#ifndef INCLUDE_VERTEX_INDEX_HPP_
+#define INCLUDE_VERTEX_INDEX_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace graph {
+
+/**
+ * @brief Отображение номеров вершин в плотные индексы 0..N-1 и обратно.
+ *
+ * Номера вершин в графах произвольны и могут быть сколь угодно большими.
+ * Алгоритмы один раз строят это отображение и хранят состояние вершин
+ * (времена входа, расстояния, предков, флаги посещения) в обычных векторах,
+ * индексированных плотными индексами. При выводе результата индексы
+ * переводятся обратно в номера вершин.
+ *
+ * Индексы назначаются в порядке возрастания номеров вершин. Если номера
+ * вершин достаточно плотные, то для поиска индекса используется прямая
+ * таблица, в противном случае хеш-таблица.
+ */
+class VertexIndex {
+ public:
+  //! Значение, обозначающее отсутствие вершины.
+  static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+  /**
+   * @brief Конструктор пустого отображения.
+   */
+  VertexIndex() :
+    ids(),
+    table(),
+    map() {
+  }
+
+  /**
+   * @brief Построить отображение для вершин графа.
+   *
+   * @tparam Graph Тип графа.
+   *
+   * @param graph Граф.
+   */
+  template<typename Graph>
+  explicit VertexIndex(const Graph& graph) :
+    VertexIndex() {
+    std::vector<size_t> vertices;
+
+    vertices.reserve(graph.NumVertices());
+    for (size_t id : graph.Vertices())
+      vertices.push_back(id);
+
+    Assign(std::move(vertices));
+  }
+
+  /**
+   * @brief Построить отображение для заданного набора номеров вершин.
+   *
+   * @param vertices Номера вершин. Повторяющиеся номера допускаются.
+   */
+  explicit VertexIndex(std::vector<size_t> vertices) :
+    VertexIndex() {
+    Assign(std::move(vertices));
+  }
+
+  /**
+   * @brief Функция возвращает количество вершин.
+   */
+  size_t Size() const {
+    return ids.size();
+  }
+
+  /**
+   * @brief Функция проверяет, есть ли вершина в отображении.
+   *
+   * @param id Номер вершины.
+   */
+  bool Contains(size_t id) const {
+    return Find(id) != npos;
+  }
+
+  /**
+   * @brief Получить плотный индекс вершины.
+   *
+   * @param id Номер вершины.
+   *
+   * Функция возвращает индекс вершины или npos, если такой вершины нет.
+   */
+  size_t Find(size_t id) const {
+    if (!table.empty())
+      return id < table.size() ? table[id] : npos;
+
+    auto it = map.find(id);
+
+    return it == map.end() ? npos : it->second;
+  }
+
+  /**
+   * @brief Получить плотный индекс вершины.
+   *
+   * @param id Номер вершины.
+   *
+   * Если такой вершины нет, то функция выбрасывает исключение
+   * std::out_of_range.
+   */
+  size_t Index(size_t id) const {
+    const size_t index = Find(id);
+
+    if (index == npos)
+      throw std::out_of_range("VertexIndex: no such vertex");
+
+    return index;
+  }
+
+  /**
+   * @brief Получить номер вершины по плотному индексу.
+   *
+   * @param index Плотный индекс вершины.
+   */
+  size_t Id(size_t index) const {
+    return ids[index];
+  }
+
+  /**
+   * @brief Номера вершин в порядке возрастания индексов.
+   */
+  const std::vector<size_t>& Ids() const {
+    return ids;
+  }
+
+ private:
+  /**
+   * @brief Заполнить отображение.
+   *
+   * @param vertices Номера вершин.
+   */
+  void Assign(std::vector<size_t> vertices) {
+    std::sort(vertices.begin(), vertices.end());
+    vertices.erase(std::unique(vertices.begin(), vertices.end()),
+                   vertices.end());
+
+    ids = std::move(vertices);
+
+    if (ids.empty())
+      return;
+
+    // Прямая таблица используется, если она не более чем в 4 раза
+    // больше количества вершин.
+    if (ids.back() / 4 < ids.size()) {
+      table.assign(ids.back() + 1, npos);
+
+      for (size_t i = 0; i < ids.size(); i++)
+        table[ids[i]] = i;
+    } else {
+      map.reserve(ids.size());
+
+      for (size_t i = 0; i < ids.size(); i++)
+        map.emplace(ids[i], i);
+    }
+  }
+
+  //! Номера вершин по индексам.
+  std::vector<size_t> ids;
+
+  //! Прямая таблица индексов (для плотных номеров).
+  std::vector<size_t> table;
+
+  //! Хеш-таблица индексов (для разреженных номеров).
+  std::unordered_map<size_t, size_t> map;
+};
+
+}  // namespace graph
+
+#endif  // INCLUDE_VERTEX_INDEX_HPP_
@@ -8,9 +8,10 @@
 #ifndef INCLUDE_WEIGHTED_GRAPH_HPP_
 #define INCLUDE_WEIGHTED_GRAPH_HPP_
 
-#include <unordered_map>
-#include <unordered_set>
+#include <tuple>
 #include <utility>
+#include <small_flat_set.hpp>
+#include <edge_groups.hpp>
 #include <iterators.hpp>
 
 namespace graph {
@@ -19,19 +20,60 @@ namespace graph {
  * @brief Взвешенный неориентированный граф.
  *
  * @tparam Weight Тип веса графа.
+ * @tparam Containers Политика контейнеров для списков смежности
+ * (SmallFlatContainers, FlatHashContainers или StdHashContainers).
  */
-template<typename Weight>
+template<typename Weight, typename Containers = SmallFlatContainers<>>
 class WeightedGraph {
  public:
   //! Тип данных для веса ребра.
   using WeightType = Weight;
 
+  //! Словарь соседей вершины: номер соседа -> вес ребра.
+  using NeighboursMap = typename Containers::template Map<size_t, Weight>;
+
+  //! Словарь смежности: номер вершины -> словарь соседей.
+  using AdjacencyMap = typename Containers::template Map<size_t,
+                                                         NeighboursMap>;
+
+  //! Промежуток вершин графа.
+  using VerticesRange = graph::VerticesRange<AdjacencyMap>;
+
+  //! Тип аллокатора, из памяти которого берутся вершины и рёбра.
+  using allocator_type = typename AdjacencyMap::allocator_type;
+
   /**
    * @brief Конструктор класса WeightedGraph.
    */
   WeightedGraph() :
-    edges(),
-    weights() {
+    edges() {
+  }
+
+  /**
+   * @brief Конструктор графа, хранящего вершины и рёбра в памяти
+   *        аллокатора.
+   *
+   * @param alloc Аллокатор (например, std::pmr::polymorphic_allocator
+   *        над ареной запроса).
+   */
+  explicit WeightedGraph(const allocator_type& alloc) :
+    edges(alloc) {
+  }
+
+  /**
+   * @brief Конструктор графа по промежутку рёбер.
+   *
+   * @param first Начало промежутка рёбер (троек [откуда, куда, вес]).
+   * @param last Конец промежутка рёбер.
+   * @param alloc Аллокатор.
+   *
+   * Граф заполняется функцией AddEdges().
+   */
+  template<typename Iterator>
+  WeightedGraph(Iterator first, Iterator last,
+                const allocator_type& alloc = allocator_type()) :
+    edges(alloc) {
+    AddEdges(first, last);
   }
 
   /**
@@ -57,9 +99,54 @@ class WeightedGraph {
    * в граф. Если такое ребро в графе уже есть, то функция ничего не делает.
    */
   void AddEdge(size_t id1, size_t id2, Weight weight) {
-    edges[id1].insert(id2);
-    edges[id2].insert(id1);
-    weights[MakeEdgeId(id1, id2)] = weight;
+    edges[id1][id2] = weight;
+    edges[id2][id1] = weight;
+  }
+
+  /**
+   * @brief Зарезервировать место под вершины.
+   *
+   * @param numVertices Ожидаемое количество вершин.
+   * @param numEdges Ожидаемое количество рёбер; пока не используется
+   *        (соседи резервируются в AddEdges()).
+   */
+  void Reserve(size_t numVertices, [[maybe_unused]] size_t numEdges) {
+    edges.reserve(numVertices);
+  }
+
+  /**
+   * @brief Добавить в граф промежуток рёбер.
+   *
+   * @param first Начало промежутка рёбер.
+   * @param last Конец промежутка рёбер.
+   *
+   * Элементы промежутка - тройки [id1, id2, вес] (например,
+   * std::tuple<size_t, size_t, Weight>). Результат тот же, что у вызовов
+   * AddEdge() для каждого ребра по порядку, но рёбра сначала группируются
+   * по вершинам, и соседи каждой вершины резервируются и добавляются
+   * за один проход.
+   */
+  template<typename Iterator>
+  void AddEdges(Iterator first, Iterator last) {
+    using Arc = std::tuple<size_t, size_t, Weight>;
+    ArcVector<Arc, allocator_type> arcs(get_allocator());
+
+    ReserveArcs(&arcs, first, last, 2);
+    for (; first != last; ++first) {
+      const auto& [id1, id2, weight] = *first;
+      arcs.emplace_back(id1, id2, weight);
+      if (id1 != id2)
+        arcs.emplace_back(id2, id1, weight);
+    }
+
+    SortArcsBySource(&arcs);
+    AddArcSources(&edges, arcs);
+    ForEachArcGroup(arcs, [this](size_t source, auto begin, auto end) {
+      NeighboursMap& neighbours = edges[source];
+      neighbours.reserve(neighbours.size() + (end - begin));
+      for (auto it = begin; it != end; ++it)
+        neighbours[std::get<1>(*it)] = std::get<2>(*it);
+    });
   }
 
   /**
@@ -106,12 +193,10 @@ class WeightedGraph {
     if (it == edges.end())
       return;
 
-    for (size_t neighbourId : it->second) {
+    for (const auto& [neighbourId, weight] : it->second) {
       if (id != neighbourId) {
         edges[neighbourId].erase(id);
       }
-
-      weights.erase(MakeEdgeId(id, neighbourId));
     }
 
     edges.erase(id);
@@ -127,8 +212,6 @@ class WeightedGraph {
    * ребра в графе нет, то функция ничего не делает.
    */
   void RemoveEdge(size_t id1, size_t id2) {
-    weights.erase(MakeEdgeId(id1, id2));
-
     if (edges.find(id1) != edges.end())
       edges[id1].erase(id2);
 
@@ -146,8 +229,8 @@ class WeightedGraph {
    * присутствует в графе. Если указанной вершини в графе нет, то функция
    * выбрасывает исключение std::out_of_range.
    */
-  const std::unordered_set<size_t>& Edges(size_t id) const {
-    return edges.at(id);
+  NeighboursRange<NeighboursMap> Edges(size_t id) const {
+    return NeighboursRange<NeighboursMap>(edges.at(id));
   }
 
   /**
@@ -160,7 +243,34 @@ class WeightedGraph {
    * присутствует в графе. Если указанной вершини в графе нет, то функция
    * выбрасывает исключение std::out_of_range.
    */
-  const std::unordered_set<size_t>& IncomingEdges(size_t id) const {
+  NeighboursRange<NeighboursMap> IncomingEdges(size_t id) const {
+    return NeighboursRange<NeighboursMap>(edges.at(id));
+  }
+
+  /**
+   * @brief Получить соседей указанной вершины вместе с весами рёбер.
+   *
+   * @param id Номер вершины.
+   *
+   * Функция возвращает словарь, в котором каждому соседу V вершины id
+   * сопоставлен вес ребра (id, V). Алгоритмам, которым нужны веса всех
+   * рёбер вершины, следует итерироваться по этому словарю вместо вызова
+   * EdgeWeight() для каждого соседа. Если указанной вершини в графе нет,
+   * то функция выбрасывает исключение std::out_of_range.
+   */
+  const NeighboursMap& WeightedEdges(size_t id) const {
+    return edges.at(id);
+  }
+
+  /**
+   * @brief Получить вершины, соединённые ребром с указанной вершиной, вместе
+   *        с весами рёбер.
+   *
+   * @param id Номер вершины.
+   *
+   * Для неориентированного графа функция совпадает с WeightedEdges().
+   */
+  const NeighboursMap& WeightedIncomingEdges(size_t id) const {
     return edges.at(id);
   }
 
@@ -174,7 +284,7 @@ class WeightedGraph {
    * ребра в графе нет, то функция генерирует исключение std::out_of_range.
    */
   const Weight& EdgeWeight(size_t id1, size_t id2) const {
-    return weights.at(MakeEdgeId(id1, id2));
+    return edges.at(id1).at(id2);
   }
 
   /**
@@ -182,13 +292,15 @@ class WeightedGraph {
    *
    * @param id1 Номер первой вершины.
    * @param id2 Номер второй вершины.
+   * @param weight Новый вес ребра.
    *
-   * Функция возвращает ссылку на вес ребра, соединяющего вершины id1 и id2.
-   * Если такого ребра в графе нет, то функция генерирует исключение
-   * std::out_of_range.
+   * Вес ребра хранится в списках смежности обеих вершин, поэтому функция
+   * изменяет обе копии. Если такого ребра в графе нет, то функция генерирует
+   * исключение std::out_of_range.
    */
-  Weight& EdgeWeight(size_t id1, size_t id2) {
-    return weights.at(MakeEdgeId(id1, id2));
+  void SetEdgeWeight(size_t id1, size_t id2, Weight weight) {
+    edges.at(id1).at(id2) = weight;
+    edges.at(id2).at(id1) = weight;
   }
 
   /**
@@ -208,44 +320,16 @@ class WeightedGraph {
     return edges.size();
   }
 
- private:
   /**
-   * @brief Вспомогательная функция для получения идентификатора ребра.
-   *
-   * @param id1 Номер первой вершины.
-   * @param id2 Номер второй вершины.
-   *
-   * Функция возвращает внутренний идентификатор ребра, используемый в классе.
+   * @brief Функция возвращает аллокатор графа.
    */
-  std::pair<size_t, size_t> MakeEdgeId(size_t id1, size_t id2) const {
-    if (id1 < id2)
-      return std::make_pair(id1, id2);
-    else
-      return std::make_pair(id2, id1);
+  allocator_type get_allocator() const {
+    return edges.get_allocator();
   }
 
-  /**
-   * @brief Класс для вычисления хеш кода ребра.
-   */
-  class Hash {
-   public:
-    /**
-     * @brief Функция, вычисляющая хеш код ребра.
-     *
-     * @param id Уникальный идентификатор ребра.
-     */
-    size_t operator()(std::pair<size_t, size_t> id) const noexcept {
-      const size_t prime = 479001599;
-
-      return id.first * prime + id.second;
-    }
-  };
-
-  //! Разреженная матрица связности.
-  std::unordered_map<size_t, std::unordered_set<size_t>> edges;
-
-  //! Словарь весов рёбер.
-  std::unordered_map<std::pair<size_t, size_t>, Weight, Hash> weights;
+ private:
+  //! Разреженная матрица связности. Веса хранятся вместе с соседями.
+  AdjacencyMap edges;
 };
 
 }  // namespace graph
@@ -8,9 +8,10 @@
 #ifndef INCLUDE_WEIGHTED_ORIENTED_GRAPH_HPP_
 #define INCLUDE_WEIGHTED_ORIENTED_GRAPH_HPP_
 
-#include <unordered_map>
-#include <unordered_set>
+#include <tuple>
 #include <utility>
+#include <small_flat_set.hpp>
+#include <edge_groups.hpp>
 #include <iterators.hpp>
 
 namespace graph {
@@ -19,26 +20,66 @@ namespace graph {
  * @brief Взвешенный ориентированный граф.
  *
  * @tparam Weight Тип веса графа.
+ * @tparam Containers Политика контейнеров для списков смежности
+ * (SmallFlatContainers, FlatHashContainers или StdHashContainers).
  */
-template<typename Weight>
+template<typename Weight, typename Containers = SmallFlatContainers<>>
 class WeightedOrientedGraph {
  public:
   //! Тип данных для веса ребра.
   using WeightType = Weight;
 
+  //! Словарь соседей вершины: номер соседа -> вес ребра.
+  using NeighboursMap = typename Containers::template Map<size_t, Weight>;
+
+  //! Множество вершин, из которых входят рёбра.
+  using NeighboursSet = typename Containers::template Set<size_t>;
+
+  //! Словарь смежности: номер вершины -> словарь соседей.
+  using AdjacencyMap = typename Containers::template Map<size_t,
+                                                         NeighboursMap>;
+
+  //! Промежуток вершин графа.
+  using VerticesRange = graph::VerticesRange<AdjacencyMap>;
+
+  //! Тип аллокатора, из памяти которого берутся вершины и рёбра.
+  using allocator_type = typename AdjacencyMap::allocator_type;
+
   /**
    * @brief Конструктор класса WeightedOrientedGraph.
    */
   WeightedOrientedGraph() :
     edges(),
-    incomingEdges(),
-    weights() {
+    incomingEdges() {
+  }
+
+  /**
+   * @brief Конструктор графа, хранящего вершины и рёбра в памяти
+   *        аллокатора.
+   *
+   * @param alloc Аллокатор (например, std::pmr::polymorphic_allocator
+   *        над ареной запроса).
+   */
+  explicit WeightedOrientedGraph(const allocator_type& alloc) :
+    edges(alloc),
+    incomingEdges(alloc) {
   }
 
   /**
-   * @brief Деструктор класса WeightedOrientedGraph.
+   * @brief Конструктор графа по промежутку рёбер.
+   *
+   * @param first Начало промежутка рёбер (троек [откуда, куда, вес]).
+   * @param last Конец промежутка рёбер.
+   * @param alloc Аллокатор.
+   *
+   * Граф заполняется функцией AddEdges().
    */
-  ~WeightedOrientedGraph() {
+  template<typename Iterator>
+  WeightedOrientedGraph(Iterator first, Iterator last,
+                        const allocator_type& alloc = allocator_type()) :
+    edges(alloc),
+    incomingEdges(alloc) {
+    AddEdges(first, last);
   }
 
   /**
@@ -63,12 +104,75 @@ class WeightedOrientedGraph {
    *
    * Функция добавляет ребро с весом weight, выходящее из вершины id1 и входящее
    * в вершину id2 в граф. Если такое ребро в графе уже есть, то функция ничего
-   * не делает.
+   * не делает. Если вершин id1 и id2 в графе нет, то они добавляются.
    */
   void AddEdge(size_t id1, size_t id2, Weight weight) {
-    edges[id1].insert(id2);
+    edges[id1][id2] = weight;
+    edges[id2];
     incomingEdges[id2].insert(id1);
-    weights[std::make_pair(id1, id2)] = weight;
+    incomingEdges[id1];
+  }
+
+  /**
+   * @brief Зарезервировать место под вершины.
+   *
+   * @param numVertices Ожидаемое количество вершин.
+   * @param numEdges Ожидаемое количество рёбер; пока не используется
+   *        (соседи резервируются в AddEdges()).
+   */
+  void Reserve(size_t numVertices, [[maybe_unused]] size_t numEdges) {
+    edges.reserve(numVertices);
+    incomingEdges.reserve(numVertices);
+  }
+
+  /**
+   * @brief Добавить в граф промежуток рёбер.
+   *
+   * @param first Начало промежутка рёбер.
+   * @param last Конец промежутка рёбер.
+   *
+   * Элементы промежутка - тройки [откуда, куда, вес] (например,
+   * std::tuple<size_t, size_t, Weight>). Результат тот же, что у вызовов
+   * AddEdge() для каждого ребра по порядку, но рёбра сначала группируются
+   * по вершинам, и соседи каждой вершины резервируются и добавляются
+   * за один проход.
+   */
+  template<typename Iterator>
+  void AddEdges(Iterator first, Iterator last) {
+    using Arc = std::tuple<size_t, size_t, Weight>;
+    using IncomingArc = std::pair<size_t, size_t>;
+    ArcVector<Arc, allocator_type> outgoing(get_allocator());
+    ArcVector<IncomingArc, allocator_type> incoming(get_allocator());
+
+    ReserveArcs(&outgoing, first, last, 1);
+    ReserveArcs(&incoming, first, last, 1);
+    for (; first != last; ++first) {
+      const auto& [id1, id2, weight] = *first;
+      outgoing.emplace_back(id1, id2, weight);
+      incoming.emplace_back(id2, id1);
+    }
+
+    SortArcsBySource(&outgoing);
+    SortArcsBySource(&incoming);
+
+    // Оба конца каждого ребра становятся вершинами в обоих словарях.
+    AddArcSources(&edges, outgoing);
+    AddArcSources(&edges, incoming);
+    AddArcSources(&incomingEdges, incoming);
+    AddArcSources(&incomingEdges, outgoing);
+
+    ForEachArcGroup(outgoing, [this](size_t source, auto begin, auto end) {
+      NeighboursMap& neighbours = edges[source];
+      neighbours.reserve(neighbours.size() + (end - begin));
+      for (auto it = begin; it != end; ++it)
+        neighbours[std::get<1>(*it)] = std::get<2>(*it);
+    });
+    ForEachArcGroup(incoming, [this](size_t target, auto begin, auto end) {
+      NeighboursSet& neighbours = incomingEdges[target];
+      neighbours.reserve(neighbours.size() + (end - begin));
+      for (auto it = begin; it != end; ++it)
+        neighbours.insert(it->second);
+    });
   }
 
   /**
@@ -113,12 +217,10 @@ class WeightedOrientedGraph {
     auto it = edges.find(id);
 
     if (it != edges.end()) {
-      for (size_t neighbourId : it->second) {
+      for (const auto& [neighbourId, weight] : it->second) {
         if (id != neighbourId) {
           incomingEdges[neighbourId].erase(id);
         }
-
-        weights.erase(std::make_pair(id, neighbourId));
       }
 
       edges.erase(id);
@@ -131,8 +233,6 @@ class WeightedOrientedGraph {
         if (id != neighbourId) {
           edges[neighbourId].erase(id);
         }
-
-        weights.erase(std::make_pair(neighbourId, id));
       }
 
       incomingEdges.erase(id);
@@ -149,8 +249,6 @@ class WeightedOrientedGraph {
    * из графа. Если такого ребра в графе нет, то функция ничего не делает.
    */
   void RemoveEdge(size_t id1, size_t id2) {
-    weights.erase(std::make_pair(id1, id2));
-
     if (edges.find(id1) != edges.end())
       edges[id1].erase(id2);
 
@@ -168,8 +266,8 @@ class WeightedOrientedGraph {
    * присутствует в графе. Если указанной вершини в графе нет, то функция
    * выбрасывает исключение std::out_of_range.
    */
-  const std::unordered_set<size_t>& Edges(size_t id) const {
-    return edges.at(id);
+  NeighboursRange<NeighboursMap> Edges(size_t id) const {
+    return NeighboursRange<NeighboursMap>(edges.at(id));
   }
 
   /**
@@ -182,10 +280,25 @@ class WeightedOrientedGraph {
    * присутствует в графе. Если указанной вершини в графе нет, то функция
    * выбрасывает исключение std::out_of_range.
    */
-  const std::unordered_set<size_t>& IncomingEdges(size_t id) const {
+  const NeighboursSet& IncomingEdges(size_t id) const {
     return incomingEdges.at(id);
   }
 
+  /**
+   * @brief Получить исходящие рёбра указанной вершины вместе с весами.
+   *
+   * @param id Номер вершины.
+   *
+   * Функция возвращает словарь, в котором каждой вершине V, такой что ребро
+   * (id, V) присутствует в графе, сопоставлен вес этого ребра. Алгоритмам,
+   * которым нужны веса всех исходящих рёбер, следует итерироваться по этому
+   * словарю вместо вызова EdgeWeight() для каждого соседа. Если указанной
+   * вершини в графе нет, то функция выбрасывает исключение std::out_of_range.
+   */
+  const NeighboursMap& WeightedEdges(size_t id) const {
+    return edges.at(id);
+  }
+
   /**
    * @brief Получить вес ребра.
    *
@@ -197,7 +310,7 @@ class WeightedOrientedGraph {
    * исключение std::out_of_range.
    */
   const Weight& EdgeWeight(size_t id1, size_t id2) const {
-    return weights.at(std::make_pair(id1, id2));
+    return edges.at(id1).at(id2);
   }
 
   /**
@@ -211,7 +324,21 @@ class WeightedOrientedGraph {
    * std::out_of_range.
    */
   Weight& EdgeWeight(size_t id1, size_t id2) {
-    return weights.at(std::make_pair(id1, id2));
+    return edges.at(id1).at(id2);
+  }
+
+  /**
+   * @brief Изменить вес ребра.
+   *
+   * @param id1 Номер вершины, из которой выходит ребро.
+   * @param id2 Номер вершины, в которую входит ребро.
+   * @param weight Новый вес ребра.
+   *
+   * Если такого ребра в графе нет, то функция генерирует исключение
+   * std::out_of_range.
+   */
+  void SetEdgeWeight(size_t id1, size_t id2, Weight weight) {
+    edges.at(id1).at(id2) = weight;
   }
 
   /**
@@ -231,32 +358,20 @@ class WeightedOrientedGraph {
     return edges.size();
   }
 
- private:
   /**
-   * @brief Класс для вычисления хеш кода ребра.
+   * @brief Функция возвращает аллокатор графа.
    */
-  class Hash {
-    /**
-     * @brief Функция, вычисляющая хеш код ребра.
-     *
-     * @param id Уникальный идентификатор ребра.
-     */
-   public:
-    size_t operator()(std::pair<size_t, size_t> id) const noexcept {
-      const size_t prime = 479001599;
-
-      return id.first * prime + id.second;
-    }
-  };
+  allocator_type get_allocator() const {
+    return edges.get_allocator();
+  }
 
-  //! Разреженная матрица связности. Словарь исходящих рёбер.
-  std::unordered_map<size_t, std::unordered_set<size_t>> edges;
+ private:
+  //! Разреженная матрица связности. Словарь исходящих рёбер вместе
+  //! с их весами.
+  AdjacencyMap edges;
 
   //! Разреженная матрица связности. Словарь входящих рёбер.
-  std::unordered_map<size_t, std::unordered_set<size_t>> incomingEdges;
-
-  //! Словарь весов рёбер.
-  std::unordered_map<std::pair<size_t, size_t>, Weight, Hash> weights;
+  typename Containers::template Map<size_t, NeighboursSet> incomingEdges;
 };
 
 }  // namespace graph
@@ -0,0 +1,160 @@
+/**
+ * @file methods/batch.hpp
+ *
+ * Пакетные запросы: много запросов к методам в одном HTTP запросе.
+ * Тело запроса - массив объектов {"method": "/CutPoints", "input": {...}},
+ * ответ - массив объектов {"status": 200, "output": {...}} в том же
+ * порядке. Запросы пакета выполняются параллельно в общем пуле потоков
+ * и подчиняются тем же ограничениям на число одновременных запросов
+ * к методу, что и отдельные запросы (см. ConcurrencyLimiter), но вместо
+ * отказа ждут освободившегося места.
+ */
+
+#ifndef METHODS_BATCH_HPP_
+#define METHODS_BATCH_HPP_
+
+#include <cstddef>
+#include <exception>
+#include <map>
+#include <string>
+#include <utility>
+#include <nlohmann/json.hpp>
+#include "graph_request.hpp"
+#include "graph_store.hpp"
+#include "parallel.hpp"
+#include "result_cache.hpp"
+#include "server.hpp"
+
+namespace graph {
+
+/**
+ * @brief Метод сервера.
+ */
+struct GraphMethod {
+  //! Функция, выполняющая метод (см. methods.hpp).
+  int (*run)(const GraphRequest&, nlohmann::json*);
+  //! От чего зависит результат метода.
+  ResultDependency dependency;
+};
+
+//! Методы по адресам ("/CutPoints" и т.д.).
+using GraphMethods = std::map<std::string, GraphMethod>;
+
+/**
+ * @brief Выполнить один запрос пакета.
+ *
+ * @param item Запрос {"method": адрес метода, "input": входные данные}.
+ * @param methods Методы.
+ * @param store Хранилище загруженных графов.
+ * @param cache Кэш результатов.
+ * @param limiter Ограничения на число одновременных запросов к методам
+ *        (nullptr - без ограничений).
+ * @param result Результат {"status": код, "output": выходные данные}.
+ *
+ * Коды те же, что и у отдельного запроса к методу: 200 в случае успеха,
+ * 400, если входные данные заданы некорректно, 404, если метода нет,
+ * и 500, если метод выбросил исключение. Если к методу уже выполняется
+ * максимальное число запросов, то запрос ждёт места (см.
+ * ConcurrencyLimiter::Wait()); 503 он получает, только если ограничение
+ * метода равно 0.
+ */
+inline void RunBatchItem(const nlohmann::json& item,
+                         const GraphMethods& methods, GraphStore* store,
+                         ResultCache* cache,
+                         const ConcurrencyLimiter* limiter,
+                         nlohmann::json* result) {
+  (*result)["status"] = 400;
+
+  if (!item.is_object() || !item.contains("method") ||
+      !item.contains("input") || !item.at("method").is_string())
+    return;
+
+  // Адрес метода можно писать и без "/".
+  std::string endpoint = item.at("method");
+  if (endpoint.empty() || endpoint[0] != '/')
+    endpoint = "/" + endpoint;
+
+  auto method = methods.find(endpoint);
+  if (method == methods.end()) {
+    (*result)["status"] = 404;
+    return;
+  }
+
+  // Место занято до конца выполнения метода.
+  ConcurrencyLimiter::Slot slot;
+  if (limiter) {
+    slot = limiter->Wait(endpoint);
+    if (!slot) {
+      (*result)["status"] = 503;
+      return;
+    }
+  }
+
+  nlohmann::json output;
+
+  try {
+    // Входные данные читаются так же, как тело отдельного запроса.
+    GraphRequest input;
+    if (ReadGraphRequest(item.at("input").dump(), &input) == 0 &&
+        ResolveGraphRequest(store, &input) == 0 &&
+        RunGraphMethod(method->second.run, endpoint,
+                       method->second.dependency, &input, cache,
+                       &output) == 0)
+      (*result)["status"] = 200;
+  } catch (const std::exception&) {
+    (*result)["status"] = 500;
+    return;
+  }
+
+  (*result)["output"] = std::move(output);
+}
+
+/**
+ * @brief Выполнить пакет запросов.
+ *
+ * @param body Текст запроса (массив запросов в формате JSON).
+ * @param methods Методы.
+ * @param store Хранилище загруженных графов.
+ * @param cache Кэш результатов.
+ * @param limiter Ограничения на число одновременных запросов к методам
+ *        (nullptr - без ограничений).
+ * @param pool Пул потоков (nullptr - только вызывающий поток).
+ * @param output Массив результатов (см. RunBatchItem()).
+ * @return Функция возвращает 0 в случае успеха и -1, если тело запроса
+ * не является массивом JSON. Ошибки отдельных запросов попадают
+ * в их результаты и не прерывают пакет.
+ *
+ * Запросы делятся между потоками пула поровну; пакеты обычно состоят
+ * из многих маленьких графов, поэтому каждый поток получает хотя бы
+ * несколько запросов. Один пул используется всеми пакетными запросами,
+ * поэтому потоки не создаются при каждом запросе.
+ */
+inline int RunBatch(const std::string& body, const GraphMethods& methods,
+                    GraphStore* store, ResultCache* cache,
+                    const ConcurrencyLimiter* limiter, ThreadPool* pool,
+                    nlohmann::json* output) {
+  const nlohmann::json items = nlohmann::json::parse(body, nullptr, false);
+  if (!items.is_array())
+    return -1;
+
+  // Каждый поток пишет только в свои элементы массива.
+  *output = nlohmann::json::array();
+  for (size_t i = 0; i < items.size(); i++)
+    output->push_back(nlohmann::json::object());
+
+  auto run = [&](size_t, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++)
+      RunBatchItem(items[i], methods, store, cache, limiter, &(*output)[i]);
+  };
+
+  if (pool)
+    pool->ParallelFor(items.size(), run, 4);
+  else
+    run(0, 0, items.size());
+
+  return 0;
+}
+
+}  // namespace graph
+
+#endif  // METHODS_BATCH_HPP_
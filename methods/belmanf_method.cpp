@@ -4,20 +4,23 @@
 #include <nlohmann/json.hpp>
 #include "iterators.hpp"
 #include "belmanf.hpp"
+#include "csr_graph.hpp"
+#include "dijkstra.hpp"
+#include "graph_store.hpp"
 namespace graph {
 
 template<typename T>
-static int BelmanfMethodHelper(const nlohmann::json& input,
+static int BelmanfMethodHelper(const GraphRequest& input,
 nlohmann::json* output, std::string type);
 
-int BelmanfMethod(const nlohmann::json& input, nlohmann::json* output) {
+int BelmanfMethod(const GraphRequest& input, nlohmann::json* output) {
 /*
 С классом nlohmann::json можно работать как со словарём.
 Метод at() в отличие оператора [] не меняет объект, поэтому
 этот метод можно использовать с константными объектами.
 */
 
-  std::string type = input.at("type");
+  std::string type = input.fields.at("type");
 
   /* Пока реализована только поддержка целых чисел и чисел типа double. */
   if (type == "int") {
@@ -49,21 +52,27 @@ int BelmanfMethod(const nlohmann::json& input, nlohmann::json* output) {
 * используется для сокращения кода, необходимого для поддержки различных типов данных.
 */
 template<typename T>
-static int BelmanfMethodHelper(const nlohmann::json& input,
+static int BelmanfMethodHelper(const GraphRequest& input,
 nlohmann::json* output, std::string type) {
-  (*output)["id"] = input.at("id");
+  (*output)["id"] = input.fields.at("id");
   (*output)["type"] = type;
 
-  size_t size = input.at("size").at(0);
-  size_t n = input.at("size").at(1);
-  size_t v = input.at("size").at(2);
-  std::vector<int> data(size*3);
+  size_t size = input.fields.at("size").at(0);
+  size_t n = input.fields.at("size").at(1);
+  size_t v = input.fields.at("size").at(2);
+
+  /*
+  Поле "algorithm" необязательное: "dijkstra", "spfa" или "bellman_ford".
+  Если оно не задано, то для графов без отрицательных весов выбирается
+  алгоритм Дейкстры, а для остальных - SPFA.
+  */
+  std::string algorithm;
+  if (input.fields.contains("algorithm"))
+    algorithm = input.fields.at("algorithm");
+  if (!algorithm.empty() && algorithm != "dijkstra" && algorithm != "spfa" &&
+      algorithm != "bellman_ford")
+    return -1;
 
-  for (size_t i = 0; i < size*3; i++) {
-  /* Для словарей используется индекс в виде строки,
-  а для массивов просто целое число типа size_t. */
-    data[i] = input.at("data").at(i);
-  }
   if (n == 0) {
     (*output)["size"] = 0;
     (*output)["data"] = "empty graph";
@@ -75,34 +84,68 @@ nlohmann::json* output, std::string type) {
       return 0;
   }
 
+/* Данные заданы тройками (вес, откуда, куда), которые уже прочитаны
+  из запроса в плоские векторы (или граф загружен заранее). CSR граф
+  строится из них сразу, несколькими потоками (их количество можно
+  задать полем "threads"). */
+  CsrGraph<T> csr;
+  if (GetCsrGraph<WeightedOrientedGraph<T>>(input, 0, size, &csr) < 0)
+    return -1;
+
+  const GraphRequest& source = input.stored ? input.stored->Request() : input;
+  bool hasNegative = false;
+  for (size_t k = 0; k < size; k++)
+    hasNegative = hasNegative || source.EdgeWeight<T>(k) < T();
+
+  if (algorithm.empty())
+    algorithm = hasNegative ? "spfa" : "dijkstra";
+  if (algorithm == "dijkstra" && hasNegative)
+    return -1;
+
 /* Здесь вызывается сам алгоритм Беллмана-Форда. */
-  WeightedOrientedGraph<int> wog;
-  for (size_t k = 0; k < size; k++) {
-      wog.AddEdge(static_cast<size_t>(data[k*3 + 1]),
-                  static_cast<size_t>(data[k*3 + 2]), data[k*3]);
-    }
-  std::unordered_map<size_t , std::pair<bool, int>> res = Belmanf(wog, v);
+  ShortestPaths<T> paths;
+  const bool hasSource = csr.HasVertex(v);
+
+  if (hasSource) {
+    if (algorithm == "dijkstra")
+      Dijkstra(csr, csr.Index(v), &paths);
+    else if (algorithm == "bellman_ford")
+      BellmanFord(csr, csr.Index(v), &paths);
+    else
+      Spfa(csr, csr.Index(v), &paths);
+  }
 
 /* Сохраняем в ответе результат работы алгоритма. */
   (*output)["size"] = n;
+  (*output)["algorithm"] = algorithm;
+
+  if (paths.negativeCycle) {
+    (*output)["data"] = "negative cycle";
+    return 0;
+  }
+
   size_t j = 0;
-  for (auto it = res.begin(); it != res.end(); it++) {  // выводим их
-    if ((it->second).first == 1) {
-      size_t tmp1 = it->first;
-      int tmp2 = (it->second).second;
-      std::string s2 = std::to_string(tmp2);
-      (*output)["data"][j][0] = tmp1;
-      (*output)["data"][j][1] = s2;
-    } else {
-      size_t tmp1 = it->first;
-      (*output)["data"][j][0] = tmp1;
+  size_t k = 0;
+  for (size_t i = 0; i < csr.NumVertices(); i++) {  // выводим их
+    (*output)["data"][j][0] = csr.Id(i);
+    if (hasSource && paths.reached[i])
+      (*output)["data"][j][1] = nlohmann::json(paths.distance[i]).dump();
+    else
       (*output)["data"][j][1] = "no";
-    }
     j++;
+
+    if (hasSource && paths.parent[i] != VertexIndex::npos) {
+      (*output)["parents"][k][0] = csr.Id(i);
+      (*output)["parents"][k][1] = csr.Id(paths.parent[i]);
+      k++;
+    }
+  }
+  if (!hasSource) {
+    (*output)["data"][j][0] = v;
+    (*output)["data"][j][1] = "0";
   }
 
   return 0;
 }
 
 }   // namespace graph
-
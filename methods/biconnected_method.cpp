@@ -0,0 +1,120 @@
+/**
+ * @file methods/biconnected_method.cpp
+ *
+ * Реализация серверной части метода поиска компонент двусвязности.
+ */
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "biconnected.hpp"
+#include "graph.hpp"
+#include "graph_store.hpp"
+
+namespace graph {
+
+/**
+ * @brief Функция-помощник.
+ *
+ * @param input входной json-файл.
+ * @param output выходной json-файл.
+ * @param type тип графа.
+ */
+template<class T>
+static int BiconnectedMethodHelper(const GraphRequest& input,
+                                   nlohmann::json* output,
+                                   std::string type);
+
+int BiconnectedMethod(const GraphRequest& input, nlohmann::json* output) {
+  std::string type = input.fields.at("type");
+
+  /* Пока реализована только поддержка обычных графов */
+  if (type == "graph") {
+    return BiconnectedMethodHelper<Graph>(input, output, type);
+  }
+  return -1;
+}
+
+/**
+ * @brief Записать список компонент в JSON.
+ *
+ * @param components Компоненты.
+ */
+static nlohmann::json ComponentsToJson(
+    const std::vector<std::vector<size_t>>& components) {
+  nlohmann::json result = nlohmann::json::array();
+
+  for (const std::vector<size_t>& component : components)
+    result.push_back(component);
+
+  return result;
+}
+
+/**
+ * @brief Метод поиска компонент двусвязности.
+ *
+ * @tparam T Тип графа.
+ *
+ * @param input Входные данные в формате JSON.
+ * @param output Выходные данные в формате JSON.
+ * @param type Строковое представление типа графа.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Формат графа такой же, как у метода /CutPoints. Необязательное поле
+ * "outputs" - список из "cut_points", "bridges", "two_edge_components"
+ * и "blocks" - задаёт, какие результаты нужно вернуть (по умолчанию все).
+ * Все результаты вычисляются за один обход графа.
+ */
+template<class T>
+static int BiconnectedMethodHelper(const GraphRequest& input,
+                                   nlohmann::json* output,
+                                   std::string type) {
+  unsigned outputs = kAllBiconnectedOutputs;
+  if (input.fields.contains("outputs")) {
+    outputs = 0;
+    for (const std::string name : input.fields.at("outputs")) {
+      if (name == "cut_points")
+        outputs |= kCutPoints;
+      else if (name == "bridges")
+        outputs |= kBridges;
+      else if (name == "two_edge_components")
+        outputs |= kTwoEdgeComponents;
+      else if (name == "blocks")
+        outputs |= kBlocks;
+      else
+        return -1;
+    }
+  }
+
+  (*output)["id"] = input.fields.at("id");
+  (*output)["type"] = type;
+  size_t size = input.fields.at("size");
+  size_t numEdges = input.fields.at("numEdges");
+  T local(GraphAllocator<T>(input));
+  const T* graph;
+  if (GetGraph(input, size, numEdges, &local, &graph) < 0)
+    return -1;
+
+  /* Здесь вызывается сам алгоритм. */
+  BiconnectedComponents result;
+  Biconnected(*graph, outputs, &result);
+
+  /* Сохраняем в ответе результат работы алгоритма. */
+  (*output)["size"] = size;
+  if (outputs & kCutPoints)
+    (*output)["cut_points"] = result.cutPoints;
+  if (outputs & kBridges) {
+    (*output)["bridges"] = nlohmann::json::array();
+    for (const auto& [a, b] : result.bridges)
+      (*output)["bridges"].push_back({a, b});
+  }
+  if (outputs & kTwoEdgeComponents)
+    (*output)["two_edge_components"] =
+        ComponentsToJson(result.twoEdgeComponents);
+  if (outputs & kBlocks)
+    (*output)["blocks"] = ComponentsToJson(result.blocks);
+
+  return 0;
+}
+
+}  // namespace graph
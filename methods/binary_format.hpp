@@ -0,0 +1,376 @@
+/**
+ * @file methods/binary_format.hpp
+ *
+ * Компактный бинарный формат запросов и ответов сервера. Сообщение
+ * в этом формате содержит те же данные, что и сообщение в JSON, но массивы
+ * вершин и рёбер хранятся в упакованном виде. Все числа записываются
+ * в порядке little-endian.
+ *
+ * Смещение | Размер | Содержимое
+ * -------- | ------ | ----------
+ * 0        | 4      | "GRPH"
+ * 4        | 1      | версия формата (1)
+ * 5        | 1      | тип весов (PackedWeightType)
+ * 6        | 2      | флаги (BinaryGraphFlags)
+ * 8        | 4      | F - размер остальных полей
+ * 12       | 4      | 0
+ * 16       | 8      | N - количество вершин
+ * 24       | 8      | M - количество рёбер
+ * 32       | F      | остальные поля сообщения (объект JSON в виде текста)
+ * ...      | ...    | нули до границы 8 байт
+ * ...      | 8N     | номера вершин (uint64)
+ * ...      | 16M    | рёбра: пары (откуда, куда) (uint64)
+ * ...      | W * M  | веса рёбер (W - размер типа весов, 0 без весов)
+ */
+
+#ifndef METHODS_BINARY_FORMAT_HPP_
+#define METHODS_BINARY_FORMAT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "graph_request.hpp"
+
+namespace graph {
+
+//! MIME тип бинарного формата.
+constexpr char kBinaryGraphContentType[] = "application/x-graph";
+
+//! Размер заголовка бинарного сообщения.
+constexpr size_t kBinaryGraphHeaderSize = 32;
+
+/**
+ * @brief Флаги бинарного сообщения.
+ */
+enum BinaryGraphFlags : uint16_t {
+  //! Сообщение содержит массив "vertices".
+  kHasVertices = 1,
+  //! Сообщение содержит массив рёбер.
+  kHasEdges = 2,
+  //! Рёбра записаны в поле "data" тройками (вес, откуда, куда), а не
+  //! в поле "edges".
+  kDataTriples = 4
+};
+
+/**
+ * @brief Размер одного веса в байтах.
+ *
+ * @param type Тип весов.
+ */
+inline size_t PackedWeightSize(PackedWeightType type) {
+  switch (type) {
+    case kInt32Weights:
+    case kFloat32Weights:
+      return 4;
+    case kInt64Weights:
+    case kFloat64Weights:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+/**
+ * @brief Дописать беззнаковое целое в порядке little-endian.
+ *
+ * @tparam T Беззнаковый целый тип.
+ *
+ * @param value Значение.
+ * @param out Строка, в конец которой записывается значение.
+ */
+template<typename T>
+void StoreLittleEndian(T value, std::string* out) {
+  for (size_t i = 0; i < sizeof(T); i++)
+    out->push_back(static_cast<char>((value >> (8 * i)) & 0xff));
+}
+
+/**
+ * @brief Прочитать сообщение в бинарном формате.
+ *
+ * @param body Тело сообщения.
+ * @param request Результат.
+ * @return Функция возвращает 0 в случае успеха и -1, если сообщение
+ * задано некорректно.
+ *
+ * Массивы вершин и рёбер не копируются: request ссылается на body,
+ * поэтому body должно существовать, пока используется request.
+ */
+inline int ReadBinaryGraphRequest(const std::string& body,
+                                  GraphRequest* request) {
+  *request = GraphRequest();
+
+  const unsigned char* data =
+      reinterpret_cast<const unsigned char*>(body.data());
+  const size_t size = body.size();
+
+  if (size < kBinaryGraphHeaderSize || body.compare(0, 4, "GRPH") != 0 ||
+      data[4] != 1)
+    return -1;
+
+  const PackedWeightType weightType = static_cast<PackedWeightType>(data[5]);
+  const uint16_t flags = LoadLittleEndian<uint16_t>(data + 6);
+  const size_t fieldsSize = LoadLittleEndian<uint32_t>(data + 8);
+  const uint64_t numVertices = LoadLittleEndian<uint64_t>(data + 16);
+  const uint64_t numEdges = LoadLittleEndian<uint64_t>(data + 24);
+  const size_t weightSize = PackedWeightSize(weightType);
+
+  if (weightType > kFloat64Weights || flags > 7)
+    return -1;
+
+  // Проверяем размеры так, чтобы произведения не переполнились.
+  const size_t arrays = kBinaryGraphHeaderSize + (fieldsSize + 7) / 8 * 8;
+  if (arrays > size || numVertices > (size - arrays) / 8)
+    return -1;
+  const size_t edges = arrays + 8 * numVertices;
+  if (numEdges > (size - edges) / (16 + weightSize) ||
+      edges + (16 + weightSize) * numEdges != size)
+    return -1;
+
+  request->fields = nlohmann::json::parse(
+      body.begin() + kBinaryGraphHeaderSize,
+      body.begin() + kBinaryGraphHeaderSize + fieldsSize, nullptr, false);
+  if (!request->fields.is_object())
+    return -1;
+
+  request->packed = data + arrays;
+  request->packedVertices = numVertices;
+  request->packedEdges = numEdges;
+  request->packedWeights = weightType;
+
+  return 0;
+}
+
+/**
+ * @brief Проверить, является ли значение JSON номером вершины.
+ *
+ * @param value Значение.
+ * @param id Номер вершины.
+ */
+inline bool JsonVertexId(const nlohmann::json& value, uint64_t* id) {
+  if (value.is_number_unsigned()) {
+    *id = value.get<uint64_t>();
+    return true;
+  }
+
+  if (value.is_number_integer() && value.get<int64_t>() >= 0) {
+    *id = static_cast<uint64_t>(value.get<int64_t>());
+    return true;
+  }
+
+  return false;
+}
+
+/**
+ * @brief Записать сообщение в бинарном формате.
+ *
+ * @param message Сообщение в формате JSON (объект).
+ * @param body Результат.
+ * @return Функция возвращает 0 в случае успеха и -1, если сообщение не
+ * является объектом JSON.
+ *
+ * Упаковываются массив "vertices" и рёбра из массива "edges" (или, если его
+ * нет, тройки из массива "data"), если они состоят из неотрицательных
+ * целых номеров вершин и числовых весов. Целые веса записываются как int32
+ * или int64, остальные - как double. Все прочие поля (и массивы, которые
+ * нельзя упаковать) сохраняются как текст JSON, поэтому функция
+ * DecodeBinaryGraph() восстанавливает исходное сообщение.
+ */
+inline int EncodeBinaryGraph(const nlohmann::json& message,
+                             std::string* body) {
+  if (!message.is_object())
+    return -1;
+
+  nlohmann::json fields = message;
+  std::vector<uint64_t> vertices, edges;
+  std::vector<const nlohmann::json*> weights;
+  uint16_t flags = 0;
+
+  auto vertexList = message.find("vertices");
+  if (vertexList != message.end() && vertexList->is_array()) {
+    uint64_t id;
+    bool ok = true;
+    for (const nlohmann::json& value : *vertexList) {
+      if (!(ok = JsonVertexId(value, &id)))
+        break;
+      vertices.push_back(id);
+    }
+
+    if (ok) {
+      flags |= kHasVertices;
+      fields.erase("vertices");
+    } else {
+      vertices.clear();
+    }
+  }
+
+  // Упаковать массив рёбер. Функция возвращает false, если это невозможно.
+  auto packEdges = [&](const nlohmann::json& list, bool triples) {
+    uint64_t a, b;
+    size_t arity = 0;
+
+    if (triples) {
+      if (list.size() % 3 != 0)
+        return false;
+      for (size_t i = 0; i < list.size(); i += 3) {
+        if (!list[i].is_number() || !JsonVertexId(list[i + 1], &a) ||
+            !JsonVertexId(list[i + 2], &b))
+          return false;
+        edges.push_back(a);
+        edges.push_back(b);
+        weights.push_back(&list[i]);
+      }
+      return true;
+    }
+
+    for (const nlohmann::json& edge : list) {
+      if (!edge.is_array() || edge.size() < 2 || edge.size() > 3 ||
+          (arity != 0 && edge.size() != arity) ||
+          !JsonVertexId(edge[0], &a) || !JsonVertexId(edge[1], &b) ||
+          (edge.size() == 3 && !edge[2].is_number()))
+        return false;
+      arity = edge.size();
+      edges.push_back(a);
+      edges.push_back(b);
+      if (arity == 3)
+        weights.push_back(&edge[2]);
+    }
+    return true;
+  };
+
+  for (const char* name : {"edges", "data"}) {
+    auto list = message.find(name);
+    if (list == message.end() || !list->is_array())
+      continue;
+
+    const bool triples = std::string(name) == "data";
+    if (packEdges(*list, triples)) {
+      flags |= kHasEdges | (triples ? kDataTriples : 0);
+      fields.erase(name);
+      break;
+    }
+    edges.clear();
+    weights.clear();
+  }
+
+  // Выбираем самый компактный тип весов, который сохраняет значения.
+  PackedWeightType weightType = weights.empty() ? kNoWeights : kInt32Weights;
+  for (const nlohmann::json* weight : weights) {
+    if (weight->is_number_float() ||
+        (weight->is_number_unsigned() &&
+         weight->get<uint64_t>() >
+             static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))) {
+      weightType = kFloat64Weights;
+      break;
+    }
+
+    const int64_t value = weight->get<int64_t>();
+    if (value < std::numeric_limits<int32_t>::min() ||
+        value > std::numeric_limits<int32_t>::max())
+      weightType = kInt64Weights;
+  }
+
+  const std::string text = fields.dump();
+  const size_t numEdges = edges.size() / 2;
+
+  body->clear();
+  body->reserve(kBinaryGraphHeaderSize + text.size() + 8 +
+                8 * (vertices.size() + edges.size()) +
+                PackedWeightSize(weightType) * numEdges);
+
+  body->append("GRPH");
+  body->push_back(1);
+  body->push_back(static_cast<char>(weightType));
+  StoreLittleEndian<uint16_t>(flags, body);
+  StoreLittleEndian<uint32_t>(static_cast<uint32_t>(text.size()), body);
+  StoreLittleEndian<uint32_t>(0, body);
+  StoreLittleEndian<uint64_t>(vertices.size(), body);
+  StoreLittleEndian<uint64_t>(numEdges, body);
+  body->append(text);
+  body->append((8 - text.size() % 8) % 8, '\0');
+
+  for (uint64_t id : vertices)
+    StoreLittleEndian<uint64_t>(id, body);
+  for (uint64_t id : edges)
+    StoreLittleEndian<uint64_t>(id, body);
+
+  for (const nlohmann::json* weight : weights) {
+    if (weightType == kInt32Weights) {
+      StoreLittleEndian<uint32_t>(
+          static_cast<uint32_t>(weight->get<int32_t>()), body);
+    } else if (weightType == kInt64Weights) {
+      StoreLittleEndian<uint64_t>(
+          static_cast<uint64_t>(weight->get<int64_t>()), body);
+    } else {
+      const double value = weight->get<double>();
+      uint64_t bits;
+      std::memcpy(&bits, &value, sizeof(bits));
+      StoreLittleEndian<uint64_t>(bits, body);
+    }
+  }
+
+  return 0;
+}
+
+/**
+ * @brief Преобразовать сообщение в бинарном формате в JSON.
+ *
+ * @param body Тело сообщения.
+ * @param message Результат.
+ * @return Функция возвращает 0 в случае успеха и -1, если сообщение
+ * задано некорректно.
+ */
+inline int DecodeBinaryGraph(const std::string& body,
+                             nlohmann::json* message) {
+  GraphRequest request;
+
+  if (ReadBinaryGraphRequest(body, &request) < 0)
+    return -1;
+
+  const uint16_t flags = LoadLittleEndian<uint16_t>(
+      reinterpret_cast<const unsigned char*>(body.data()) + 6);
+  const bool integer = request.packedWeights == kInt32Weights ||
+                       request.packedWeights == kInt64Weights;
+
+  *message = std::move(request.fields);
+
+  // Вес ребра в виде JSON.
+  auto weight = [&](size_t i) {
+    return integer ? nlohmann::json(request.EdgeWeight<int64_t>(i))
+                   : nlohmann::json(request.EdgeWeight<double>(i));
+  };
+
+  if (flags & kHasVertices) {
+    nlohmann::json& vertices = (*message)["vertices"];
+    vertices = nlohmann::json::array();
+    for (size_t i = 0; i < request.NumVertices(); i++)
+      vertices.push_back(request.Vertex(i));
+  }
+
+  if (flags & kDataTriples) {
+    nlohmann::json& data = (*message)["data"];
+    data = nlohmann::json::array();
+    for (size_t i = 0; i < request.NumEdges(); i++) {
+      data.push_back(weight(i));
+      data.push_back(request.EdgeSource(i));
+      data.push_back(request.EdgeTarget(i));
+    }
+  } else if (flags & kHasEdges) {
+    nlohmann::json& edges = (*message)["edges"];
+    edges = nlohmann::json::array();
+    for (size_t i = 0; i < request.NumEdges(); i++) {
+      edges.push_back({request.EdgeSource(i), request.EdgeTarget(i)});
+      if (request.HasWeights())
+        edges.back().push_back(weight(i));
+    }
+  }
+
+  return 0;
+}
+
+}  // namespace graph
+
+#endif  // METHODS_BINARY_FORMAT_HPP_
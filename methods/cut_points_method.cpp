@@ -10,6 +10,7 @@
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include "cut_points.hpp"
+#include "graph_store.hpp"
 
 namespace graph {
 /**
@@ -20,17 +21,17 @@ namespace graph {
  * @param type тип графа.
  */
 template<class T>
-static int CutPointsMethodHelper(const nlohmann::json& input,
+static int CutPointsMethodHelper(const GraphRequest& input,
                                  nlohmann::json* output,
                                  std::string type);
 
-int CutPointsMethod(const nlohmann::json& input, nlohmann::json* output) {
+int CutPointsMethod(const GraphRequest& input, nlohmann::json* output) {
   /*
   С классом nlohmann::json можно работать как со словарём.
   Метод at() в отличие оператора [] не меняет объект, поэтому
   этот метод можно использовать с константными объектами.
   */
-  std::string type = input.at("type");
+  std::string type = input.fields.at("type");
   if (type == "graph") {
     return CutPointsMethodHelper<Graph>(input, output, type);
 }
@@ -52,27 +53,22 @@ int CutPointsMethod(const nlohmann::json& input, nlohmann::json* output) {
  * используется для сокращения кода, необходимого для поддержки различных типов данных.
  */
 template<class T>
-static int CutPointsMethodHelper(const nlohmann::json& input,
+static int CutPointsMethodHelper(const GraphRequest& input,
                                      nlohmann::json* output,
                                      std::string type) {
-  (*output)["id"] = input.at("id");
+  (*output)["id"] = input.fields.at("id");
   (*output)["type"] = type;
-  size_t size = input.at("size");
-  size_t numEdges = input.at("numEdges");
-  T graph;
-  for (size_t i = 0; i < size; i++) {
-    /* Для словарей используется индекс в виде строки,
-    а для массивов просто целое число типа size_t. */
-    graph.AddVertex(input.at("vertices").at(i));
-  }
-  for (size_t i = 0; i < numEdges; i++) {
-    /* Для словарей используется индекс в виде строки,
-    а для массивов просто целое число типа size_t. */
-    graph.AddEdge(input.at("edges").at(i).at(0), input.at("edges").at(i).at(1));
-  }
+  size_t size = input.fields.at("size");
+  size_t numEdges = input.fields.at("numEdges");
+  T local(GraphAllocator<T>(input));
+  const T* graph;
+  /* Вершины и рёбра уже прочитаны из запроса в плоские векторы
+  (или граф уже построен, если он загружен заранее). */
+  if (GetGraph(input, size, numEdges, &local, &graph) < 0)
+    return -1;
 
   std::vector<size_t> result;
-  CutPoints(graph, &result);
+  CutPoints(*graph, &result);
   /* Сохраняем в ответе результат работы алгоритма. */
   (*output)["size"] = size;
   for (size_t i = 0; i < result.size(); i++) {
@@ -8,6 +8,8 @@
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include "dinic.hpp"
+#include "push_relabel.hpp"
+#include "graph_store.hpp"
 
 namespace graph {
 /**
@@ -19,22 +21,56 @@ namespace graph {
  * @param type тип графа.
  */
 template<class T>
-static int DinicMethodHelper(const nlohmann::json& input,
+static int DinicMethodHelper(const GraphRequest& input,
                                      nlohmann::json* output,
-                                     std::string type);
+                                     std::string type,
+                                     std::string algorithm);
 
-int DinicMethod(const nlohmann::json& input, nlohmann::json* output) {
-  std::string type = input.at("type");
+/**
+ * @brief Функция проверяет, является ли сеть плотной.
+ *
+ * @param size Количество вершин.
+ * @param numEdges Количество рёбер.
+ *
+ * На сетях, в которых рёбер не меньше четверти от n(n - 1), количество фаз
+ * алгоритма Диница растёт быстро, и проталкивание предпотока работает
+ * быстрее.
+ */
+static bool IsDenseFlowNetwork(size_t size, size_t numEdges) {
+  return size > 1 && 4 * numEdges >= size * (size - 1);
+}
+
+int DinicMethod(const GraphRequest& input, nlohmann::json* output) {
+  std::string type = input.fields.at("type");
   /*
   С классом nlohmann::json можно работать как со словарём.
   Метод at() в отличие оператора [] не меняет объект, поэтому
   этот метод можно использовать с константными объектами.
   */
 
-  if (type == "weighted_oriented_graph")
-    return graph::DinicMethodHelper
-      <graph::WeightedOrientedGraph<int>>(input, output, type);
-  return -1;
+  if (type != "weighted_oriented_graph")
+    return -1;
+
+  /*
+  Поле "algorithm" необязательное: "dinic" или "push_relabel". По умолчанию
+  для плотных графов выбирается проталкивание предпотока, а для
+  разреженных - алгоритм Диница.
+  */
+  std::string algorithm;
+  if (input.fields.contains("algorithm")) {
+    algorithm = input.fields.at("algorithm");
+  } else {
+    const size_t size = input.fields.at("size");
+    const size_t numEdges = input.fields.at("numEdges");
+
+    algorithm = IsDenseFlowNetwork(size, numEdges) ? "push_relabel" : "dinic";
+  }
+
+  if (algorithm != "dinic" && algorithm != "push_relabel")
+    return -1;
+
+  return graph::DinicMethodHelper
+      <graph::WeightedOrientedGraph<int>>(input, output, type, algorithm);
 }
 
 /**
@@ -45,44 +81,39 @@ int DinicMethod(const nlohmann::json& input, nlohmann::json* output) {
  * @param input Входные данные в формате JSON.
  * @param output Выходные данные в формате JSON.
  * @param type Строковое представление типа данных мортируемых элементов.
+ * @param algorithm Алгоритм поиска потока: "dinic" или "push_relabel".
  *
  * Функция запускает алгоритм поиска мостов, используя входные данные
  * в JSON формате. Результат также выдаётся в JSON формате. Функция
  * используется для сокращения кода, необходимого для поддержки различных типов данных.
  */
 template<class T>
-static int DinicMethodHelper(const nlohmann::json& input,
+static int DinicMethodHelper(const GraphRequest& input,
                                      nlohmann::json* output,
-                                     std::string type) {
-  (*output)["id"] = input.at("id");
+                                     std::string type,
+                                     std::string algorithm) {
+  (*output)["id"] = input.fields.at("id");
   (*output)["type"] = type;
+  (*output)["algorithm"] = algorithm;
 
-  const size_t size = input.at("size");
-  const size_t numEdges = input.at("numEdges");
-  const size_t s = input.at("start");
-  const size_t t = input.at("theEnd");
+  const size_t size = input.fields.at("size");
+  const size_t numEdges = input.fields.at("numEdges");
+  const size_t s = input.fields.at("start");
+  const size_t t = input.fields.at("theEnd");
 
-  T graph;
-  /* Для словарей используется индекс в виде строки,
-  а для массивов просто целое число типа size_t. */
-  for (size_t i = 0; i < size; i++) {
-    graph.AddVertex(input.at("vertices").at(i));
-  }
-  for (size_t i = 0; i < numEdges; i++) {
-    /*
-    printf("DEBUG: add(%zu, %zu, %zu)\n",
-      static_cast<size_t>(input.at("edges").at(i).at(0)),
-      static_cast<size_t>(input.at("edges").at(i).at(1)),
-      static_cast<size_t>(input.at("edges").at(i).at(2)));
-    */
-    graph.AddEdge(input.at("edges").at(i).at(0), input.at("edges").at(i).at(1),
-      input.at("edges").at(i).at(2));
-      //  printf("DEBUG: size=%d\n", graph.Edges(1).size());
-  }
+  T local(GraphAllocator<T>(input));
+  const T* graph;
+  /* Вершины и рёбра [откуда, куда, пропускная способность] уже прочитаны
+  из запроса в плоские векторы (или сеть загружена заранее). */
+  if (GetGraph(input, size, numEdges, &local, &graph) < 0)
+    return -1;
 
-  T result;
+  T result(GraphAllocator<T>(input));
   /* вызов алгоритма */
-  Dinic<int>(graph, &result, s, t);
+  if (algorithm == "push_relabel")
+    PushRelabel<int>(*graph, &result, s, t);
+  else
+    Dinic<int>(*graph, &result, s, t);
 
   /* Сохраняем в ответе результат работы алгоритма. */
   (*output)["size"] = result.NumVertices();
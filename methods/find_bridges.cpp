@@ -12,6 +12,7 @@
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include "find_bridges.hpp"
+#include "graph_store.hpp"
 
 namespace graph {
 /**
@@ -23,17 +24,17 @@ namespace graph {
  * @param type тип графа.
  */
 template<class T>
-static int FindBridgesMethodHelper(const nlohmann::json& input,
+static int FindBridgesMethodHelper(const GraphRequest& input,
                                      nlohmann::json* output,
                                      std::string type);
 
-int FindBridgesMethod(const nlohmann::json& input, nlohmann::json* output) {
+int FindBridgesMethod(const GraphRequest& input, nlohmann::json* output) {
   /*
   С классом nlohmann::json можно работать как со словарём.
   Метод at() в отличие оператора [] не меняет объект, поэтому
   этот метод можно использовать с константными объектами.
   */
-  std::string type = input.at("type");
+  std::string type = input.fields.at("type");
 
   /* Пока реализована только поддержка обычных графов */
   if (type == "graph") {
@@ -58,35 +59,28 @@ int FindBridgesMethod(const nlohmann::json& input, nlohmann::json* output) {
  * используется для сокращения кода, необходимого для поддержки различных типов данных.
  */
 template<class T>
-static int FindBridgesMethodHelper(const nlohmann::json& input,
+static int FindBridgesMethodHelper(const GraphRequest& input,
                                      nlohmann::json* output,
                                      std::string type) {
-  (*output)["id"] = input.at("id");
+  (*output)["id"] = input.fields.at("id");
   (*output)["type"] = type;
 
-  size_t size = input.at("size");
+  size_t size = input.fields.at("size");
 
-  size_t numEdges = input.at("numEdges");
+  size_t numEdges = input.fields.at("numEdges");
 
-  T graph;
+  T local(GraphAllocator<T>(input));
+  const T* graph;
 
-  for (size_t i = 0; i < size; i++) {
-    /* Для словарей используется индекс в виде строки,
-    а для массивов просто целое число типа size_t. */
-    graph.AddVertex(input.at("vertices").at(i));
-  }
-
-
-  for (size_t i = 0; i < numEdges; i++) {
-    /* Для словарей используется индекс в виде строки,
-    а для массивов просто целое число типа size_t. */
-    graph.AddEdge(input.at("edges").at(i).at(0), input.at("edges").at(i).at(1));
-  }
+  /* Вершины и рёбра уже прочитаны из запроса в плоские векторы
+  (или граф уже построен, если он загружен заранее). */
+  if (GetGraph(input, size, numEdges, &local, &graph) < 0)
+    return -1;
 
   /* Здесь вызывается сам алгоритм поиска мостов. */
   std::vector<std::pair<size_t, size_t>> result;
 
-  FindBridges(graph, &result);
+  FindBridges(*graph, &result);
 
   /* Сохраняем в ответе результат работы алгоритма. */
   (*output)["size"] = size;
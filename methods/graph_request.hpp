@@ -0,0 +1,681 @@
+/**
+ * @file methods/graph_request.hpp
+ *
+ * Потоковое чтение запросов к серверу. Большие массивы запроса
+ * ("vertices", "edges" и "data") разбираются SAX парсером сразу в плоские
+ * векторы чисел, без построения дерева nlohmann::json, а остальные (небольшие)
+ * поля сохраняются как обычный объект JSON.
+ */
+
+#ifndef METHODS_GRAPH_REQUEST_HPP_
+#define METHODS_GRAPH_REQUEST_HPP_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "csr_graph.hpp"
+#include "parallel.hpp"
+
+namespace graph {
+
+class StoredGraph;
+
+/**
+ * @brief Типы весов в бинарном формате запроса (см. binary_format.hpp).
+ */
+enum PackedWeightType : unsigned char {
+  //! Рёбра без весов.
+  kNoWeights = 0,
+  //! 32-битные целые со знаком.
+  kInt32Weights = 1,
+  //! 64-битные целые со знаком.
+  kInt64Weights = 2,
+  //! Числа float.
+  kFloat32Weights = 3,
+  //! Числа double.
+  kFloat64Weights = 4
+};
+
+/**
+ * @brief Прочитать беззнаковое целое в порядке little-endian.
+ *
+ * @tparam T Беззнаковый целый тип.
+ *
+ * @param data Указатель на первый байт.
+ *
+ * Компилятор сводит цикл к одной (невыровненной) загрузке на
+ * little-endian процессорах.
+ */
+template<typename T>
+T LoadLittleEndian(const unsigned char* data) {
+  T value = 0;
+  for (size_t i = 0; i < sizeof(T); i++)
+    value |= static_cast<T>(data[i]) << (8 * i);
+  return value;
+}
+
+/**
+ * @brief Разобранный запрос к серверу.
+ *
+ * Рёбра из массива "edges" ([откуда, куда] или [откуда, куда, вес])
+ * и из массива "data" (тройки вес, откуда, куда) сохраняются в одном
+ * и том же виде: концы рёбер в edges, веса в weights.
+ *
+ * Запрос в бинарном формате не копируется: вершины, рёбра и веса читаются
+ * прямо из тела запроса (поле packed), а векторы остаются пустыми. Поэтому
+ * вершины и рёбра следует читать функциями NumVertices(), Vertex() и т.д.
+ */
+struct GraphRequest {
+  //! Все поля запроса, кроме "vertices", "edges" и "data".
+  nlohmann::json fields = nlohmann::json::object();
+  //! Номера вершин из массива "vertices".
+  std::vector<size_t> vertices;
+  //! Концы рёбер: откуда, куда, откуда, куда, ...
+  std::vector<size_t> edges;
+  //! Веса рёбер (пустой вектор, если рёбра невзвешенные).
+  std::vector<double> weights;
+
+  //! Массивы запроса в бинарном формате (nullptr для запроса в JSON).
+  //! Тело запроса должно существовать, пока используется GraphRequest.
+  const unsigned char* packed = nullptr;
+  //! Количество вершин в бинарном запросе.
+  size_t packedVertices = 0;
+  //! Количество рёбер в бинарном запросе.
+  size_t packedEdges = 0;
+  //! Тип весов в бинарном запросе.
+  PackedWeightType packedWeights = kNoWeights;
+
+  //! Граф, загруженный на сервер заранее (см. graph_store.hpp), если
+  //! в запросе задано поле "graph". Тогда вершины и рёбра берутся из него.
+  std::shared_ptr<StoredGraph> stored;
+
+  //! Арена для графов и временных данных метода (nullptr - обычная куча).
+  //! Задаётся на время выполнения метода (см. RunGraphMethod()).
+  std::pmr::memory_resource* memory = nullptr;
+
+  //! Количество вершин.
+  size_t NumVertices() const {
+    return packed ? packedVertices : vertices.size();
+  }
+
+  //! Номер i-й вершины.
+  size_t Vertex(size_t i) const {
+    if (packed)
+      return LoadLittleEndian<uint64_t>(packed + 8 * i);
+    return vertices[i];
+  }
+
+  //! Количество рёбер.
+  size_t NumEdges() const {
+    return packed ? packedEdges : edges.size() / 2;
+  }
+
+  //! Начало i-го ребра.
+  size_t EdgeSource(size_t i) const {
+    if (packed)
+      return LoadLittleEndian<uint64_t>(EdgesData() + 16 * i);
+    return edges[2 * i];
+  }
+
+  //! Конец i-го ребра.
+  size_t EdgeTarget(size_t i) const {
+    if (packed)
+      return LoadLittleEndian<uint64_t>(EdgesData() + 16 * i + 8);
+    return edges[2 * i + 1];
+  }
+
+  //! Есть ли у рёбер веса.
+  bool HasWeights() const {
+    return packed ? packedWeights != kNoWeights : !weights.empty();
+  }
+
+  /**
+   * @brief Вес i-го ребра.
+   *
+   * @tparam Weight Тип веса, в который преобразуется значение.
+   */
+  template<typename Weight>
+  Weight EdgeWeight(size_t i) const {
+    if (!packed)
+      return static_cast<Weight>(weights[i]);
+
+    const unsigned char* data = EdgesData() + 16 * packedEdges;
+
+    switch (packedWeights) {
+      case kInt32Weights:
+        return static_cast<Weight>(static_cast<int32_t>(
+            LoadLittleEndian<uint32_t>(data + 4 * i)));
+      case kInt64Weights:
+        return static_cast<Weight>(static_cast<int64_t>(
+            LoadLittleEndian<uint64_t>(data + 8 * i)));
+      case kFloat32Weights: {
+        const uint32_t bits = LoadLittleEndian<uint32_t>(data + 4 * i);
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return static_cast<Weight>(value);
+      }
+      case kFloat64Weights: {
+        const uint64_t bits = LoadLittleEndian<uint64_t>(data + 8 * i);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return static_cast<Weight>(value);
+      }
+      default:
+        return Weight();
+    }
+  }
+
+ private:
+  //! Начало массива рёбер в бинарном запросе.
+  const unsigned char* EdgesData() const {
+    return packed + 8 * packedVertices;
+  }
+};
+
+/**
+ * @brief SAX обработчик для функции ReadGraphRequest().
+ *
+ * Запрос должен быть объектом JSON. Массивы "vertices", "edges" и "data"
+ * верхнего уровня читаются сразу в векторы GraphRequest, остальные поля
+ * собираются в GraphRequest::fields. Номера вершин должны быть
+ * неотрицательными целыми числами, веса - любыми числами.
+ */
+class GraphRequestReader : public nlohmann::json::json_sax_t {
+ public:
+  /**
+   * @brief Конструктор.
+   *
+   * @param request Результат.
+   */
+  explicit GraphRequestReader(GraphRequest* request) :
+    request(request),
+    column(kNoColumn),
+    pending(kNoColumn),
+    depth(0),
+    position(0),
+    arity(0),
+    target(nullptr) {
+  }
+
+  bool null() override {
+    return Value(nullptr);
+  }
+
+  bool boolean(bool value) override {
+    return Value(value);
+  }
+
+  bool number_integer(number_integer_t value) override {
+    if (column != kNoColumn)
+      return Number(static_cast<double>(value), false, 0);
+    return Value(value);
+  }
+
+  bool number_unsigned(number_unsigned_t value) override {
+    if (column != kNoColumn)
+      return Number(static_cast<double>(value), true, value);
+    return Value(value);
+  }
+
+  bool number_float(number_float_t value, const string_t&) override {
+    if (column != kNoColumn) {
+      // Целые числа с плавающей точкой больше 2^53 уже не точны.
+      const bool isIndex = value >= 0 && value < 9007199254740992.0 &&
+                           std::floor(value) == value;
+      return Number(value, isIndex, static_cast<size_t>(isIndex ? value : 0));
+    }
+    return Value(value);
+  }
+
+  bool string(string_t& value) override {
+    return Value(value);
+  }
+
+  bool binary(binary_t& value) override {
+    return Value(nlohmann::json::binary(value));
+  }
+
+  bool start_object(std::size_t) override {
+    if (stack.empty()) {
+      stack.push_back(&request->fields);
+      return true;
+    }
+
+    nlohmann::json* object = Insert(nlohmann::json::object());
+    if (object == nullptr)
+      return false;
+    stack.push_back(object);
+    return true;
+  }
+
+  bool key(string_t& name) override {
+    pending = kNoColumn;
+
+    if (stack.size() == 1) {
+      if (name == "vertices")
+        pending = kVertices;
+      else if (name == "edges")
+        pending = kEdges;
+      else if (name == "data")
+        pending = kData;
+    }
+
+    // Поле для массива не создаётся, пока не станет ясно, что это массив.
+    if (pending != kNoColumn)
+      pendingName = name;
+    else
+      target = &(*stack.back())[name];
+    return true;
+  }
+
+  bool end_object() override {
+    stack.pop_back();
+    return true;
+  }
+
+  bool start_array(std::size_t) override {
+    if (column == kEdges && depth == 1) {
+      depth++;
+      position = 0;
+      return true;
+    }
+
+    if (column != kNoColumn || stack.empty())
+      return false;
+
+    if (pending != kNoColumn) {
+      column = pending;
+      pending = kNoColumn;
+      depth = 1;
+      position = 0;
+      return true;
+    }
+
+    nlohmann::json* array = Insert(nlohmann::json::array());
+    if (array == nullptr)
+      return false;
+    stack.push_back(array);
+    return true;
+  }
+
+  bool end_array() override {
+    if (column == kNoColumn) {
+      stack.pop_back();
+      return true;
+    }
+
+    if (depth == 2) {
+      // Конец ребра [откуда, куда] или [откуда, куда, вес].
+      if (position < 2 || (arity != 0 && position != arity))
+        return false;
+      arity = position;
+      depth--;
+      return true;
+    }
+
+    if (column == kData && position % 3 != 0)
+      return false;
+    column = kNoColumn;
+    return true;
+  }
+
+  bool parse_error(std::size_t, const std::string&,
+                   const nlohmann::detail::exception&) override {
+    return false;
+  }
+
+ private:
+  //! Массивы, которые читаются без построения дерева JSON.
+  enum Column { kNoColumn, kVertices, kEdges, kData };
+
+  /**
+   * @brief Добавить значение в текущий объект или массив.
+   *
+   * @param value Значение.
+   *
+   * Функция возвращает указатель на добавленное значение или nullptr,
+   * если значение стоит внутри массива вершин или рёбер.
+   */
+  nlohmann::json* Insert(nlohmann::json&& value) {
+    if (column != kNoColumn || stack.empty())
+      return nullptr;
+
+    // Поле "vertices", "edges" или "data" оказалось не массивом.
+    if (pending != kNoColumn) {
+      target = &request->fields[pendingName];
+      pending = kNoColumn;
+    }
+
+    nlohmann::json* parent = stack.back();
+    if (parent->is_array()) {
+      parent->push_back(std::move(value));
+      return &parent->back();
+    }
+
+    *target = std::move(value);
+    return target;
+  }
+
+  /**
+   * @brief Добавить простое значение.
+   *
+   * @param value Значение.
+   */
+  bool Value(nlohmann::json&& value) {
+    return Insert(std::move(value)) != nullptr;
+  }
+
+  /**
+   * @brief Число внутри одного из массивов.
+   *
+   * @param value Значение.
+   * @param isIndex Является ли число неотрицательным целым.
+   * @param index Значение как номер вершины.
+   */
+  bool Number(double value, bool isIndex, size_t index) {
+    switch (column) {
+      case kVertices:
+        if (depth != 1 || !isIndex)
+          return false;
+        request->vertices.push_back(index);
+        return true;
+
+      case kEdges:
+        if (depth != 2 || position > 2)
+          return false;
+        if (position++ == 2) {
+          request->weights.push_back(value);
+          return true;
+        }
+        if (!isIndex)
+          return false;
+        request->edges.push_back(index);
+        return true;
+
+      case kData:
+        if (position++ % 3 == 0) {
+          request->weights.push_back(value);
+          return true;
+        }
+        if (!isIndex)
+          return false;
+        request->edges.push_back(index);
+        return true;
+
+      default:
+        return false;
+    }
+  }
+
+  //! Результат.
+  GraphRequest* request;
+  //! Массив, который сейчас читается.
+  Column column;
+  //! Массив, имя которого только что прочитано.
+  Column pending;
+  //! Имя поля, для которого pending != kNoColumn.
+  std::string pendingName;
+  //! Глубина вложенности внутри читаемого массива.
+  size_t depth;
+  //! Номер числа внутри ребра (или внутри массива "data").
+  size_t position;
+  //! Количество чисел в каждом ребре массива "edges" (0 - ещё неизвестно).
+  size_t arity;
+  //! Значение, которое будет записано по текущему ключу.
+  nlohmann::json* target;
+  //! Стек объектов и массивов JSON, которые сейчас заполняются.
+  std::vector<nlohmann::json*> stack;
+};
+
+/**
+ * @brief Прочитать запрос к серверу.
+ *
+ * @param body Текст запроса в формате JSON.
+ * @param request Результат.
+ * @return Функция возвращает 0 в случае успеха и -1, если запрос
+ * не является корректным JSON объектом или массивы вершин и рёбер
+ * заданы некорректно.
+ *
+ * Весь запрос читается за один проход без построения дерева JSON для
+ * массивов вершин и рёбер, поэтому память расходуется только на плоские
+ * векторы чисел.
+ */
+inline int ReadGraphRequest(const std::string& body, GraphRequest* request) {
+  *request = GraphRequest();
+  GraphRequestReader reader(request);
+
+  if (!nlohmann::json::sax_parse(body, &reader) ||
+      !request->fields.is_object())
+    return -1;
+
+  return 0;
+}
+
+/**
+ * @brief Прочитать количество потоков из поля "threads" запроса.
+ *
+ * @param request Запрос.
+ * @param threads Результат (0 - поле не задано, количество ядер
+ *        процессора).
+ * @return Функция возвращает 0 в случае успеха и -1, если поле задано,
+ * но не является неотрицательным целым числом.
+ *
+ * Значение ограничивается количеством ядер процессора: алгоритмы
+ * выделяют рабочие массивы на каждый поток, и клиент не должен
+ * управлять их размером.
+ */
+inline int ReadNumThreads(const GraphRequest& request, size_t* threads) {
+  *threads = 0;
+
+  if (!request.fields.contains("threads"))
+    return 0;
+
+  const nlohmann::json& value = request.fields.at("threads");
+  if (!value.is_number_unsigned())
+    return -1;
+
+  *threads = std::min(value.get<size_t>(), DefaultNumThreads());
+  return 0;
+}
+
+/**
+ * @brief Итератор по рёбрам запроса для функции AddEdges() графа.
+ *
+ * @tparam Weight Тип веса ребра (void для рёбер без весов).
+ *
+ * Разыменование возвращает пару [откуда, куда] или тройку
+ * [откуда, куда, вес], поэтому рёбра не нужно копировать в отдельный
+ * вектор перед построением графа. Итератор произвольного доступа (как
+ * и итератор std::vector<bool>, он возвращает значение, а не ссылку),
+ * поэтому им можно пользоваться и в ParallelCsrBuilder.
+ */
+template<typename Weight = void>
+class RequestEdgeIterator {
+ public:
+  //! Категория итератора.
+  using iterator_category = std::random_access_iterator_tag;
+  //! Тип значения итератора.
+  using value_type = std::conditional_t<std::is_void<Weight>::value,
+                                        std::pair<size_t, size_t>,
+                                        std::tuple<size_t, size_t, Weight>>;
+  //! Тип разности итераторов.
+  using difference_type = std::ptrdiff_t;
+  //! Тип указателя.
+  using pointer = const value_type*;
+  //! Тип ссылки.
+  using reference = value_type;
+
+  /**
+   * @brief Конструктор.
+   *
+   * @param request Запрос.
+   * @param index Номер ребра.
+   */
+  RequestEdgeIterator(const GraphRequest* request, size_t index) :
+    request(request),
+    index(index) {
+  }
+
+  //! Ребро с номером index.
+  value_type operator*() const {
+    if constexpr (std::is_void<Weight>::value)
+      return value_type(request->EdgeSource(index),
+                        request->EdgeTarget(index));
+    else
+      return value_type(request->EdgeSource(index),
+                        request->EdgeTarget(index),
+                        request->EdgeWeight<Weight>(index));
+  }
+
+  //! Ребро с номером index + n.
+  value_type operator[](difference_type n) const {
+    return *(*this + n);
+  }
+
+  //! Перейти к следующему ребру.
+  RequestEdgeIterator& operator++() {
+    index++;
+    return *this;
+  }
+
+  //! Перейти к следующему ребру.
+  RequestEdgeIterator operator++(int) {
+    RequestEdgeIterator old = *this;
+    index++;
+    return old;
+  }
+
+  //! Перейти к предыдущему ребру.
+  RequestEdgeIterator& operator--() {
+    index--;
+    return *this;
+  }
+
+  //! Перейти к предыдущему ребру.
+  RequestEdgeIterator operator--(int) {
+    RequestEdgeIterator old = *this;
+    index--;
+    return old;
+  }
+
+  //! Сдвинуться на n рёбер.
+  RequestEdgeIterator& operator+=(difference_type n) {
+    index += static_cast<size_t>(n);
+    return *this;
+  }
+
+  //! Сдвинуться на n рёбер назад.
+  RequestEdgeIterator& operator-=(difference_type n) {
+    index -= static_cast<size_t>(n);
+    return *this;
+  }
+
+  //! Итератор, сдвинутый на n рёбер.
+  RequestEdgeIterator operator+(difference_type n) const {
+    return RequestEdgeIterator(request, index + static_cast<size_t>(n));
+  }
+
+  //! Итератор, сдвинутый на n рёбер назад.
+  RequestEdgeIterator operator-(difference_type n) const {
+    return RequestEdgeIterator(request, index - static_cast<size_t>(n));
+  }
+
+  //! Количество рёбер между итераторами.
+  difference_type operator-(const RequestEdgeIterator& other) const {
+    return static_cast<difference_type>(index) -
+           static_cast<difference_type>(other.index);
+  }
+
+  //! Сравнить итераторы.
+  bool operator==(const RequestEdgeIterator& other) const {
+    return index == other.index;
+  }
+
+  //! Сравнить итераторы.
+  bool operator!=(const RequestEdgeIterator& other) const {
+    return index != other.index;
+  }
+
+  //! Сравнить итераторы.
+  bool operator<(const RequestEdgeIterator& other) const {
+    return index < other.index;
+  }
+
+  //! Сравнить итераторы.
+  bool operator>(const RequestEdgeIterator& other) const {
+    return index > other.index;
+  }
+
+  //! Сравнить итераторы.
+  bool operator<=(const RequestEdgeIterator& other) const {
+    return index <= other.index;
+  }
+
+  //! Сравнить итераторы.
+  bool operator>=(const RequestEdgeIterator& other) const {
+    return index >= other.index;
+  }
+
+ private:
+  //! Запрос.
+  const GraphRequest* request;
+  //! Номер ребра.
+  size_t index;
+};
+
+/**
+ * @brief Заполнить граф вершинами и рёбрами запроса.
+ *
+ * @tparam T Тип графа.
+ *
+ * @param request Запрос.
+ * @param numVertices Сколько первых вершин добавить.
+ * @param numEdges Сколько первых рёбер добавить.
+ * @param graph Граф.
+ * @return Функция возвращает 0 в случае успеха и -1, если в запросе
+ * меньше вершин или рёбер, чем нужно, или у рёбер взвешенного графа нет
+ * весов.
+ *
+ * Место под вершины резервируется заранее, а рёбра добавляются одним
+ * вызовом AddEdges(), который заполняет каждую вершину за один проход.
+ */
+template<class T>
+int FillGraph(const GraphRequest& request, size_t numVertices,
+              size_t numEdges, T* graph) {
+  if (numVertices > request.NumVertices() || numEdges > request.NumEdges())
+    return -1;
+
+  graph->Reserve(numVertices, numEdges);
+  for (size_t i = 0; i < numVertices; i++)
+    graph->AddVertex(request.Vertex(i));
+
+  if constexpr (IsWeightedGraph<T>::value) {
+    using Iterator = RequestEdgeIterator<typename T::WeightType>;
+
+    if (numEdges > 0 && !request.HasWeights())
+      return -1;
+
+    graph->AddEdges(Iterator(&request, 0), Iterator(&request, numEdges));
+  } else {
+    using Iterator = RequestEdgeIterator<>;
+
+    graph->AddEdges(Iterator(&request, 0), Iterator(&request, numEdges));
+  }
+
+  return 0;
+}
+
+}  // namespace graph
+
+#endif  // METHODS_GRAPH_REQUEST_HPP_
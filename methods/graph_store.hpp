@@ -0,0 +1,1141 @@
+/**
+ * @file methods/graph_store.hpp
+ *
+ * Хранилище графов на сервере. Граф загружается один раз запросом
+ * POST /graphs, а затем методы получают его по идентификатору (поле
+ * "graph" запроса), не пересылая и не перестраивая граф заново. Графы,
+ * которые дольше всех не использовались, удаляются, если хранилище
+ * занимает больше заданного объёма памяти. Загруженный граф можно менять
+ * запросом PATCH /graphs/<id>, а результаты методов запоминаются для
+ * каждой его версии.
+ */
+
+#ifndef METHODS_GRAPH_STORE_HPP_
+#define METHODS_GRAPH_STORE_HPP_
+
+#include <cstddef>
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <tuple>
+#include <typeindex>
+#include <typeinfo>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <nlohmann/json.hpp>
+#include "binary_format.hpp"
+#include "csr_builder.hpp"
+#include "graph.hpp"
+#include "graph_request.hpp"
+#include "result_cache.hpp"
+#include "weighted_graph.hpp"
+
+namespace graph {
+
+/**
+ * @brief Оценить объём памяти, который занимает граф.
+ *
+ * @tparam T Тип графа.
+ *
+ * @param graph Граф.
+ *
+ * Вершины и рёбра хранятся в хеш-таблицах с запасом свободных ячеек,
+ * поэтому каждая из них обходится в несколько десятков байт. Оценка
+ * рассчитана с запасом и подходит и для graph::StdHashContainers.
+ */
+template<class T>
+size_t GraphMemoryUsage(const T& graph) {
+  const size_t vertexBytes = 96;
+  const size_t edgeBytes = 48;
+  size_t entries = 0;
+
+  for (size_t v : graph.Vertices())
+    entries += graph.Edges(v).size();
+  if (!IsUndirectedGraph<T>::value)
+    entries *= 2;
+
+  return sizeof(T) + graph.NumVertices() * vertexBytes + entries * edgeBytes;
+}
+
+/**
+ * @brief Изменение загруженного графа (тело запроса PATCH /graphs/<id>).
+ *
+ * Изменения применяются в таком порядке: удаление вершин (вместе
+ * с инцидентными рёбрами), удаление рёбер, добавление вершин и добавление
+ * рёбер. Добавление уже существующего ребра взвешенного графа меняет его
+ * вес.
+ */
+struct GraphPatch {
+  //! Удаляемые вершины.
+  std::vector<size_t> removeVertices;
+  //! Концы удаляемых рёбер: откуда, куда, откуда, куда, ...
+  std::vector<size_t> removeEdges;
+  //! Добавляемые вершины.
+  std::vector<size_t> addVertices;
+  //! Концы добавляемых рёбер: откуда, куда, откуда, куда, ...
+  std::vector<size_t> addEdges;
+  //! Веса добавляемых рёбер (пустой вектор, если рёбра невзвешенные).
+  std::vector<double> addWeights;
+};
+
+/**
+ * @brief Прочитать изменение графа.
+ *
+ * @param body Текст запроса в формате JSON: объект с необязательными
+ *        полями "removeVertices", "removeEdges", "addVertices"
+ *        и "addEdges" (рёбра в формате [откуда, куда] или
+ *        [откуда, куда, вес]).
+ * @param patch Результат.
+ * @return Функция возвращает 0 в случае успеха и -1, если изменение
+ * задано некорректно.
+ *
+ * Изменения обычно небольшие, поэтому запрос разбирается как дерево JSON.
+ */
+inline int ReadGraphPatch(const std::string& body, GraphPatch* patch) {
+  *patch = GraphPatch();
+  const nlohmann::json input = nlohmann::json::parse(body, nullptr, false);
+  if (!input.is_object())
+    return -1;
+
+  // Прочитать массив номеров вершин.
+  auto readVertices = [&](const char* name, std::vector<size_t>* result) {
+    if (!input.contains(name))
+      return true;
+    if (!input.at(name).is_array())
+      return false;
+
+    for (const nlohmann::json& vertex : input.at(name)) {
+      if (!vertex.is_number_unsigned())
+        return false;
+      result->push_back(vertex);
+    }
+    return true;
+  };
+
+  // Прочитать массив рёбер. Веса разрешены, только если weights != nullptr.
+  auto readEdges = [&](const char* name, std::vector<size_t>* result,
+                       std::vector<double>* weights) {
+    if (!input.contains(name))
+      return true;
+    if (!input.at(name).is_array())
+      return false;
+
+    const size_t maxArity = weights ? 3 : 2;
+    size_t arity = 0;
+    for (const nlohmann::json& edge : input.at(name)) {
+      if (!edge.is_array() || edge.size() < 2 || edge.size() > maxArity ||
+          (arity != 0 && edge.size() != arity) ||
+          !edge[0].is_number_unsigned() || !edge[1].is_number_unsigned())
+        return false;
+      arity = edge.size();
+
+      result->push_back(edge[0]);
+      result->push_back(edge[1]);
+      if (arity == 3) {
+        if (!edge[2].is_number())
+          return false;
+        weights->push_back(edge[2]);
+      }
+    }
+    return true;
+  };
+
+  for (const auto& field : input.items())
+    if (field.key() != "removeVertices" && field.key() != "removeEdges" &&
+        field.key() != "addVertices" && field.key() != "addEdges")
+      return -1;
+
+  if (!readVertices("removeVertices", &patch->removeVertices) ||
+      !readEdges("removeEdges", &patch->removeEdges, nullptr) ||
+      !readVertices("addVertices", &patch->addVertices) ||
+      !readEdges("addEdges", &patch->addEdges, &patch->addWeights))
+    return -1;
+
+  return 0;
+}
+
+/**
+ * @brief От чего зависит результат метода.
+ *
+ * Результаты методов, которые не используют веса рёбер, остаются верными
+ * после изменения одних только весов.
+ */
+enum ResultDependency {
+  //! Результат зависит только от вершин и рёбер.
+  kDependsOnTopology,
+  //! Результат зависит и от весов рёбер.
+  kDependsOnWeights
+};
+
+/**
+ * @brief Граф, загруженный на сервер.
+ *
+ * Хранит разобранный запрос на загрузку и графы, построенные по нему.
+ * Граф каждого типа строится при первом обращении к нему (разные методы
+ * используют разные классы графов) и дальше используется повторно.
+ *
+ * Граф можно менять функцией Patch(): изменение применяется и к массивам
+ * вершин и рёбер, и (функциями AddEdge(), RemoveEdge(), RemoveVertex())
+ * к уже построенным графам, поэтому они не перестраиваются. Результаты
+ * методов запоминаются для текущей версии графа. После изменения остаются
+ * только те из них, которые не могут измениться: все результаты, если
+ * граф на самом деле не изменился, и результаты методов, не использующих
+ * веса, если изменились только веса рёбер.
+ *
+ * Объект можно использовать из нескольких потоков: методы захватывают
+ * граф для чтения (см. ReadLock()), а Patch() ждёт, пока они завершатся.
+ */
+class StoredGraph {
+ public:
+  StoredGraph() :
+    weighted(false),
+    version(0),
+    bytes(0) {
+  }
+
+  StoredGraph(const StoredGraph&) = delete;
+  StoredGraph& operator=(const StoredGraph&) = delete;
+
+  /**
+   * @brief Загрузить граф.
+   *
+   * @param body Тело запроса.
+   * @param binary Задан ли запрос в бинарном формате.
+   * @return Функция возвращает 0 в случае успеха и -1, если запрос
+   * задан некорректно.
+   *
+   * Бинарный запрос читается без копирования, поэтому его тело хранится
+   * вместе с графом. Тело запроса в формате JSON после разбора не нужно.
+   */
+  int Load(std::string body, bool binary) {
+    this->body = std::move(body);
+
+    if (binary) {
+      if (ReadBinaryGraphRequest(this->body, &request) < 0)
+        return -1;
+    } else {
+      if (ReadGraphRequest(this->body, &request) < 0)
+        return -1;
+      this->body = std::string();
+    }
+
+    if (request.fields.contains("graph"))
+      return -1;
+
+    weighted = request.HasWeights();
+    bytes = RequestMemoryUsage();
+    return 0;
+  }
+
+  /**
+   * @brief Захватить граф для чтения.
+   *
+   * @param graph Граф.
+   * @return Указатель на тот же граф. Пока существует он или его копии,
+   * граф нельзя изменить.
+   */
+  static std::shared_ptr<StoredGraph> ReadLock(
+      std::shared_ptr<StoredGraph> graph) {
+    graph->access.lock_shared();
+    StoredGraph* locked = graph.get();
+
+    return std::shared_ptr<StoredGraph>(locked, [graph](StoredGraph*) {
+      graph->access.unlock_shared();
+    });
+  }
+
+  /**
+   * @brief Получить граф заданного типа.
+   *
+   * @tparam T Тип графа.
+   *
+   * @param numVertices Сколько первых вершин добавить в граф.
+   * @param numEdges Сколько первых рёбер добавить в граф.
+   * @param graph Указатель на граф. Граф существует, пока существует
+   *        объект StoredGraph.
+   * @return Функция возвращает 0 в случае успеха и -1, если граф не
+   * удалось построить (см. FillGraph()).
+   */
+  template<class T>
+  int Get(size_t numVertices, size_t numEdges, const T** graph) {
+    const Key key(std::type_index(typeid(T)), numVertices, numEdges);
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto it = graphs.find(key);
+    if (it == graphs.end()) {
+      auto built = std::make_shared<T>();
+      if (FillGraph(request, numVertices, numEdges, built.get()) < 0)
+        return -1;
+
+      T* target = built.get();
+      BuiltGraph entry;
+      entry.apply = [target](const GraphChange& change, bool addVertices) {
+        ApplyChange(change, addVertices, target);
+        return GraphMemoryUsage(*target);
+      };
+      entry.bytes = GraphMemoryUsage(*target);
+      entry.graph = std::move(built);
+
+      bytes += entry.bytes;
+      it = graphs.emplace(key, std::move(entry)).first;
+    }
+
+    *graph = static_cast<const T*>(it->second.graph.get());
+    return 0;
+  }
+
+  /**
+   * @brief Изменить граф.
+   *
+   * @param patch Изменение.
+   * @return Функция возвращает 0 в случае успеха и -1, если удаляемых
+   * вершин или рёбер нет в графе или веса добавляемых рёбер не
+   * соответствуют графу. В этом случае граф не меняется.
+   *
+   * Если граф задан типом "graph" (неориентированный), то удаляются рёбра
+   * в обоих направлениях. Поля "size" и "numEdges" (или первый элемент
+   * массива "size" для графов, заданных тройками "data"), если они
+   * совпадали с количеством вершин и рёбер, получают новые значения.
+   */
+  int Patch(const GraphPatch& patch) {
+    std::unique_lock<std::shared_mutex> writer(access);
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const bool weightedPatch = !patch.addWeights.empty();
+    if (!patch.addEdges.empty() && weightedPatch != weighted &&
+        !(request.NumEdges() == 0 && weightedPatch))
+      return -1;
+
+    Materialize();
+    const bool undirected = request.fields.contains("type") &&
+        request.fields.at("type") == "graph";
+
+    // Все удаляемые вершины и рёбра должны быть в графе.
+    std::unordered_set<size_t> existing(request.vertices.begin(),
+                                        request.vertices.end());
+    EdgeSet present;
+    for (size_t i = 0; i < request.NumEdges(); i++) {
+      existing.insert(request.edges[2 * i]);
+      existing.insert(request.edges[2 * i + 1]);
+      present.insert({request.edges[2 * i], request.edges[2 * i + 1]});
+    }
+
+    const std::unordered_set<size_t> removedVertices(
+        patch.removeVertices.begin(), patch.removeVertices.end());
+    for (size_t v : removedVertices)
+      if (!existing.count(v))
+        return -1;
+
+    EdgeSet removedEdges;
+    for (size_t i = 0; i + 1 < patch.removeEdges.size(); i += 2) {
+      const size_t a = patch.removeEdges[i], b = patch.removeEdges[i + 1];
+      if (!present.count({a, b}) && !(undirected && present.count({b, a})))
+        return -1;
+      removedEdges.insert({a, b});
+      if (undirected)
+        removedEdges.insert({b, a});
+    }
+
+    const EdgeSet added = PatchEdges(patch);
+    GraphChange change;
+    bool topology = !removedVertices.empty();
+    bool weights = false;
+
+    change.removedVertices.assign(removedVertices.begin(),
+                                  removedVertices.end());
+
+    std::vector<size_t> vertices;
+    for (size_t v : request.vertices)
+      if (!removedVertices.count(v))
+        vertices.push_back(v);
+
+    // Оставшиеся рёбра. У взвешенного графа добавляемое ребро заменяет
+    // существующее, поэтому его старые копии тоже удаляются.
+    std::vector<size_t> edges;
+    std::vector<double> edgeWeights;
+    EdgeSet removedPairs, kept;
+    std::unordered_set<size_t> touched;
+    for (size_t i = 0; i < request.NumEdges(); i++) {
+      const Edge edge{request.edges[2 * i], request.edges[2 * i + 1]};
+      const bool incident = removedVertices.count(edge.first) ||
+          removedVertices.count(edge.second);
+
+      if (incident || removedEdges.count(edge)) {
+        touched.insert(edge.first);
+        touched.insert(edge.second);
+        if (!incident)
+          removedPairs.insert(edge);
+        continue;
+      }
+      if (weighted && added.count(edge)) {
+        weights = true;
+        continue;
+      }
+
+      kept.insert(edge);
+      edges.push_back(edge.first);
+      edges.push_back(edge.second);
+      if (weighted)
+        edgeWeights.push_back(request.weights[i]);
+    }
+    topology = topology || !removedPairs.empty();
+
+    std::unordered_set<size_t> vertexSet(vertices.begin(), vertices.end());
+    for (size_t v : patch.addVertices) {
+      if (vertexSet.insert(v).second) {
+        vertices.push_back(v);
+        change.addedVertices.push_back(v);
+        topology = true;
+      }
+    }
+
+    for (size_t i = 0; i < patch.addEdges.size() / 2; i++) {
+      const Edge edge{patch.addEdges[2 * i], patch.addEdges[2 * i + 1]};
+      const double weight = weightedPatch ? patch.addWeights[i] : 0;
+
+      if (!weightedPatch &&
+          (kept.count(edge) ||
+           (undirected && kept.count({edge.second, edge.first}))))
+        continue;
+
+      if (!present.count(edge) || removedPairs.count(edge))
+        topology = true;
+      kept.insert(edge);
+      edges.push_back(edge.first);
+      edges.push_back(edge.second);
+      if (weightedPatch)
+        edgeWeights.push_back(weight);
+      change.addedEdges.push_back({edge, weight});
+    }
+
+    if (!topology && !weights)
+      return 0;
+
+    // Вершины, которых нет в массиве "vertices", существуют, только пока
+    // у них есть рёбра, поэтому вершины без оставшихся рёбер удаляются.
+    // В графах, построенных только по рёбрам, это верно для всех вершин.
+    for (size_t i = 0; i < edges.size(); i++)
+      touched.erase(edges[i]);
+    for (size_t v : touched) {
+      if (removedVertices.count(v))
+        continue;
+      change.edgelessVertices.push_back(v);
+      if (!vertexSet.count(v))
+        change.orphanedVertices.push_back(v);
+    }
+
+    // Неориентированные графы хранят ребро, пока осталось хотя бы одно
+    // из двух его направлений (с весом последнего из них).
+    std::map<Edge, double> remaining;
+    for (size_t i = 0; i < edges.size() / 2; i++) {
+      const Edge edge{std::min(edges[2 * i], edges[2 * i + 1]),
+                      std::max(edges[2 * i], edges[2 * i + 1])};
+      if (removedPairs.count(edge) ||
+          removedPairs.count({edge.second, edge.first}))
+        remaining[edge] = weightedPatch || weighted ? edgeWeights[i] : 0;
+    }
+    for (const Edge& edge : removedPairs) {
+      change.removedEdges.push_back(edge);
+      const Edge pair{std::min(edge.first, edge.second),
+                      std::max(edge.first, edge.second)};
+      if (!remaining.count(pair))
+        change.removedUndirected.push_back(edge);
+    }
+    for (const auto& [edge, weight] : remaining)
+      change.restoredUndirected.push_back({edge, weight});
+
+    const size_t oldVertices = request.vertices.size();
+    const size_t oldEdges = request.NumEdges();
+    request.vertices = std::move(vertices);
+    request.edges = std::move(edges);
+    request.weights = std::move(edgeWeights);
+    weighted = weighted || weightedPatch;
+    UpdateSizeFields(oldVertices, oldEdges);
+
+    // Построенные графы со всеми вершинами и рёбрами меняются на месте,
+    // остальные будут построены заново при следующем обращении.
+    std::map<Key, BuiltGraph> updated;
+    for (auto& [key, built] : graphs) {
+      const auto& [type, numVertices, numEdges] = key;
+      if (numEdges != oldEdges ||
+          (numVertices != 0 && numVertices != oldVertices))
+        continue;
+
+      built.bytes = built.apply(change, numVertices != 0);
+      updated.emplace(Key(type, numVertices == 0 ? 0 : request.vertices.size(),
+                          request.NumEdges()), std::move(built));
+    }
+    graphs = std::move(updated);
+
+    // Результаты, которые могли измениться, удаляются.
+    for (auto it = results.begin(); it != results.end();) {
+      if (topology || it->second.dependency == kDependsOnWeights)
+        it = results.erase(it);
+      else
+        ++it;
+    }
+
+    version++;
+    bytes = TotalMemoryUsage();
+    return 0;
+  }
+
+  /**
+   * @brief Найти запомненный результат метода.
+   *
+   * @param key Метод и поля запроса.
+   * @param output Результат.
+   * @return Функция возвращает true, если результат найден.
+   */
+  bool FindResult(const std::string& key, nlohmann::json* output) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = results.find(key);
+    if (it == results.end())
+      return false;
+
+    *output = it->second.output;
+    return true;
+  }
+
+  /**
+   * @brief Запомнить результат метода для текущей версии графа.
+   *
+   * @param key Метод и поля запроса.
+   * @param dependency От чего зависит результат.
+   * @param output Результат.
+   */
+  void SaveResult(const std::string& key, ResultDependency dependency,
+                  const nlohmann::json& output) {
+    const size_t size = key.size() + output.dump().size();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (results.emplace(key, CachedResult{output, dependency, size}).second)
+      bytes += size;
+  }
+
+  /**
+   * @brief Запрос, по которому загружен граф (с учётом изменений).
+   */
+  const GraphRequest& Request() const {
+    return request;
+  }
+
+  /**
+   * @brief Функция возвращает номер версии графа (количество изменений).
+   */
+  size_t Version() const {
+    return version;
+  }
+
+  /**
+   * @brief Функция возвращает оценку занимаемой памяти в байтах.
+   */
+  size_t MemoryUsage() const {
+    return bytes;
+  }
+
+ private:
+  //! Ребро: откуда, куда.
+  using Edge = std::pair<size_t, size_t>;
+
+  //! Хеш-функция для рёбер.
+  struct EdgeHash {
+    size_t operator()(const Edge& edge) const {
+      return std::hash<size_t>()(edge.first * 0x9E3779B97F4A7C15ULL ^
+                                 edge.second);
+    }
+  };
+
+  //! Множество рёбер.
+  using EdgeSet = std::unordered_set<Edge, EdgeHash>;
+
+  //! Изменение, которое применяется к построенным графам.
+  struct GraphChange {
+    //! Удалённые вершины.
+    std::vector<size_t> removedVertices;
+    //! Удалённые рёбра.
+    std::vector<Edge> removedEdges;
+    //! Удалённые рёбра, у которых не осталось ни одного направления.
+    std::vector<Edge> removedUndirected;
+    //! Рёбра, у которых осталось другое направление, и их веса.
+    std::vector<std::pair<Edge, double>> restoredUndirected;
+    //! Вершины, у которых не осталось рёбер и которых нет в "vertices".
+    std::vector<size_t> orphanedVertices;
+    //! Вершины, у которых не осталось рёбер.
+    std::vector<size_t> edgelessVertices;
+    //! Добавленные вершины.
+    std::vector<size_t> addedVertices;
+    //! Добавленные рёбра и их веса.
+    std::vector<std::pair<Edge, double>> addedEdges;
+  };
+
+  //! Построенный граф.
+  struct BuiltGraph {
+    //! Граф.
+    std::shared_ptr<void> graph;
+    //! Применить изменение и вернуть новую оценку занимаемой памяти.
+    std::function<size_t(const GraphChange&, bool)> apply;
+    //! Оценка занимаемой памяти.
+    size_t bytes;
+  };
+
+  //! Запомненный результат метода.
+  struct CachedResult {
+    //! Результат.
+    nlohmann::json output;
+    //! От чего зависит результат.
+    ResultDependency dependency;
+    //! Оценка занимаемой памяти.
+    size_t bytes;
+  };
+
+  //! Ключ построенного графа: тип графа, количество вершин и рёбер.
+  using Key = std::tuple<std::type_index, size_t, size_t>;
+
+  /**
+   * @brief Применить изменение к построенному графу.
+   *
+   * @tparam T Тип графа.
+   *
+   * @param change Изменение.
+   * @param addVertices Добавлять ли новые вершины (граф построен по всем
+   *        вершинам, а не только по рёбрам).
+   * @param graph Граф.
+   */
+  template<class T>
+  static void ApplyChange(const GraphChange& change, bool addVertices,
+                          T* graph) {
+    for (size_t v : change.removedVertices)
+      graph->RemoveVertex(v);
+
+    if constexpr (IsUndirectedGraph<T>::value) {
+      for (const Edge& edge : change.removedUndirected)
+        graph->RemoveEdge(edge.first, edge.second);
+      if constexpr (IsWeightedGraph<T>::value)
+        for (const auto& [edge, weight] : change.restoredUndirected)
+          graph->AddEdge(edge.first, edge.second,
+                         static_cast<typename T::WeightType>(weight));
+    } else {
+      for (const Edge& edge : change.removedEdges)
+        graph->RemoveEdge(edge.first, edge.second);
+    }
+
+    for (size_t v : addVertices ? change.orphanedVertices
+                                : change.edgelessVertices)
+      graph->RemoveVertex(v);
+
+    if (addVertices)
+      for (size_t v : change.addedVertices)
+        graph->AddVertex(v);
+
+    for (const auto& [edge, weight] : change.addedEdges) {
+      if constexpr (IsWeightedGraph<T>::value)
+        graph->AddEdge(edge.first, edge.second,
+                       static_cast<typename T::WeightType>(weight));
+      else
+        graph->AddEdge(edge.first, edge.second);
+    }
+  }
+
+  //! Добавляемые рёбра изменения.
+  static EdgeSet PatchEdges(const GraphPatch& patch) {
+    EdgeSet edges;
+    for (size_t i = 0; i + 1 < patch.addEdges.size(); i += 2)
+      edges.insert({patch.addEdges[i], patch.addEdges[i + 1]});
+    return edges;
+  }
+
+  /**
+   * @brief Скопировать массивы бинарного запроса в векторы, чтобы их
+   *        можно было менять.
+   */
+  void Materialize() {
+    if (!request.packed)
+      return;
+
+    GraphRequest copy;
+    copy.fields = request.fields;
+    for (size_t i = 0; i < request.NumVertices(); i++)
+      copy.vertices.push_back(request.Vertex(i));
+    for (size_t i = 0; i < request.NumEdges(); i++) {
+      copy.edges.push_back(request.EdgeSource(i));
+      copy.edges.push_back(request.EdgeTarget(i));
+      if (request.HasWeights())
+        copy.weights.push_back(request.EdgeWeight<double>(i));
+    }
+
+    request = std::move(copy);
+    body = std::string();
+  }
+
+  /**
+   * @brief Обновить поля с количеством вершин и рёбер.
+   *
+   * @param oldVertices Количество вершин до изменения.
+   * @param oldEdges Количество рёбер до изменения.
+   */
+  void UpdateSizeFields(size_t oldVertices, size_t oldEdges) {
+    nlohmann::json& fields = request.fields;
+
+    if (fields.contains("size") && fields.at("size") == oldVertices)
+      fields["size"] = request.vertices.size();
+    if (fields.contains("numEdges") && fields.at("numEdges") == oldEdges)
+      fields["numEdges"] = request.NumEdges();
+    if (fields.contains("size") && fields.at("size").is_array() &&
+        !fields.at("size").empty() && fields.at("size")[0] == oldEdges)
+      fields["size"][0] = request.NumEdges();
+  }
+
+  //! Оценка памяти, которую занимают массивы и поля запроса.
+  size_t RequestMemoryUsage() const {
+    return sizeof(*this) + body.capacity() +
+        request.vertices.capacity() * sizeof(size_t) +
+        request.edges.capacity() * sizeof(size_t) +
+        request.weights.capacity() * sizeof(double) +
+        request.fields.dump().size();
+  }
+
+  //! Оценка всей занимаемой памяти.
+  size_t TotalMemoryUsage() const {
+    size_t total = RequestMemoryUsage();
+    for (const auto& entry : graphs)
+      total += entry.second.bytes;
+    for (const auto& entry : results)
+      total += entry.second.bytes;
+    return total;
+  }
+
+  //! Тело бинарного запроса (на него ссылается request).
+  std::string body;
+  //! Разобранный запрос.
+  GraphRequest request;
+  //! Есть ли у рёбер веса.
+  bool weighted;
+  //! Построенные графы.
+  std::map<Key, BuiltGraph> graphs;
+  //! Запомненные результаты методов (ключ - метод и поля запроса).
+  std::map<std::string, CachedResult> results;
+  //! Номер версии графа.
+  size_t version;
+  //! Мьютекс для построенных графов и результатов.
+  std::mutex mutex;
+  //! Блокировка графа: методы читают граф, Patch() его меняет.
+  std::shared_mutex access;
+  //! Оценка занимаемой памяти.
+  std::atomic<size_t> bytes;
+};
+
+/**
+ * @brief Хранилище загруженных графов.
+ *
+ * Графы хранятся по строковым идентификаторам. Каждое обращение к графу
+ * делает его последним использованным. Пока хранилище занимает больше
+ * памяти, чем разрешено, из него удаляются графы, которые дольше всех не
+ * использовались (кроме последнего). Удалённый граф продолжает
+ * существовать, пока его используют уже выполняющиеся запросы.
+ */
+class GraphStore {
+ public:
+  /**
+   * @brief Конструктор.
+   *
+   * @param memoryBudget Объём памяти для графов в байтах.
+   */
+  explicit GraphStore(size_t memoryBudget) :
+    memoryBudget(memoryBudget),
+    nextId(1) {
+  }
+
+  /**
+   * @brief Добавить граф.
+   *
+   * @param graph Загруженный граф.
+   * @param handle Идентификатор графа.
+   * @return Функция возвращает 0 в случае успеха и -1, если граф
+   * занимает больше памяти, чем разрешено.
+   */
+  int Add(std::shared_ptr<StoredGraph> graph, std::string* handle) {
+    if (graph->MemoryUsage() > memoryBudget)
+      return -1;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    *handle = "g" + std::to_string(nextId++);
+    order.push_front(*handle);
+    entries[*handle] = {std::move(graph), order.begin()};
+    Trim();
+    return 0;
+  }
+
+  /**
+   * @brief Найти граф.
+   *
+   * @param handle Идентификатор графа.
+   * @return Граф или nullptr, если графа нет (или он уже удалён).
+   */
+  std::shared_ptr<StoredGraph> Find(const std::string& handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(handle);
+    if (it == entries.end())
+      return nullptr;
+
+    order.splice(order.begin(), order, it->second.position);
+    std::shared_ptr<StoredGraph> graph = it->second.graph;
+    Trim();
+    return graph;
+  }
+
+  /**
+   * @brief Удалить граф.
+   *
+   * @param handle Идентификатор графа.
+   * @return Функция возвращает true, если граф был в хранилище.
+   */
+  bool Remove(const std::string& handle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(handle);
+    if (it == entries.end())
+      return false;
+
+    order.erase(it->second.position);
+    entries.erase(it);
+    return true;
+  }
+
+  /**
+   * @brief Функция возвращает количество графов.
+   */
+  size_t Size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+  }
+
+  /**
+   * @brief Функция возвращает оценку занимаемой памяти в байтах.
+   */
+  size_t MemoryUsage() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return Total();
+  }
+
+  /**
+   * @brief Функция возвращает объём памяти, разрешённый для графов.
+   */
+  size_t MemoryBudget() const {
+    return memoryBudget;
+  }
+
+ private:
+  //! Граф в хранилище.
+  struct Entry {
+    //! Граф.
+    std::shared_ptr<StoredGraph> graph;
+    //! Положение в списке order.
+    std::list<std::string>::iterator position;
+  };
+
+  //! Суммарная память графов (мьютекс должен быть захвачен).
+  size_t Total() const {
+    size_t total = 0;
+    for (const auto& entry : entries)
+      total += entry.second.graph->MemoryUsage();
+    return total;
+  }
+
+  /**
+   * @brief Удалить графы, которые дольше всех не использовались, пока
+   *        хранилище занимает больше разрешённого.
+   *
+   * Мьютекс должен быть захвачен. Графы растут при построении (см.
+   * StoredGraph::Get()), поэтому ограничение проверяется при каждом
+   * обращении к хранилищу.
+   */
+  void Trim() {
+    size_t total = Total();
+
+    while (total > memoryBudget && order.size() > 1) {
+      auto it = entries.find(order.back());
+      total -= it->second.graph->MemoryUsage();
+      entries.erase(it);
+      order.pop_back();
+    }
+  }
+
+  //! Объём памяти для графов.
+  size_t memoryBudget;
+  //! Номер следующего идентификатора.
+  size_t nextId;
+  //! Графы по идентификаторам.
+  std::unordered_map<std::string, Entry> entries;
+  //! Идентификаторы от последнего использованного к самому старому.
+  std::list<std::string> order;
+  //! Мьютекс.
+  mutable std::mutex mutex;
+};
+
+/**
+ * @brief Подставить в запрос загруженный граф.
+ *
+ * @param store Хранилище графов.
+ * @param request Запрос.
+ * @return Функция возвращает 0 в случае успеха и -1, если графа с таким
+ * идентификатором нет или запрос одновременно задаёт граф и его рёбра.
+ *
+ * Если в запросе есть поле "graph", то запрос получает вершины и рёбра
+ * загруженного графа, а поля запроса на загрузку дополняются полями
+ * запроса (например, "id" или "start").
+ */
+inline int ResolveGraphRequest(GraphStore* store, GraphRequest* request) {
+  if (!request->fields.contains("graph"))
+    return 0;
+
+  const nlohmann::json& handle = request->fields.at("graph");
+  if (!handle.is_string() || request->NumVertices() > 0 ||
+      request->NumEdges() > 0)
+    return -1;
+
+  std::shared_ptr<StoredGraph> graph = store->Find(handle);
+  if (!graph)
+    return -1;
+
+  // Граф нельзя менять, пока запрос его использует.
+  graph = StoredGraph::ReadLock(std::move(graph));
+
+  nlohmann::json fields = graph->Request().fields;
+  for (const auto& field : request->fields.items())
+    if (field.key() != "graph")
+      fields[field.key()] = field.value();
+
+  request->fields = std::move(fields);
+  request->stored = std::move(graph);
+  return 0;
+}
+
+/**
+ * @brief Аллокатор для графов, которые метод строит во время запроса.
+ *
+ * @tparam T Тип графа.
+ *
+ * @param request Запрос.
+ *
+ * Если у запроса есть арена (см. RunGraphMethod()) и граф умеет брать
+ * память из std::pmr::memory_resource, то аллокатор выделяет память
+ * в арене. Иначе возвращается аллокатор по умолчанию.
+ */
+template<class T>
+typename T::allocator_type GraphAllocator(const GraphRequest& request) {
+  using Allocator = typename T::allocator_type;
+
+  if constexpr (std::is_constructible<Allocator,
+                                      std::pmr::memory_resource*>::value) {
+    if (request.memory)
+      return Allocator(request.memory);
+  }
+
+  return Allocator();
+}
+
+/**
+ * @brief Получить граф запроса.
+ *
+ * @tparam T Тип графа.
+ *
+ * @param request Запрос.
+ * @param numVertices Сколько первых вершин добавить в граф.
+ * @param numEdges Сколько первых рёбер добавить в граф.
+ * @param local Граф, который заполняется, если граф не загружен заранее
+ *        (обычно создан с аллокатором GraphAllocator()).
+ * @param graph Указатель на граф (local или граф из хранилища).
+ * @return Функция возвращает 0 в случае успеха и -1, если граф не
+ * удалось построить (см. FillGraph()).
+ *
+ * Загруженный граф уже построен, поэтому метод использует его без
+ * копирования.
+ */
+template<class T>
+int GetGraph(const GraphRequest& request, size_t numVertices,
+             size_t numEdges, T* local, const T** graph) {
+  if (request.stored)
+    return request.stored->Get(numVertices, numEdges, graph);
+
+  *graph = local;
+  return FillGraph(request, numVertices, numEdges, local);
+}
+
+/**
+ * @brief Получить CSR представление графа запроса.
+ *
+ * @tparam T Тип графа, который задаёт запрос.
+ * @tparam Weight Тип веса рёбер CSR графа.
+ *
+ * @param request Запрос.
+ * @param numVertices Сколько первых вершин взять.
+ * @param numEdges Сколько первых рёбер взять.
+ * @param csr Результат.
+ * @return Функция возвращает 0 в случае успеха и -1, если граф не
+ * удалось построить (см. FillGraph()) или поле "threads" задано
+ * некорректно.
+ *
+ * Результат тот же, что у CsrGraph, построенного из графа T, который
+ * заполнен функцией GetGraph(). Но если граф не загружен заранее, то
+ * промежуточный граф T не строится: CSR граф собирается прямо из рёбер
+ * запроса несколькими потоками (см. ParallelCsrBuilder). Количество
+ * потоков задаёт поле "threads" запроса (см. ReadNumThreads()).
+ */
+template<class T, typename Weight>
+int GetCsrGraph(const GraphRequest& request, size_t numVertices,
+                size_t numEdges, CsrGraph<Weight>* csr) {
+  size_t threads;
+  if (ReadNumThreads(request, &threads) < 0)
+    return -1;
+
+  if (request.stored) {
+    const T* graph;
+    if (request.stored->Get(numVertices, numEdges, &graph) < 0)
+      return -1;
+
+    *csr = CsrGraph<Weight>(*graph);
+    return 0;
+  }
+
+  if (numVertices > request.NumVertices() || numEdges > request.NumEdges())
+    return -1;
+
+  std::vector<size_t> vertices(numVertices);
+  for (size_t i = 0; i < numVertices; i++)
+    vertices[i] = request.Vertex(i);
+
+  const ParallelCsrBuilder builder(threads);
+  const bool undirected = IsUndirectedGraph<T>::value;
+
+  if constexpr (IsWeightedGraph<T>::value) {
+    using Iterator = RequestEdgeIterator<typename T::WeightType>;
+
+    if (numEdges > 0 && !request.HasWeights())
+      return -1;
+
+    *csr = builder.Build<Weight>(Iterator(&request, 0),
+                                 Iterator(&request, numEdges), undirected,
+                                 vertices);
+  } else {
+    using Iterator = RequestEdgeIterator<>;
+
+    *csr = builder.Build<Weight>(Iterator(&request, 0),
+                                 Iterator(&request, numEdges), undirected,
+                                 vertices);
+  }
+
+  return 0;
+}
+
+//! Наибольший размер первого блока арены запроса.
+constexpr size_t kMaxArenaInitialSize = size_t{64} << 20;
+
+/**
+ * @brief Выполнить метод в арене запроса.
+ *
+ * @param method Метод.
+ * @param input Входные данные.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает то же, что и метод.
+ *
+ * Все узлы графа, который метод строит из запроса, освобождаются вместе
+ * по окончании метода, поэтому они берутся из арены
+ * std::pmr::monotonic_buffer_resource: выделение памяти - сдвиг
+ * указателя, освобождение отдельных узлов ничего не делает, а арена
+ * возвращает память несколькими большими блоками. Первый блок
+ * рассчитан на размер запроса. Куча долго работающего сервера при этом
+ * не фрагментируется мелкими блоками.
+ */
+inline int RunInArena(int (*method)(const GraphRequest&, nlohmann::json*),
+                      GraphRequest* input, nlohmann::json* output) {
+  const size_t initialSize = std::min(
+      kMaxArenaInitialSize,
+      std::max<size_t>(4096, 64 * (input->NumVertices() +
+                                   2 * input->NumEdges())));
+  std::pmr::monotonic_buffer_resource arena(initialSize);
+
+  input->memory = &arena;
+  int status;
+  try {
+    status = method(*input, output);
+  } catch (...) {
+    input->memory = nullptr;
+    throw;
+  }
+  input->memory = nullptr;
+
+  return status;
+}
+
+/**
+ * @brief Выполнить метод с запоминанием результата.
+ *
+ * @param method Метод.
+ * @param endpoint Адрес метода.
+ * @param dependency От чего зависит результат метода.
+ * @param input Входные данные.
+ * @param cache Кэш результатов для запросов с вершинами и рёбрами.
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает то же, что и метод.
+ *
+ * Метод выполняется в собственной арене (см. RunInArena()). Если запрос
+ * использует загруженный граф, то результат метода
+ * запоминается для текущей версии графа, и такой же запрос к той же
+ * версии получает его без повторного выполнения метода. Результаты
+ * остальных запросов запоминаются в cache: повторный запрос с тем же
+ * графом и теми же параметрами получает ответ без построения графа,
+ * отличается только поле "id".
+ */
+inline int RunGraphMethod(int (*method)(const GraphRequest&,
+                                        nlohmann::json*),
+                          const std::string& endpoint,
+                          ResultDependency dependency,
+                          GraphRequest* input, ResultCache* cache,
+                          nlohmann::json* output) {
+  if (!input->stored) {
+    std::string key;
+    if (cache->MemoryBudget() == 0 ||
+        !ResultCache::MakeKey(endpoint, *input, &key))
+      return RunInArena(method, input, output);
+
+    if (cache->Find(key, *input, output)) {
+      (*output)["id"] = input->fields.at("id");
+      return 0;
+    }
+
+    const int status = RunInArena(method, input, output);
+    if (status == 0)
+      cache->Save(key, *input, *output);
+    return status;
+  }
+
+  // Поле "id" не входит в ключ: запросы с разными "id" получают один и
+  // тот же результат.
+  nlohmann::json fields = input->fields;
+  fields.erase("id");
+
+  const std::string key = endpoint + " " + fields.dump();
+  if (input->stored->FindResult(key, output)) {
+    if (input->fields.contains("id"))
+      (*output)["id"] = input->fields.at("id");
+    return 0;
+  }
+
+  const int status = RunInArena(method, input, output);
+  if (status == 0)
+    input->stored->SaveResult(key, dependency, *output);
+  return status;
+}
+
+}  // namespace graph
+
+#endif  // METHODS_GRAPH_STORE_HPP_
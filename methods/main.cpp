@@ -7,8 +7,14 @@
 
 #include <httplib.h>
 #include <iostream>
+#include <memory>
+#include <string>
+#include <utility>
 #include <nlohmann/json.hpp>
+#include "batch.hpp"
+#include "graph_request.hpp"
 #include "methods.hpp"
+#include "server.hpp"
 
 using graph::TopologicalSortingMethod;
 using graph::CutPointsMethod;
@@ -17,21 +23,58 @@ using graph::FindBridgesMethod;
 using graph::MaximalMethod;
 using graph::NegCycleMethod;
 using graph::BelmanfMethod;
+using graph::BiconnectedMethod;
+using graph::ConcurrencyLimiter;
+using graph::ConfigureServer;
+using graph::GraphMethods;
+using graph::GraphPatch;
+using graph::GraphServer;
+using graph::GraphRequest;
+using graph::GraphStore;
+using graph::IsBinaryGraphType;
+using graph::kDependsOnTopology;
+using graph::kDependsOnWeights;
+using graph::ParseServerOptions;
+using graph::ReadGraphPatch;
+using graph::ReadGraphRequest;
+using graph::RunBatch;
+using graph::ResultCache;
+using graph::RunGraphMethod;
+using graph::ServerOptions;
+using graph::StoredGraph;
+using graph::ThreadPool;
+using graph::WriteGraphResponse;
 
 int main(int argc, char* argv[]) {
-  // Порт по-умолчанию.
-  int port = 2022;
-
-  if (argc >= 2) {
-    // Меняем порт по умолчанию, если предоставлен соответствующий
-    // аргумент командной строки.
-    if (std::sscanf(argv[1], "%d", &port) != 1)
-      return -1;
+  // Параметры по умолчанию меняются аргументами командной строки
+  // (см. ParseServerOptions()).
+  ServerOptions options;
+
+  if (ParseServerOptions(argc, argv, &options) < 0) {
+    std::cerr << "Invalid command line options" << std::endl;
+    return -1;
   }
 
-  std::cerr << "Listening on port " << port << "..." << std::endl;
+  std::cerr << "Listening on port " << options.port << " with "
+            << options.workers << " workers..." << std::endl;
+
+  GraphServer svr;
+  ConfigureServer(options, &svr);
+
+  // Если к методу уже выполняется слишком много запросов, то новые
+  // запросы к нему сразу получают ответ 503.
+  const ConcurrencyLimiter limiter(options.endpointLimit,
+                                   options.endpointLimits);
+
+  // Графы, загруженные запросом POST /graphs. Методы получают их
+  // по идентификатору из поля "graph" запроса.
+  GraphStore store(options.graphMemory);
 
-  httplib::Server svr;
+  // Результаты методов для повторяющихся запросов.
+  ResultCache cache(options.resultCacheMemory);
+
+  // Потоки для пакетных запросов /Batch, общие для всех пакетов.
+  ThreadPool batchPool(options.batchThreads);
 
   // Обработчик для GET запроса по адресу /stop. Этот обработчик
   // останавливает сервер.
@@ -39,166 +82,314 @@ int main(int argc, char* argv[]) {
     svr.stop();
   });
 
+  /* /graphs это адрес для загрузки графа на сервер. Тело запроса имеет
+  тот же формат, что и у методов. В ответ приходит идентификатор графа,
+  который можно передавать методам в поле "graph" вместо вершин и рёбер. */
+  svr.Post("/graphs", limiter.Wrap("/graphs",
+      [&](const httplib::Request& req, httplib::Response& res) {
+    auto graph = std::make_shared<StoredGraph>();
+    std::string handle;
+    nlohmann::json output;
+
+    if (graph->Load(req.body,
+                    IsBinaryGraphType(req.get_header_value("Content-Type")))
+        < 0) {
+      res.status = 400;
+      return;
+    }
+
+    output["numVertices"] = graph->Request().NumVertices();
+    output["numEdges"] = graph->Request().NumEdges();
+
+    /* Граф больше, чем вся память, отведённая для графов. */
+    if (store.Add(graph, &handle) < 0) {
+      res.status = 413;
+      return;
+    }
+
+    output["graph"] = handle;
+    res.set_content(output.dump(), "application/json");
+  }));
+
+  /* Состояние хранилища графов. */
+  svr.Get("/graphs", [&](const httplib::Request&, httplib::Response& res) {
+    nlohmann::json output;
+    output["graphs"] = store.Size();
+    output["memory"] = store.MemoryUsage();
+    output["memoryBudget"] = store.MemoryBudget();
+    res.set_content(output.dump(), "application/json");
+  });
+
+  /* Состояние кэша результатов: по счётчикам hits и misses можно
+  подобрать его размер (параметр --result-cache). */
+  svr.Get("/cache", [&](const httplib::Request&, httplib::Response& res) {
+    nlohmann::json output;
+    output["hits"] = cache.Hits();
+    output["misses"] = cache.Misses();
+    output["entries"] = cache.Size();
+    output["memory"] = cache.MemoryUsage();
+    output["memoryBudget"] = cache.MemoryBudget();
+    res.set_content(output.dump(), "application/json");
+  });
+
+  /* Изменить загруженный граф: удалить и добавить вершины и рёбра (см.
+  ReadGraphPatch()). Запомненные результаты методов, которые не могут
+  измениться, сохраняются. */
+  svr.Patch(R"(/graphs/(\w+))", limiter.Wrap("/graphs",
+      [&](const httplib::Request& req, httplib::Response& res) {
+    std::shared_ptr<StoredGraph> graph = store.Find(req.matches[1].str());
+    GraphPatch patch;
+
+    if (!graph) {
+      res.status = 404;
+      return;
+    }
+
+    if (ReadGraphPatch(req.body, &patch) < 0 || graph->Patch(patch) < 0) {
+      res.status = 400;
+      return;
+    }
+
+    graph = StoredGraph::ReadLock(std::move(graph));
+    nlohmann::json output;
+    output["graph"] = req.matches[1].str();
+    output["version"] = graph->Version();
+    output["numVertices"] = graph->Request().NumVertices();
+    output["numEdges"] = graph->Request().NumEdges();
+    res.set_content(output.dump(), "application/json");
+  }));
+
+  /* Удалить загруженный граф. */
+  svr.Delete(R"(/graphs/(\w+))",
+             [&](const httplib::Request& req, httplib::Response& res) {
+    if (!store.Remove(req.matches[1].str()))
+      res.status = 404;
+  });
+
+  /* Методы, доступные в пакетных запросах. */
+  const GraphMethods methods = {
+    {"/FindBridges", {FindBridgesMethod, kDependsOnTopology}},
+    {"/TopologicalSorting", {TopologicalSortingMethod, kDependsOnTopology}},
+    {"/CutPoints", {CutPointsMethod, kDependsOnTopology}},
+    {"/Biconnected", {BiconnectedMethod, kDependsOnTopology}},
+    {"/Maximal", {MaximalMethod, kDependsOnWeights}},
+    {"/NegCycle", {NegCycleMethod, kDependsOnWeights}},
+    {"/Belmanf", {BelmanfMethod, kDependsOnWeights}},
+    {"/Dinic", {DinicMethod, kDependsOnWeights}},
+  };
+
+  /* /Batch это адрес для пакетных запросов: тело запроса - массив
+  объектов {"method": "/CutPoints", "input": {...}}, где input - обычный
+  запрос к методу. Запросы выполняются параллельно, ответ - массив
+  объектов {"status": код, "output": ответ метода} в том же порядке.
+  Каждый запрос пакета ждёт места у своего метода в limiter. */
+  svr.Post("/Batch", limiter.Wrap("/Batch",
+      [&](const httplib::Request& req, httplib::Response& res) {
+    nlohmann::json output;
+
+    if (RunBatch(req.body, methods, &store, &cache, &limiter, &batchPool,
+                 &output) < 0) {
+      res.status = 400;
+      return;
+    }
+
+    res.set_content(output.dump(), "application/json");
+  }));
+
   /* Сюда нужно вставить обработчик post запроса для алгоритма. */
 /* /FindBridges это адрес для запросов на сортировку вставками
   на сервере. */
-  svr.Post("/FindBridges", [&](const httplib::Request& req,
-                                 httplib::Response& res) {
+  svr.Post("/FindBridges", limiter.Wrap("/FindBridges",
+      [&](const httplib::Request& req, httplib::Response& res) {
     /*
     Поле body структуры httplib::Request содержит текст запроса.
-    Функция nlohmann::json::parse() используется для того,
-    чтобы преобразовать текст в объект типа nlohmann::json.
+    Функция ReadGraphRequest() читает его потоковым парсером: вершины
+    и рёбра сразу попадают в плоские векторы без построения nlohmann::json.
+    Если Content-Type равен application/x-graph, то запрос бинарный, и его
+    массивы читаются прямо из тела запроса.
     */
-    nlohmann::json input = nlohmann::json::parse(req.body);
+    GraphRequest input;
     nlohmann::json output;
 
     /* Если метод завершился с ошибкой, то выставляем статус 400. */
-    if (FindBridgesMethod(input, &output) < 0)
+    if (ReadGraphRequest(req, &store, &input) < 0 ||
+        RunGraphMethod(FindBridgesMethod, "/FindBridges", kDependsOnTopology,
+                       &input, &cache, &output) < 0)
       res.status = 400;
 
-    res.set_content(output.dump(), "application/json");
-  });
+    WriteGraphResponse(req, output, &res);
+  }));
 
   /* /TopologicalSorting это адрес для запросов на топологическую сортировку
   на сервере. */  
-  svr.Post("/TopologicalSorting", [&](const httplib::Request& req,
-                                 httplib::Response& res) {
+  svr.Post("/TopologicalSorting", limiter.Wrap("/TopologicalSorting",
+      [&](const httplib::Request& req, httplib::Response& res) {
     /*
     Поле body структуры httplib::Request содержит текст запроса.
-    Функция nlohmann::json::parse() используется для того,
-    чтобы преобразовать текст в объект типа nlohmann::json.
+    Функция ReadGraphRequest() читает его потоковым парсером: вершины
+    и рёбра сразу попадают в плоские векторы без построения nlohmann::json.
+    Если Content-Type равен application/x-graph, то запрос бинарный, и его
+    массивы читаются прямо из тела запроса.
     */
-    nlohmann::json input = nlohmann::json::parse(req.body);
+    GraphRequest input;
     nlohmann::json output;
 
     /* Если метод завершился с ошибкой, то выставляем статус 400. */
-    if (TopologicalSortingMethod(input, &output) < 0)
+    if (ReadGraphRequest(req, &store, &input) < 0 ||
+        RunGraphMethod(TopologicalSortingMethod, "/TopologicalSorting",
+                       kDependsOnTopology, &input, &cache, &output) < 0)
       res.status = 400;
 
     /*
-    Метод nlohmann::json::dump() используется для сериализации
-    объекта типа nlohmann::json в строку. Метод set_content()
-    позволяет задать содержимое ответа на запрос. Если передаются
-    JSON данные, то MIME тип следует выставить application/json.
+    Функция WriteGraphResponse() записывает ответ в формате JSON или,
+    если клиент прислал запрос в бинарном формате, в бинарном формате.
     */
-    res.set_content(output.dump(), "application/json");
-  });
+    WriteGraphResponse(req, output, &res);
+  }));
 
   /* /CutPoints это адрес для запросов
   на сервере. */
-  svr.Post("/CutPoints", [&](const httplib::Request& req,
-                                 httplib::Response& res) {
+  svr.Post("/CutPoints", limiter.Wrap("/CutPoints",
+      [&](const httplib::Request& req, httplib::Response& res) {
     /*
     Поле body структуры httplib::Request содержит текст запроса.
-    Функция nlohmann::json::parse() используется для того,
-    чтобы преобразовать текст в объект типа nlohmann::json.
+    Функция ReadGraphRequest() читает его потоковым парсером: вершины
+    и рёбра сразу попадают в плоские векторы без построения nlohmann::json.
+    Если Content-Type равен application/x-graph, то запрос бинарный, и его
+    массивы читаются прямо из тела запроса.
     */
-    nlohmann::json input = nlohmann::json::parse(req.body);
+    GraphRequest input;
     nlohmann::json output;
 
     /* Если метод завершился с ошибкой, то выставляем статус 400. */
-    if (CutPointsMethod(input, &output) < 0)
+    if (ReadGraphRequest(req, &store, &input) < 0 ||
+        RunGraphMethod(CutPointsMethod, "/CutPoints", kDependsOnTopology,
+                       &input, &cache, &output) < 0)
       res.status = 400;
 
     /*
-    Метод nlohmann::json::dump() используется для сериализации
-    объекта типа nlohmann::json в строку. Метод set_content()
-    позволяет задать содержимое ответа на запрос. Если передаются
-    JSON данные, то MIME тип следует выставить application/json.
+    Функция WriteGraphResponse() записывает ответ в формате JSON или,
+    если клиент прислал запрос в бинарном формате, в бинарном формате.
     */
-    res.set_content(output.dump(), "application/json");
-  });
+    WriteGraphResponse(req, output, &res);
+  }));
 
 
 /* /Maximal это адрес для запросов на Алгоритм Крускала. */
-  svr.Post("/Maximal", [&](const httplib::Request& req1,
-                                 httplib::Response& res1) {
+  svr.Post("/Maximal", limiter.Wrap("/Maximal",
+      [&](const httplib::Request& req1, httplib::Response& res1) {
     /*
     Поле body структуры httplib::Request содержит текст запроса.
-    Функция nlohmann::json::parse() используется для того,
-    чтобы преобразовать текст в объект типа nlohmann::json.
+    Функция ReadGraphRequest() читает его потоковым парсером: вершины
+    и рёбра сразу попадают в плоские векторы без построения nlohmann::json.
+    Если Content-Type равен application/x-graph, то запрос бинарный, и его
+    массивы читаются прямо из тела запроса.
     */
-    nlohmann::json input1 = nlohmann::json::parse(req1.body);
+    GraphRequest input1;
     nlohmann::json output1;
 
     /* Если метод завершился с ошибкой, то выставляем статус 400. */
-    if (MaximalMethod(input1, &output1) < 0)
+    if (ReadGraphRequest(req1, &store, &input1) < 0 ||
+        RunGraphMethod(MaximalMethod, "/Maximal", kDependsOnWeights,
+                       &input1, &cache, &output1) < 0)
       res1.status = 400;
 
     /*
-    Метод nlohmann::json::dump() используется для сериализации
-    объекта типа nlohmann::json в строку. Метод set_content()
-    позволяет задать содержимое ответа на запрос. Если передаются
-    JSON данные, то MIME тип следует выставить application/json.
+    Функция WriteGraphResponse() записывает ответ в формате JSON или,
+    если клиент прислал запрос в бинарном формате, в бинарном формате.
     */
-    res1.set_content(output1.dump(), "application/json");
-  });
+    WriteGraphResponse(req1, output1, &res1);
+  }));
   /* /NegCycle это адрес для запросов на поиск антицикла на сервере. */
-  svr.Post("/NegCycle", [&](const httplib::Request& req,
-                              httplib::Response& res) {
+  svr.Post("/NegCycle", limiter.Wrap("/NegCycle",
+      [&](const httplib::Request& req, httplib::Response& res) {
     /*
     Поле body структуры httplib::Request содержит текст запроса.
-    Функция nlohmann::json::parse() используется для того,
-    чтобы преобразовать текст в объект типа nlohmann::json.
+    Функция ReadGraphRequest() читает его потоковым парсером: вершины
+    и рёбра сразу попадают в плоские векторы без построения nlohmann::json.
+    Если Content-Type равен application/x-graph, то запрос бинарный, и его
+    массивы читаются прямо из тела запроса.
     */
-    nlohmann::json input = nlohmann::json::parse(req.body);
+    GraphRequest input;
     nlohmann::json output;
     /* Если метод завершился с ошибкой, то выставляем статус 400. */
-    if (NegCycleMethod(input, &output) < 0)
+    if (ReadGraphRequest(req, &store, &input) < 0 ||
+        RunGraphMethod(NegCycleMethod, "/NegCycle", kDependsOnWeights,
+                       &input, &cache, &output) < 0)
         res.status = 400;
     /*
-    Метод nlohmann::json::dump() используется для сериализации
-    объекта типа nlohmann::json в строку. Метод set_content()
-    позволяет задать содержимое ответа на запрос. Если передаются
-    JSON данные, то MIME тип следует выставить application/json.
+    Функция WriteGraphResponse() записывает ответ в формате JSON или,
+    если клиент прислал запрос в бинарном формате, в бинарном формате.
     */
-    res.set_content(output.dump(), "application/json");
-  });
+    WriteGraphResponse(req, output, &res);
+  }));
   /* /Belmanf это адрес для запросов на алгоритм Беллмана-Форда на сервере. */
-  svr.Post("/Belmanf", [&](const httplib::Request& req,
-                           httplib::Response& res) {
+  svr.Post("/Belmanf", limiter.Wrap("/Belmanf",
+      [&](const httplib::Request& req, httplib::Response& res) {
     /*
     Поле body структуры httplib::Request содержит текст запроса.
-    Функция nlohmann::json::parse() используется для того,
-    чтобы преобразовать текст в объект типа nlohmann::json.
+    Функция ReadGraphRequest() читает его потоковым парсером: вершины
+    и рёбра сразу попадают в плоские векторы без построения nlohmann::json.
+    Если Content-Type равен application/x-graph, то запрос бинарный, и его
+    массивы читаются прямо из тела запроса.
     */
-    nlohmann::json input = nlohmann::json::parse(req.body);
+    GraphRequest input;
     nlohmann::json output;
 
     /* Если метод завершился с ошибкой, то выставляем статус 400. */
-    if (BelmanfMethod(input, &output) < 0)
+    if (ReadGraphRequest(req, &store, &input) < 0 ||
+        RunGraphMethod(BelmanfMethod, "/Belmanf", kDependsOnWeights,
+                       &input, &cache, &output) < 0)
     res.status = 400;
 
     /*
-    Метод nlohmann::json::dump() используется для сериализации
-    объекта типа nlohmann::json в строку. Метод set_content()
-    позволяет задать содержимое ответа на запрос. Если передаются
-    JSON данные, то MIME тип следует выставить application/json.
+    Функция WriteGraphResponse() записывает ответ в формате JSON или,
+    если клиент прислал запрос в бинарном формате, в бинарном формате.
     */
-    res.set_content(output.dump(), "application/json");
-  });
+    WriteGraphResponse(req, output, &res);
+  }));
+
+  /* /Biconnected это адрес для запросов на поиск точек сочленения, мостов,
+  компонент рёберной двусвязности и блоков за один обход графа. */
+  svr.Post("/Biconnected", limiter.Wrap("/Biconnected",
+      [&](const httplib::Request& req, httplib::Response& res) {
+    GraphRequest input;
+    nlohmann::json output;
+
+    /* Если метод завершился с ошибкой, то выставляем статус 400. */
+    if (ReadGraphRequest(req, &store, &input) < 0 ||
+        RunGraphMethod(BiconnectedMethod, "/Biconnected", kDependsOnTopology,
+                       &input, &cache, &output) < 0)
+      res.status = 400;
+
+    WriteGraphResponse(req, output, &res);
+  }));
 
   /* /Dinic это адрес для запросов на алгоритм Диница. */
-    svr.Post("/Dinic", [&](const httplib::Request& req,
-                                 httplib::Response& res) {
+  svr.Post("/Dinic", limiter.Wrap("/Dinic",
+      [&](const httplib::Request& req, httplib::Response& res) {
     /*
     Поле body структуры httplib::Request содержит текст запроса.
-    Функция nlohmann::json::parse() используется для того,
-    чтобы преобразовать текст в объект типа nlohmann::json.
+    Функция ReadGraphRequest() читает его потоковым парсером: вершины
+    и рёбра сразу попадают в плоские векторы без построения nlohmann::json.
+    Если Content-Type равен application/x-graph, то запрос бинарный, и его
+    массивы читаются прямо из тела запроса.
     */
-    nlohmann::json input = nlohmann::json::parse(req.body);
+    GraphRequest input;
     nlohmann::json output;
 
     /* Если метод завершился с ошибкой, то выставляем статус 400. */
-    if (DinicMethod(input, &output) < 0)
+    if (ReadGraphRequest(req, &store, &input) < 0 ||
+        RunGraphMethod(DinicMethod, "/Dinic", kDependsOnWeights,
+                       &input, &cache, &output) < 0)
       res.status = 400;
 
-    res.set_content(output.dump(), "application/json");
-  });
+    WriteGraphResponse(req, output, &res);
+  }));
 
 
 // Эта функция запускает сервер на указанном порту. Программа не завершится
 // до тех пор, пока сервер не будет остановлен.
-  svr.listen("0.0.0.0", port);
+  svr.listen("0.0.0.0", options.port);
   return 0;
 }
@@ -2,21 +2,23 @@
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include "maximal.hpp"
+#include "boruvka.hpp"
 #include "iterators.hpp"
+#include "graph_store.hpp"
 namespace graph {
 
 template<typename T>
-static int MaximalMethodHelper(const nlohmann::json& input,
+static int MaximalMethodHelper(const GraphRequest& input,
                                      nlohmann::json* output,
                                      std::string type);
 
-int MaximalMethod(const nlohmann::json& input, nlohmann::json* output) {
+int MaximalMethod(const GraphRequest& input, nlohmann::json* output) {
   /*
   С классом nlohmann::json можно работать как со словарём.
   Метод at() в отличие оператора [] не меняет объект, поэтому
   этот метод можно использовать с константными объектами.
   */
-  std::string type = input.at("type");
+  std::string type = input.fields.at("type");
 
   /* Пока реализована только поддержка целых чисел и чисел типа double. */
   if (type == "int") {
@@ -49,30 +51,44 @@ int MaximalMethod(const nlohmann::json& input, nlohmann::json* output) {
  * типов данных.
  */
 template<typename T>
-static int MaximalMethodHelper(const nlohmann::json& input,
+static int MaximalMethodHelper(const GraphRequest& input,
                                      nlohmann::json* output,
                                      std::string type) {
-  (*output)["id"] = input.at("id");
+  (*output)["id"] = input.fields.at("id");
   (*output)["type"] = type;
 
-  size_t size = input.at("size").at(0);
-  size_t n = input.at("size").at(1);
+  size_t size = input.fields.at("size").at(0);
+  size_t n = input.fields.at("size").at(1);
   if (n*size == 0) {
     (*output)["size"] = 0;
     (*output)["data"] = nullptr;
       return 0;
   }
 
-  /* Для словарей используется индекс в виде строки,
-    а для массивов просто целое число типа size_t. */
-  WeightedGraph<T> wGraph;
-  for (size_t i = 0; i < size; i++)
-    wGraph.AddEdge(static_cast<size_t>(input.at("data").at(i*3+1)),
-                   static_cast<size_t>(input.at("data").at(i*3+2)),
-                   input.at("data").at(i*3));
+  /*
+  Поле "algorithm" необязательное: "kruskal" (по умолчанию) или
+  "boruvka" (параллельный алгоритм Борувки). Для алгоритма Борувки
+  можно задать количество потоков полем "threads".
+  */
+  std::string algorithm = "kruskal";
+  size_t threads = 0;
+  if (input.fields.contains("algorithm"))
+    algorithm = input.fields.at("algorithm");
+  if (ReadNumThreads(input, &threads) < 0)
+    return -1;
+  if (algorithm != "kruskal" && algorithm != "boruvka")
+    return -1;
+
+  /* Тройки (вес, откуда, куда) из поля "data" уже прочитаны из запроса
+    в плоские векторы (или граф загружен заранее). */
+  WeightedGraph<T> local(GraphAllocator<WeightedGraph<T>>(input));
+  const WeightedGraph<T>* wGraph;
+  if (GetGraph(input, 0, size, &local, &wGraph) < 0)
+    return -1;
 
-  /* Здесь вызывается сам алгоритм Крускала. */
-  Graph ostov = Maximal(wGraph);
+  /* Здесь вызывается сам алгоритм Крускала (или Борувки). */
+  Graph ostov = algorithm == "boruvka" ? Boruvka(*wGraph, threads)
+                                       : Maximal(*wGraph);
   std::vector <std::pair<size_t, size_t>> edges;
   for (size_t v : ostov.Vertices()) {
     for (size_t neighbour : ostov.Edges(v)) {
@@ -10,12 +10,15 @@
 #ifndef METHODS_METHODS_HPP_
 #define METHODS_METHODS_HPP_
 
+#include <nlohmann/json.hpp>
+#include "graph_request.hpp"
+
 namespace graph {
 /* Сюда нужно вставить объявление серверной части алгоритма. */
 /**
  * @brief Метод поиска мостов.
  *
- * @param input Входные данные в формате JSON.
+ * @param input Входные данные, прочитанные функцией ReadGraphRequest().
  * @param output Выходные данные в формате JSON.
  * @return Функция возвращает 0 в случае успеха и отрицательное число
  * если входные данные заданы некорректно.
@@ -30,37 +33,40 @@ namespace graph {
 
  * @brief Метод поиска точек сочленения.
  *
- * @param input Входные данные в формате JSON.
+ * @param input Входные данные, прочитанные функцией ReadGraphRequest().
  * @param output Выходные данные в формате JSON.
  * @return Функция возвращает 0 в случае успеха и отрицательное число
  * если входные данные заданы некорректно.
  *
  * Функция запускает алгоритм топологической сортировки, используя входные данные
- * в JSON формате. Результат также выдаётся в JSON формате.
+ * в JSON формате. Результат также выдаётся в JSON формате. Необязательное
+ * поле "algorithm" ("dfs" или "kahn") выбирает алгоритм.
  */
-int TopologicalSortingMethod(const nlohmann::json& input,
+int TopologicalSortingMethod(const GraphRequest& input,
                              nlohmann::json* output);
-int CutPointsMethod(const nlohmann::json& input, nlohmann::json* output);
+int CutPointsMethod(const GraphRequest& input, nlohmann::json* output);
 /**
  * @brief Метод Диница.
  *
  * @tparam T Тип графа.
  *
- * @param input Входные данные в формате JSON.
+ * @param input Входные данные, прочитанные функцией ReadGraphRequest().
  * @param output Выходные данные в формате JSON.
  * @param type Строковое представление типа данных мортируемых элементов.
  *
  * Функция запускает алгоритм поиска мостов, используя входные данные
  * в JSON формате. Результат также выдаётся в JSON формате. Функция
  * используется для сокращения кода, необходимого для поддержки различных типов данных.
+ * Необязательное поле "algorithm" ("dinic" или "push_relabel") выбирает
+ * алгоритм; по умолчанию он выбирается по плотности сети.
  */
-int DinicMethod(const nlohmann::json& input, nlohmann::json* output);
-int FindBridgesMethod(const nlohmann::json& input, nlohmann::json* output);
+int DinicMethod(const GraphRequest& input, nlohmann::json* output);
+int FindBridgesMethod(const GraphRequest& input, nlohmann::json* output);
 
 /**
  * @brief Алгоритм Крускала.
  *
- * @param input Входные данные в формате JSON.
+ * @param input Входные данные, прочитанные функцией ReadGraphRequest().
  * @param output Выходные данные в формате JSON.
  * @return Функция возвращает 0 в случае успеха и отрицательное число
  * если входные данные заданы некорректно.
@@ -69,7 +75,7 @@ int FindBridgesMethod(const nlohmann::json& input, nlohmann::json* output);
  * в JSON формате. Результат также выдаётся в JSON формате.
  */
 
-int MaximalMethod(const nlohmann::json& input, nlohmann::json* output);
+int MaximalMethod(const GraphRequest& input, nlohmann::json* output);
 
 /**
  * @brief Метод поиска цикла отрицательного веса.
@@ -77,7 +83,7 @@ int MaximalMethod(const nlohmann::json& input, nlohmann::json* output);
  * @tparam T Тип графа.
  * @tparam Weight Тип веса ребер графа.
  *
- * @param input Входные данные в формате JSON.
+ * @param input Входные данные, прочитанные функцией ReadGraphRequest().
  * @param output Выходные данные в формате JSON.
  * @param type Строковое представление типа данных мортируемых элементов.
  * @return Функция возвращает 0 в случае успеха и отрицательное число
@@ -87,8 +93,22 @@ int MaximalMethod(const nlohmann::json& input, nlohmann::json* output);
  * в JSON формате. Результат также выдаётся в JSON формате. Функция
  * используется для сокращения кода, необходимого для поддержки различных типов данных.
 **/
-int NegCycleMethod(const nlohmann::json& input, nlohmann::json* output);
-int BelmanfMethod(const nlohmann::json& input, nlohmann::json* output);
+int NegCycleMethod(const GraphRequest& input, nlohmann::json* output);
+int BelmanfMethod(const GraphRequest& input, nlohmann::json* output);
+
+/**
+ * @brief Метод поиска точек сочленения, мостов, компонент рёберной
+ * двусвязности и блоков.
+ *
+ * @param input Входные данные, прочитанные функцией ReadGraphRequest().
+ * @param output Выходные данные в формате JSON.
+ * @return Функция возвращает 0 в случае успеха и отрицательное число
+ * если входные данные заданы некорректно.
+ *
+ * Все результаты вычисляются за один обход графа. Необязательное поле
+ * "outputs" выбирает, какие из них вернуть.
+ */
+int BiconnectedMethod(const GraphRequest& input, nlohmann::json* output);
 
 /* Конец вставки. */
 }  // namespace graph
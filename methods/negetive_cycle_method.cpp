@@ -9,20 +9,21 @@
 #include <string>
 #include <nlohmann/json.hpp>
 #include "negetive_cycle.hpp"
+#include "graph_store.hpp"
 
 namespace graph {
 
 template<class T>
-static int NegCycleMethodHelper(const nlohmann::json& input,
+static int NegCycleMethodHelper(const GraphRequest& input,
                                 nlohmann::json* output, std::string type);
-int NegCycleMethod(const nlohmann::json& input, nlohmann::json* output) {
+int NegCycleMethod(const GraphRequest& input, nlohmann::json* output) {
     /* 
     С классом nlohmann::json можно работать как со словарём.
     Метод at() в отличие оператора [] не меняет объект, поэтому
     этот метод можно использовать с константными объектами. 
     */
-    std::string type = input.at("type");
-    std::string typeweight = input.at("TypeWeights");
+    std::string type = input.fields.at("type");
+    std::string typeweight = input.fields.at("TypeWeights");
     /* Пока реализована только поддержка для взвешенных 
     ориентированных графов.*/
     if (type == "weighted_oriented_graph") {
@@ -55,44 +56,57 @@ int NegCycleMethod(const nlohmann::json& input, nlohmann::json* output) {
  * @return Функция возвращает 0 в случае успеха и отрицательное число
  * если входные данные заданы некорректно.
  *
- * Функция запускает алгоритм сортировки вставками, используя входные данные
+ * Функция запускает алгоритм поиска антицикла, используя входные данные
  * в JSON формате. Результат также выдаётся в JSON формате. Функция
  * используется для сокращения кода, необходимого для поддержки различных типов данных.
+ * Номера вершин могут быть любыми, в том числе нулевыми.
 **/
 
 template<class T>
-static int NegCycleMethodHelper(const nlohmann::json& input,
+static int NegCycleMethodHelper(const GraphRequest& input,
                                 nlohmann::json* output, std::string type) {
-    (*output)["id"] = input.at("id");
-    size_t size = input.at("size");
-    size_t numEdges = input.at("numEdges");
+    (*output)["id"] = input.fields.at("id");
+    size_t size = input.fields.at("size");
+    size_t numEdges = input.fields.at("numEdges");
     if (numEdges == 0) {
         (*output)["size"] = size;
         (*output)["type"] = type;
         return -1;
     }
-    T graph;
+    /*
+    Поле "algorithm" необязательное: "tarjan" (по умолчанию, разборка
+    поддеревьев), "spfa" или "bellman_ford".
+    */
+    std::string algorithm = "tarjan";
+    if (input.fields.contains("algorithm"))
+        algorithm = input.fields.at("algorithm");
+    if (algorithm != "tarjan" && algorithm != "spfa" &&
+        algorithm != "bellman_ford")
+        return -1;
     // path - вектор, в котором хранится ответ
     std::vector<size_t> path;
-    for (size_t i = 0; i < size; i++) {
-        /* Для словарей используется индекс в виде строки,
-        а для массивов просто целое число типа size_t. */
-        size_t el = input.at("vertices").at(i);
-        if (el != 0) {
-            graph.AddVertex(el);
-        }
-    }
-    // Добавляем ребра
-    for (size_t j = 0; j < numEdges; j++) {
-        graph.AddEdge(input.at("edges").at(j).at(0),
-                      input.at("edges").at(j).at(1),
-                      input.at("edges").at(j).at(2));
-    }
+    // Строим CSR граф из вершин и рёбер, уже прочитанных из запроса
+    // (или из графа, загруженного заранее), в несколько потоков (их
+    // количество можно задать полем "threads")
+    CsrGraph<typename T::WeightType> csr;
+    if (GetCsrGraph<T>(input, size, numEdges, &csr) < 0)
+        return -1;
     /* Здесь вызывается сам алгоритм поиска антицикла. */
-    NegCycle(size, graph, &path);
+    std::vector<size_t> cycle;
+    bool found;
+    if (algorithm == "bellman_ford")
+        found = NegCycleBellmanFord(csr, &cycle);
+    else if (algorithm == "spfa")
+        found = NegCycleSpfa(csr, &cycle);
+    else
+        found = NegCycleTarjan(csr, &cycle);
+    if (found)
+        for (size_t v : cycle)
+            path.push_back(csr.Id(v));
     /* Сохраняем в ответе результат работы алгоритма. */
     (*output)["size"] = size;
     (*output)["type"] = type;
+    (*output)["algorithm"] = algorithm;
     if (path.size() == 0) {
         (*output)["data"] = nullptr;
     } else {
@@ -0,0 +1,428 @@
+/**
+ * @file methods/result_cache.hpp
+ *
+ * Кэш результатов методов для повторяющихся запросов. Запрос сводится
+ * к ключу: адрес метода, поля запроса (кроме "id") и 64-битный хэш
+ * вершин, рёбер и весов, посчитанный по схеме xxHash64. Вместе с
+ * результатом хранится сам граф, и при совпадении ключей графы
+ * сравниваются целиком, поэтому коллизия хэша не приводит к чужому
+ * ответу. Если такой же запрос уже выполнялся, то ответ берётся из кэша
+ * без построения графа и без запуска алгоритма.
+ */
+
+#ifndef METHODS_RESULT_CACHE_HPP_
+#define METHODS_RESULT_CACHE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <nlohmann/json.hpp>
+#include "graph_request.hpp"
+
+namespace graph {
+
+/**
+ * @brief Потоковый 64-битный хэш по схеме xxHash64.
+ *
+ * Данные подаются 64-битными словами. Результат совпадает с XXH64
+ * от последовательности слов, записанных в порядке little-endian.
+ */
+class Hasher64 {
+ public:
+  /**
+   * @brief Конструктор.
+   *
+   * @param seed Начальное значение.
+   */
+  explicit Hasher64(uint64_t seed = 0) :
+    seed(seed),
+    lanes{seed + kPrime1 + kPrime2, seed + kPrime2, seed, seed - kPrime1},
+    buffer{},
+    buffered(0),
+    total(0) {
+  }
+
+  /**
+   * @brief Добавить слово.
+   *
+   * @param word Слово.
+   */
+  void Add(uint64_t word) {
+    buffer[buffered++] = word;
+    total++;
+
+    if (buffered == 4) {
+      for (size_t i = 0; i < 4; i++)
+        lanes[i] = Round(lanes[i], buffer[i]);
+      buffered = 0;
+    }
+  }
+
+  /**
+   * @brief Добавить строку (длину и байты, дополненные нулями до слова).
+   *
+   * @param text Строка.
+   */
+  void Add(const std::string& text) {
+    Add(static_cast<uint64_t>(text.size()));
+
+    for (size_t i = 0; i < text.size(); i += 8) {
+      unsigned char bytes[8] = {};
+      std::memcpy(bytes, text.data() + i,
+                  std::min<size_t>(8, text.size() - i));
+      Add(LoadLittleEndian<uint64_t>(bytes));
+    }
+  }
+
+  /**
+   * @brief Функция возвращает хэш всех добавленных слов.
+   */
+  uint64_t Finish() const {
+    uint64_t hash;
+
+    if (total >= 4) {
+      hash = Rotate(lanes[0], 1) + Rotate(lanes[1], 7) +
+             Rotate(lanes[2], 12) + Rotate(lanes[3], 18);
+      for (size_t i = 0; i < 4; i++)
+        hash = Merge(hash, lanes[i]);
+    } else {
+      hash = seed + kPrime5;
+    }
+
+    hash += 8 * total;
+    for (size_t i = 0; i < buffered; i++) {
+      hash ^= Round(0, buffer[i]);
+      hash = Rotate(hash, 27) * kPrime1 + kPrime4;
+    }
+
+    hash ^= hash >> 33;
+    hash *= kPrime2;
+    hash ^= hash >> 29;
+    hash *= kPrime3;
+    hash ^= hash >> 32;
+    return hash;
+  }
+
+ private:
+  static constexpr uint64_t kPrime1 = 0x9E3779B185EBCA87ULL;
+  static constexpr uint64_t kPrime2 = 0xC2B2AE3D27D4EB4FULL;
+  static constexpr uint64_t kPrime3 = 0x165667B19E3779F9ULL;
+  static constexpr uint64_t kPrime4 = 0x85EBCA77C2B2AE63ULL;
+  static constexpr uint64_t kPrime5 = 0x27D4EB2F165667C5ULL;
+
+  static uint64_t Rotate(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+  }
+
+  static uint64_t Round(uint64_t lane, uint64_t word) {
+    return Rotate(lane + word * kPrime2, 31) * kPrime1;
+  }
+
+  static uint64_t Merge(uint64_t hash, uint64_t lane) {
+    return (hash ^ Round(0, lane)) * kPrime1 + kPrime4;
+  }
+
+  //! Начальное значение.
+  uint64_t seed;
+  //! Четыре независимых накопителя.
+  uint64_t lanes[4];
+  //! Слова, ещё не попавшие в накопители.
+  uint64_t buffer[4];
+  //! Количество слов в buffer.
+  size_t buffered;
+  //! Общее количество слов.
+  uint64_t total;
+};
+
+/**
+ * @brief Обойти вершины, рёбра и веса запроса как 64-битные слова.
+ *
+ * @param request Запрос.
+ * @param visit Функция visit(word), которая вызывается для каждого слова.
+ *
+ * Слова не зависят от формата запроса: одинаковые графы в JSON
+ * и в бинарном формате дают одинаковые слова. Веса сравниваются как
+ * числа double; 64-битные целые веса бинарного формата записываются
+ * отдельно, так как не все они точно представимы в double.
+ */
+template<typename Visit>
+void ForEachGraphWord(const GraphRequest& request, Visit visit) {
+  const size_t numVertices = request.NumVertices();
+  const size_t numEdges = request.NumEdges();
+
+  visit(numVertices);
+  for (size_t i = 0; i < numVertices; i++)
+    visit(request.Vertex(i));
+
+  visit(numEdges);
+  for (size_t i = 0; i < numEdges; i++) {
+    visit(request.EdgeSource(i));
+    visit(request.EdgeTarget(i));
+  }
+
+  if (!request.HasWeights()) {
+    visit(0);
+  } else if (request.packed && request.packedWeights == kInt64Weights) {
+    visit(2);
+    for (size_t i = 0; i < numEdges; i++)
+      visit(static_cast<uint64_t>(request.EdgeWeight<int64_t>(i)));
+  } else {
+    visit(1);
+    for (size_t i = 0; i < numEdges; i++) {
+      // +0.0 вместо -0.0, чтобы равные веса давали равные слова.
+      const double weight = request.EdgeWeight<double>(i) + 0.0;
+      uint64_t bits;
+      std::memcpy(&bits, &weight, sizeof(bits));
+      visit(bits);
+    }
+  }
+}
+
+/**
+ * @brief Посчитать хэш вершин, рёбер и весов запроса.
+ *
+ * @param request Запрос.
+ *
+ * Хэш считается по словам ForEachGraphWord().
+ */
+inline uint64_t HashGraphRequest(const GraphRequest& request) {
+  Hasher64 hasher;
+  ForEachGraphWord(request, [&](uint64_t word) { hasher.Add(word); });
+  return hasher.Finish();
+}
+
+/**
+ * @brief Упаковать вершины, рёбра и веса запроса в строку.
+ *
+ * @param request Запрос.
+ *
+ * Строка состоит из слов ForEachGraphWord() и нужна только для
+ * сравнения графов внутри процесса.
+ */
+inline std::string PackGraphRequest(const GraphRequest& request) {
+  std::string packed;
+  ForEachGraphWord(request, [&](uint64_t word) {
+    packed.append(reinterpret_cast<const char*>(&word), sizeof(word));
+  });
+  return packed;
+}
+
+/**
+ * @brief Проверить, что граф запроса совпадает с упакованным графом.
+ *
+ * @param packed Граф, упакованный функцией PackGraphRequest().
+ * @param request Запрос.
+ */
+inline bool SameGraphRequest(const std::string& packed,
+                             const GraphRequest& request) {
+  size_t offset = 0;
+  bool same = true;
+
+  ForEachGraphWord(request, [&](uint64_t word) {
+    if (!same || packed.size() - offset < sizeof(word) ||
+        std::memcmp(packed.data() + offset, &word, sizeof(word)) != 0)
+      same = false;
+    offset += sizeof(word);
+  });
+
+  return same && offset == packed.size();
+}
+
+/**
+ * @brief Кэш результатов методов с ограничением по памяти.
+ *
+ * При нехватке памяти удаляются результаты, которые дольше всего не
+ * запрашивались. Объект можно использовать из нескольких потоков.
+ */
+class ResultCache {
+ public:
+  /**
+   * @brief Конструктор.
+   *
+   * @param memoryBudget Максимальный объём памяти (байты), 0 - кэш
+   * выключен.
+   */
+  explicit ResultCache(size_t memoryBudget) :
+    memoryBudget(memoryBudget),
+    bytes(0),
+    hits(0),
+    misses(0) {
+  }
+
+  /**
+   * @brief Построить ключ запроса.
+   *
+   * @param endpoint Адрес метода.
+   * @param request Запрос.
+   * @param key Ключ.
+   * @return Функция возвращает false, если запрос нельзя кэшировать
+   * (в нём нет поля "id").
+   */
+  static bool MakeKey(const std::string& endpoint,
+                      const GraphRequest& request, std::string* key) {
+    if (request.fields.count("id") == 0)
+      return false;
+
+    nlohmann::json fields = request.fields;
+    fields.erase("id");
+
+    *key = endpoint + " " + std::to_string(HashGraphRequest(request)) + " " +
+           std::to_string(request.NumVertices()) + " " +
+           std::to_string(request.NumEdges()) + " " + fields.dump();
+    return true;
+  }
+
+  /**
+   * @brief Найти результат.
+   *
+   * @param key Ключ (см. MakeKey()).
+   * @param request Запрос, по которому построен ключ.
+   * @param output Результат.
+   * @return Функция возвращает true, если результат найден.
+   *
+   * Результат найден, только если граф запроса совпадает с графом,
+   * для которого результат был запомнен.
+   */
+  bool Find(const std::string& key, const GraphRequest& request,
+            nlohmann::json* output) {
+    if (memoryBudget == 0)
+      return false;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    if (it == entries.end() || !SameGraphRequest(it->second.graph, request)) {
+      misses++;
+      return false;
+    }
+
+    order.splice(order.begin(), order, it->second.position);
+    *output = it->second.output;
+    hits++;
+    return true;
+  }
+
+  /**
+   * @brief Запомнить результат.
+   *
+   * @param key Ключ (см. MakeKey()).
+   * @param request Запрос, по которому построен ключ.
+   * @param output Результат.
+   *
+   * Если под тем же ключом запомнен результат для другого графа
+   * (коллизия хэша), то он заменяется новым.
+   */
+  void Save(const std::string& key, const GraphRequest& request,
+            const nlohmann::json& output) {
+    if (memoryBudget == 0)
+      return;
+
+    std::string graph = PackGraphRequest(request);
+    const size_t size = kEntryOverhead + 2 * key.size() + graph.size() +
+                        output.dump().size();
+    if (size > memoryBudget)
+      return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(key);
+    if (it != entries.end()) {
+      if (it->second.graph == graph)
+        return;
+
+      bytes -= it->second.bytes;
+      order.erase(it->second.position);
+      entries.erase(it);
+    }
+
+    order.push_front(key);
+    entries.emplace(key, Entry{output, std::move(graph), size,
+                               order.begin()});
+    bytes += size;
+
+    while (bytes > memoryBudget) {
+      auto victim = entries.find(order.back());
+      bytes -= victim->second.bytes;
+      entries.erase(victim);
+      order.pop_back();
+    }
+  }
+
+  /**
+   * @brief Функция возвращает количество найденных результатов.
+   */
+  size_t Hits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+  }
+
+  /**
+   * @brief Функция возвращает количество ненайденных результатов.
+   */
+  size_t Misses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+  }
+
+  /**
+   * @brief Функция возвращает количество запомненных результатов.
+   */
+  size_t Size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+  }
+
+  /**
+   * @brief Функция возвращает оценку занимаемой памяти в байтах.
+   */
+  size_t MemoryUsage() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return bytes;
+  }
+
+  /**
+   * @brief Функция возвращает максимальный объём памяти в байтах.
+   */
+  size_t MemoryBudget() const {
+    return memoryBudget;
+  }
+
+ private:
+  //! Оценка памяти на служебные данные одного результата.
+  static constexpr size_t kEntryOverhead = 128;
+
+  //! Запомненный результат.
+  struct Entry {
+    //! Ответ метода.
+    nlohmann::json output;
+    //! Граф запроса (см. PackGraphRequest()).
+    std::string graph;
+    //! Оценка занимаемой памяти.
+    size_t bytes;
+    //! Позиция в order.
+    std::list<std::string>::iterator position;
+  };
+
+  //! Максимальный объём памяти.
+  size_t memoryBudget;
+  //! Ключи от недавно запрошенных к давно запрошенным.
+  std::list<std::string> order;
+  //! Результаты по ключам.
+  std::unordered_map<std::string, Entry> entries;
+  //! Занимаемая память.
+  size_t bytes;
+  //! Количество найденных результатов.
+  size_t hits;
+  //! Количество ненайденных результатов.
+  size_t misses;
+  //! Мьютекс для всех полей.
+  mutable std::mutex mutex;
+};
+
+}  // namespace graph
+
+#endif  // METHODS_RESULT_CACHE_HPP_
@@ -0,0 +1,656 @@
+/**
+ * @file methods/server.hpp
+ *
+ * Настройки HTTP сервера: параметры командной строки, пул рабочих потоков
+ * с ограниченной очередью, ограничение числа одновременных запросов
+ * к каждому методу, выбор формата (JSON или бинарный) запроса и ответа
+ * и подстановка в запрос графов, загруженных заранее.
+ */
+
+#ifndef METHODS_SERVER_HPP_
+#define METHODS_SERVER_HPP_
+
+#include <httplib.h>
+#include <cstddef>
+#include <ctime>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "binary_format.hpp"
+#include "graph_request.hpp"
+#include "graph_store.hpp"
+#include "parallel.hpp"
+
+namespace graph {
+
+/**
+ * @brief Параметры сервера.
+ */
+struct ServerOptions {
+  //! Порт.
+  int port = 2022;
+  //! Количество рабочих потоков (0 - количество ядер процессора).
+  size_t workers = 0;
+  //! Сколько соединений может ждать свободного рабочего потока. Остальные
+  //! сразу получают ответ 503.
+  size_t queueDepth = 64;
+  //! Максимальное количество запросов в одном keep-alive соединении.
+  size_t keepAliveMaxCount = 5;
+  //! Время ожидания следующего запроса в keep-alive соединении (секунды).
+  time_t keepAliveTimeout = 5;
+  //! Время ожидания чтения запроса (секунды).
+  time_t readTimeout = 5;
+  //! Время ожидания записи ответа (секунды).
+  time_t writeTimeout = 5;
+  //! Максимальный размер тела запроса (байты).
+  size_t maxBodyLength = 64 << 20;
+  //! Ограничение числа одновременных запросов к методу по умолчанию
+  //! (0 - на единицу меньше числа рабочих потоков, но не меньше 1).
+  size_t endpointLimit = 0;
+  //! Ограничения для отдельных методов (адрес метода -> ограничение).
+  std::map<std::string, size_t> endpointLimits;
+  //! Объём памяти для графов, загруженных запросом POST /graphs (байты).
+  size_t graphMemory = size_t{256} << 20;
+  //! Объём памяти для кэша результатов методов (байты, 0 - без кэша).
+  size_t resultCacheMemory = size_t{64} << 20;
+  //! Количество потоков пула для пакетных запросов /Batch, общего для
+  //! всех пакетов (0 - количество ядер процессора).
+  size_t batchThreads = 0;
+};
+
+/**
+ * @brief Разобрать параметры командной строки.
+ *
+ * @param argc Количество аргументов.
+ * @param argv Аргументы.
+ * @param options Параметры сервера.
+ *
+ * Поддерживаются параметры --port, --workers, --queue-depth,
+ * --keep-alive-max-count, --keep-alive-timeout, --read-timeout,
+ * --write-timeout, --max-body, --endpoint-limit, --graph-memory,
+ * --result-cache, --batch-threads и --limit /Метод=N
+ * (значение можно писать как через пробел, так и через "="). Для
+ * совместимости первый аргумент без "--" задаёт порт. Значение 0
+ * у --workers и --endpoint-limit означает выбор по числу ядер процессора
+ * (см. ServerOptions); ограничение --limit /Метод=0 некорректно, так как
+ * оно отклоняло бы все запросы к методу. Функция возвращает 0 в случае
+ * успеха и -1, если параметры заданы некорректно.
+ */
+inline int ParseServerOptions(int argc, char* argv[], ServerOptions* options) {
+  // Разобрать неотрицательное целое число.
+  auto parse = [](const std::string& text, size_t* value) {
+    if (text.empty() || text.size() > 18 ||
+        text.find_first_not_of("0123456789") != std::string::npos)
+      return false;
+    *value = std::stoull(text);
+    return true;
+  };
+
+  for (int i = 1; i < argc; i++) {
+    std::string name = argv[i], value;
+    size_t number = 0;
+
+    if (i == 1 && name.compare(0, 2, "--") != 0) {
+      if (!parse(name, &number) || number > 65535)
+        return -1;
+      options->port = static_cast<int>(number);
+      continue;
+    }
+
+    const size_t equals = name.find('=');
+    if (name.compare(0, 2, "--") != 0)
+      return -1;
+    if (equals != std::string::npos) {
+      value = name.substr(equals + 1);
+      name = name.substr(0, equals);
+    } else if (i + 1 < argc) {
+      value = argv[++i];
+    } else {
+      return -1;
+    }
+
+    if (name == "--limit") {
+      const size_t separator = value.rfind('=');
+      if (separator == std::string::npos ||
+          !parse(value.substr(separator + 1), &number) || number == 0)
+        return -1;
+      options->endpointLimits[value.substr(0, separator)] = number;
+      continue;
+    }
+
+    if (!parse(value, &number))
+      return -1;
+
+    if (name == "--port" && number <= 65535)
+      options->port = static_cast<int>(number);
+    else if (name == "--workers")
+      options->workers = number;
+    else if (name == "--queue-depth")
+      options->queueDepth = number;
+    else if (name == "--keep-alive-max-count")
+      options->keepAliveMaxCount = number;
+    else if (name == "--keep-alive-timeout")
+      options->keepAliveTimeout = static_cast<time_t>(number);
+    else if (name == "--read-timeout")
+      options->readTimeout = static_cast<time_t>(number);
+    else if (name == "--write-timeout")
+      options->writeTimeout = static_cast<time_t>(number);
+    else if (name == "--max-body")
+      options->maxBodyLength = number;
+    else if (name == "--endpoint-limit")
+      options->endpointLimit = number;
+    else if (name == "--graph-memory")
+      options->graphMemory = number;
+    else if (name == "--result-cache")
+      options->resultCacheMemory = number;
+    else if (name == "--batch-threads")
+      options->batchThreads = number;
+    else
+      return -1;
+  }
+
+  if (options->workers == 0)
+    options->workers = DefaultNumThreads();
+  if (options->endpointLimit == 0)
+    options->endpointLimit = std::max<size_t>(1, options->workers - 1);
+
+  return 0;
+}
+
+/**
+ * @brief Записать в ответ ошибку 503 (сервер перегружен).
+ *
+ * @param res Ответ.
+ */
+inline void RejectOverloaded(httplib::Response* res) {
+  res->status = 503;
+  res->set_header("Retry-After", "1");
+  res->set_header("Connection", "close");
+  res->set_content("{\"error\":\"server is overloaded\"}",
+                   "application/json");
+}
+
+/**
+ * @brief Пул рабочих потоков с ограниченной очередью.
+ *
+ * Сервер передаёт в пул обработку каждого принятого соединения. Если
+ * свободного рабочего потока нет, то соединение ждёт в очереди. Если
+ * и очередь заполнена, то задача выполняется сразу в вызывающем потоке
+ * (потоке, принимающем соединения) с флагом IsOverloaded(): GraphServer
+ * в этом случае не читает запрос, а сразу отвечает 503 и закрывает
+ * соединение. Поэтому отказы не копятся в очереди, а медленный клиент
+ * не задерживает ответы другим.
+ */
+class BoundedThreadPool : public httplib::TaskQueue {
+ public:
+  /**
+   * @brief Конструктор.
+   *
+   * @param numWorkers Количество рабочих потоков.
+   * @param maxQueued Максимальная длина очереди.
+   */
+  BoundedThreadPool(size_t numWorkers, size_t maxQueued) :
+    maxQueued(maxQueued),
+    stopping(false) {
+    for (size_t i = 0; i < std::max<size_t>(1, numWorkers); i++)
+      threads.emplace_back([this] { Run(); });
+  }
+
+  ~BoundedThreadPool() override {
+    shutdown();
+  }
+
+  /**
+   * @brief Добавить задачу.
+   *
+   * @param fn Задача.
+   */
+  void enqueue(std::function<void()> fn) override {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (tasks.size() < maxQueued) {
+        tasks.push_back(std::move(fn));
+        fn = nullptr;
+      }
+    }
+
+    if (!fn) {
+      condition.notify_one();
+      return;
+    }
+
+    Overloaded() = true;
+    fn();
+    Overloaded() = false;
+  }
+
+  /**
+   * @brief Дождаться выполнения всех задач и остановить потоки.
+   */
+  void shutdown() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (stopping)
+        return;
+      stopping = true;
+    }
+    condition.notify_all();
+
+    for (std::thread& thread : threads)
+      thread.join();
+  }
+
+  /**
+   * @brief Функция возвращает true, если текущий поток обрабатывает
+   *        соединение, не поместившееся в очередь.
+   */
+  static bool IsOverloaded() {
+    return Overloaded();
+  }
+
+ private:
+  //! Флаг задачи, не поместившейся в очередь.
+  static bool& Overloaded() {
+    thread_local bool overloaded = false;
+    return overloaded;
+  }
+
+  /**
+   * @brief Цикл рабочего потока.
+   */
+  void Run() {
+    while (true) {
+      std::function<void()> fn;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&] { return stopping || !tasks.empty(); });
+        if (tasks.empty())
+          return;
+        fn = std::move(tasks.front());
+        tasks.pop_front();
+      }
+      fn();
+    }
+  }
+
+  //! Максимальная длина очереди.
+  size_t maxQueued;
+  //! Задачи, ожидающие рабочего потока.
+  std::deque<std::function<void()>> tasks;
+  //! Рабочие потоки.
+  std::vector<std::thread> threads;
+  //! Мьютекс для очереди.
+  std::mutex mutex;
+  //! Условная переменная для ожидания задач.
+  std::condition_variable condition;
+  //! Флаг остановки.
+  bool stopping;
+};
+
+/**
+ * @brief Функция возвращает готовый HTTP ответ 503 для соединений,
+ *        не поместившихся в очередь BoundedThreadPool.
+ */
+inline const std::string& OverloadedResponse() {
+  static const std::string response = [] {
+    const std::string body = "{\"error\":\"server is overloaded\"}";
+    return "HTTP/1.1 503 Service Unavailable\r\n"
+           "Retry-After: 1\r\n"
+           "Connection: close\r\n"
+           "Content-Type: application/json\r\n"
+           "Content-Length: " + std::to_string(body.size()) + "\r\n"
+           "\r\n" + body;
+  }();
+
+  return response;
+}
+
+/**
+ * @brief HTTP сервер, который отказывает лишним соединениям, не читая их.
+ *
+ * Соединение, которое BoundedThreadPool обрабатывает с флагом
+ * IsOverloaded(), получает готовый ответ OverloadedResponse() и сразу
+ * закрывается: ни ожидания запроса (до --read-timeout), ни чтения тела
+ * (до --max-body) нет. Остальные соединения обрабатываются так же, как
+ * в httplib::Server.
+ */
+class GraphServer : public httplib::Server {
+ private:
+  bool process_and_close_socket(socket_t sock) override {
+    bool ret = false;
+
+    if (BoundedThreadPool::IsOverloaded()) {
+#ifdef MSG_NOSIGNAL
+      const int sendFlags = MSG_NOSIGNAL;
+#else
+      const int sendFlags = 0;
+#endif
+      const std::string& response = OverloadedResponse();
+      ::send(sock, response.data(), static_cast<int>(response.size()),
+             sendFlags);
+
+#ifdef MSG_DONTWAIT
+      // Отбросить уже пришедшие данные запроса, не дожидаясь остальных:
+      // иначе закрытие сокета с непрочитанными данными сбрасывает
+      // соединение, и клиент может не получить ответ.
+      char buffer[4096];
+      for (size_t i = 0; i < 16; i++)
+        if (::recv(sock, buffer, sizeof(buffer), MSG_DONTWAIT) <= 0)
+          break;
+#endif
+    } else {
+      ret = httplib::detail::process_server_socket(
+          sock, keep_alive_max_count_, keep_alive_timeout_sec_,
+          read_timeout_sec_, read_timeout_usec_, write_timeout_sec_,
+          write_timeout_usec_,
+          [this](httplib::Stream& strm, bool close_connection,
+                 bool& connection_closed) {
+            return process_request(strm, close_connection,
+                                   connection_closed, nullptr);
+          });
+    }
+
+    httplib::detail::shutdown_socket(sock);
+    httplib::detail::close_socket(sock);
+    return ret;
+  }
+};
+
+/**
+ * @brief Ограничение числа одновременных запросов к методам.
+ *
+ * Обработчик каждого метода оборачивается функцией Wrap(). Если
+ * к методу уже выполняется максимальное число запросов, то новый запрос
+ * сразу получает ответ 503, поэтому тяжёлые методы не могут занять все
+ * рабочие потоки и не мешают выполнять лёгкие. Запросы пакета (см.
+ * RunBatch()) занимают место у своего метода через Wait(), поэтому
+ * пакетом нельзя обойти ограничение, но и отказ из-за собственных
+ * соседей по пакету он не получит: запрос ждёт освободившегося места.
+ */
+class ConcurrencyLimiter {
+ private:
+  /**
+   * @brief Счётчик запросов к одному методу.
+   */
+  struct Counter {
+    //! Количество выполняющихся запросов.
+    std::atomic<size_t> active{0};
+    //! Количество запросов, ждущих места в Wait().
+    std::atomic<size_t> waiting{0};
+    //! Мьютекс для ожидания места.
+    std::mutex mutex;
+    //! Условная переменная для ожидания места.
+    std::condition_variable released;
+  };
+
+ public:
+  /**
+   * @brief Место для одного запроса к методу.
+   *
+   * Место освобождается деструктором, даже если обработчик выбросил
+   * исключение.
+   */
+  class Slot {
+   public:
+    Slot() : counter(nullptr) {
+    }
+
+    Slot(Slot&& other) noexcept : counter(other.counter) {
+      other.counter = nullptr;
+    }
+
+    Slot& operator=(Slot&& other) noexcept {
+      std::swap(counter, other.counter);
+      return *this;
+    }
+
+    Slot(const Slot&) = delete;
+    Slot& operator=(const Slot&) = delete;
+
+    ~Slot() {
+      if (!counter)
+        return;
+
+      counter->active.fetch_sub(1);
+      if (counter->waiting.load() > 0) {
+        std::lock_guard<std::mutex> lock(counter->mutex);
+        counter->released.notify_one();
+      }
+    }
+
+    /**
+     * @brief Функция возвращает true, если место получено.
+     */
+    explicit operator bool() const {
+      return counter != nullptr;
+    }
+
+   private:
+    friend class ConcurrencyLimiter;
+
+    explicit Slot(Counter* counter) : counter(counter) {
+    }
+
+    //! Счётчик запросов к методу.
+    Counter* counter;
+  };
+
+  /**
+   * @brief Конструктор.
+   *
+   * @param defaultLimit Ограничение по умолчанию.
+   * @param limits Ограничения для отдельных методов.
+   */
+  ConcurrencyLimiter(size_t defaultLimit,
+                     std::map<std::string, size_t> limits) :
+    defaultLimit(defaultLimit),
+    limits(std::move(limits)) {
+  }
+
+  /**
+   * @brief Занять место для запроса к методу.
+   *
+   * @param endpoint Адрес метода.
+   * @return Функция возвращает пустое место, если к методу уже
+   * выполняется максимальное число запросов.
+   */
+  Slot Acquire(const std::string& endpoint) const {
+    return Acquire(Limit(endpoint), GetCounter(endpoint));
+  }
+
+  /**
+   * @brief Занять место для запроса к методу, дождавшись его.
+   *
+   * @param endpoint Адрес метода.
+   * @return Функция возвращает пустое место только если ограничение
+   * метода равно 0.
+   */
+  Slot Wait(const std::string& endpoint) const {
+    const size_t limit = Limit(endpoint);
+    Counter* counter = GetCounter(endpoint);
+    Slot slot = Acquire(limit, counter);
+
+    if (slot || limit == 0)
+      return slot;
+
+    // waiting увеличивается до проверки, поэтому место, освобождённое
+    // после неудачной проверки, разбудит этот поток.
+    std::unique_lock<std::mutex> lock(counter->mutex);
+    counter->waiting.fetch_add(1);
+    counter->released.wait(lock, [&] {
+      slot = Acquire(limit, counter);
+      return static_cast<bool>(slot);
+    });
+    counter->waiting.fetch_sub(1);
+
+    return slot;
+  }
+
+  /**
+   * @brief Обернуть обработчик метода.
+   *
+   * @param endpoint Адрес метода.
+   * @param handler Обработчик.
+   */
+  httplib::Handler Wrap(const std::string& endpoint,
+                        httplib::Handler handler) const {
+    const size_t limit = Limit(endpoint);
+    Counter* counter = GetCounter(endpoint);
+
+    return [limit, counter, handler](const httplib::Request& req,
+                                     httplib::Response& res) {
+      const Slot slot = Acquire(limit, counter);
+      if (!slot) {
+        RejectOverloaded(&res);
+        return;
+      }
+
+      handler(req, res);
+    };
+  }
+
+ private:
+  /**
+   * @brief Занять место, если счётчик меньше ограничения.
+   *
+   * @param limit Ограничение.
+   * @param counter Счётчик запросов к методу.
+   */
+  static Slot Acquire(size_t limit, Counter* counter) {
+    if (limit == 0)
+      return Slot();
+
+    if (counter->active.fetch_add(1) >= limit) {
+      counter->active.fetch_sub(1);
+      return Slot();
+    }
+
+    return Slot(counter);
+  }
+
+  /**
+   * @brief Функция возвращает ограничение для метода.
+   *
+   * @param endpoint Адрес метода.
+   */
+  size_t Limit(const std::string& endpoint) const {
+    auto it = limits.find(endpoint);
+    return it == limits.end() ? defaultLimit : it->second;
+  }
+
+  /**
+   * @brief Функция возвращает счётчик запросов к методу.
+   *
+   * @param endpoint Адрес метода.
+   *
+   * Счётчик создаётся при первом обращении и дальше не перемещается.
+   */
+  Counter* GetCounter(const std::string& endpoint) const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return &counters[endpoint];
+  }
+
+  //! Ограничение по умолчанию.
+  size_t defaultLimit;
+  //! Ограничения для отдельных методов.
+  std::map<std::string, size_t> limits;
+  //! Счётчики запросов к каждому методу.
+  mutable std::map<std::string, Counter> counters;
+  //! Мьютекс для counters.
+  mutable std::mutex mutex;
+};
+
+/**
+ * @brief Проверить, задан ли в заголовке бинарный формат.
+ *
+ * @param header Значение заголовка Content-Type или Accept.
+ */
+inline bool IsBinaryGraphType(const std::string& header) {
+  return header.find(kBinaryGraphContentType) != std::string::npos;
+}
+
+/**
+ * @brief Прочитать запрос в формате JSON или в бинарном формате.
+ *
+ * @param req HTTP запрос.
+ * @param store Хранилище загруженных графов.
+ * @param request Результат (ссылается на тело req, если запрос бинарный).
+ * @return Функция возвращает 0 в случае успеха и -1, если запрос задан
+ * некорректно или в нём указан граф, которого нет в хранилище.
+ *
+ * Формат выбирается по заголовку Content-Type, по умолчанию - JSON.
+ * Если в запросе есть поле "graph", то вершины и рёбра берутся из
+ * загруженного графа (см. ResolveGraphRequest()).
+ */
+inline int ReadGraphRequest(const httplib::Request& req, GraphStore* store,
+                            GraphRequest* request) {
+  const int status =
+      IsBinaryGraphType(req.get_header_value("Content-Type")) ?
+      ReadBinaryGraphRequest(req.body, request) :
+      ReadGraphRequest(req.body, request);
+
+  if (status < 0)
+    return -1;
+
+  return ResolveGraphRequest(store, request);
+}
+
+/**
+ * @brief Записать ответ в формате JSON или в бинарном формате.
+ *
+ * @param req HTTP запрос.
+ * @param output Ответ метода.
+ * @param res HTTP ответ.
+ *
+ * Ответ записывается в бинарном формате, если его явно запросили
+ * заголовком Accept или если запрос бинарный, а Accept не требует JSON.
+ */
+inline void WriteGraphResponse(const httplib::Request& req,
+                               const nlohmann::json& output,
+                               httplib::Response* res) {
+  const std::string accept = req.get_header_value("Accept");
+  const bool binary = IsBinaryGraphType(accept) ||
+      (IsBinaryGraphType(req.get_header_value("Content-Type")) &&
+       accept.find("application/json") == std::string::npos);
+  std::string body;
+
+  if (binary && EncodeBinaryGraph(output, &body) == 0)
+    res->set_content(body, kBinaryGraphContentType);
+  else
+    res->set_content(output.dump(), "application/json");
+}
+
+/**
+ * @brief Применить параметры к серверу.
+ *
+ * @param options Параметры.
+ * @param svr Сервер.
+ */
+inline void ConfigureServer(const ServerOptions& options,
+                            GraphServer* svr) {
+  const size_t workers = options.workers;
+  const size_t queueDepth = options.queueDepth;
+
+  svr->new_task_queue = [workers, queueDepth] {
+    return new BoundedThreadPool(workers, queueDepth);
+  };
+  svr->set_keep_alive_max_count(options.keepAliveMaxCount);
+  svr->set_keep_alive_timeout(options.keepAliveTimeout);
+  svr->set_read_timeout(options.readTimeout, 0);
+  svr->set_write_timeout(options.writeTimeout, 0);
+  svr->set_payload_max_length(options.maxBodyLength);
+}
+
+}  // namespace graph
+
+#endif  // METHODS_SERVER_HPP_
@@ -12,6 +12,7 @@
 #include <iostream>
 #include <nlohmann/json.hpp>
 #include "topological_sorting.hpp"
+#include "graph_store.hpp"
 
 namespace graph {
 
@@ -24,18 +25,18 @@ namespace graph {
  */
 
 template<class T>
-static int TopologicalSortingMethodHelper(const nlohmann::json& input,
+static int TopologicalSortingMethodHelper(const GraphRequest& input,
                                      nlohmann::json* output,
                                      std::string type);
 
-int TopologicalSortingMethod(const nlohmann::json& input,
+int TopologicalSortingMethod(const GraphRequest& input,
                              nlohmann::json* output) {
   /*
   С классом nlohmann::json можно работать как со словарём.
   Метод at() в отличие оператора [] не меняет объект, поэтому
   этот метод можно использовать с константными объектами.
   */
-  std::string type = input.at("type");
+  std::string type = input.fields.at("type");
 
   /* Пока реализована только поддержка обычных ориентированных графов */
   if (type == "oriented_graph") {
@@ -58,38 +59,61 @@ int TopologicalSortingMethod(const nlohmann::json& input,
  * Функция запускает алгоритм топологической сортировки, используя входные данные
  * в JSON формате. Результат также выдаётся в JSON формате. Функция
  * используется для сокращения кода, необходимого для поддержки различных типов данных.
+ * Если выбран алгоритм Кана, то в ответ добавляются уровни вершин ("levels"),
+ * а при наличии цикла вместо порядка возвращается цикл ("cycle").
  */
 
 template<class T>
-static int TopologicalSortingMethodHelper(const nlohmann::json& input,
+static int TopologicalSortingMethodHelper(const GraphRequest& input,
                                      nlohmann::json* output,
                                      std::string type) {
-  (*output)["id"] = input.at("id");
+  (*output)["id"] = input.fields.at("id");
   (*output)["type"] = type;
 
-  size_t size = input.at("size");
+  size_t size = input.fields.at("size");
 
-  size_t numEdges = input.at("numEdges");
+  size_t numEdges = input.fields.at("numEdges");
 
-  T oriented_graph;
+  T local(GraphAllocator<T>(input));
+  const T* oriented_graph;
 
-  for (size_t i = 0; i < size; i++) {
-    /* Для словарей используется индекс в виде строки,
-    а для массивов просто целое число типа size_t. */
-    oriented_graph.AddVertex(input.at("vertices").at(i));
-  }
+  /* Вершины и рёбра уже прочитаны из запроса в плоские векторы
+  (или граф уже построен, если он загружен заранее). */
+  if (GetGraph(input, size, numEdges, &local, &oriented_graph) < 0)
+    return -1;
 
+  /*
+  Поле "algorithm" необязательное: "dfs" (по умолчанию, обход в глубину)
+  или "kahn" (алгоритм Кана, который находит цикл и уровни вершин).
+  Для алгоритма Кана можно задать количество потоков полем "threads".
+  */
+  std::string algorithm = "dfs";
+  size_t threads = 0;
+  if (input.fields.contains("algorithm"))
+    algorithm = input.fields.at("algorithm");
+  if (ReadNumThreads(input, &threads) < 0)
+    return -1;
+  if (algorithm != "dfs" && algorithm != "kahn")
+    return -1;
 
-  for (size_t i = 0; i < numEdges; i++) {
-    /* Для словарей используется индекс в виде строки,
-    а для массивов просто целое число типа size_t. */
-    oriented_graph.AddEdge(input.at("edges").at(i).at(0),
-                           input.at("edges").at(i).at(1));
-  }
+  (*output)["algorithm"] = algorithm;
 
   std::vector<size_t> result;
-
-  TopologicalSorting(oriented_graph, &result);
+  TopologicalOrder order;
+
+  if (algorithm == "kahn") {
+    if (!KahnTopologicalSorting(*oriented_graph, &order, threads)) {
+      /* В графе есть цикл: вместо порядка возвращаем сам цикл. */
+      (*output)["size"] = size;
+      (*output)["cycle"] = order.cycle;
+      return 0;
+    }
+
+    result = order.order;
+    (*output)["levels"] = order.levels;
+  } else {
+    TopologicalSorting(*oriented_graph, &result);
+  }
 
   /* Сохраняем в ответе результат работы алгоритма. */
   (*output)["size"] = size;
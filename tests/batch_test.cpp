@@ -0,0 +1,287 @@
+/**
+ * @file tests/batch_test.cpp
+ *
+ * Тесты для пакетных запросов к серверу.
+ */
+
+#include <httplib.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <nlohmann/json.hpp>
+#include "test_core.hpp"
+#include "test.hpp"
+#include "../methods/batch.hpp"
+
+using graph::ConcurrencyLimiter;
+using graph::GraphMethods;
+using graph::GraphRequest;
+using graph::GraphStore;
+using graph::kDependsOnTopology;
+using graph::ResultCache;
+using graph::RunBatch;
+using graph::ThreadPool;
+
+static void RunBatchTest();
+static void InvalidBatchTest();
+static void LimiterTest();
+static void EndpointTest(httplib::Client* cli);
+
+void TestBatch(httplib::Client* cli) {
+  TestSuite suite("TestBatch");
+
+  RUN_TEST(suite, RunBatchTest);
+  RUN_TEST(suite, InvalidBatchTest);
+  RUN_TEST(suite, LimiterTest);
+  RUN_TEST_REMOTE(suite, cli, EndpointTest);
+}
+
+/**
+ * @brief Метод для тестов: количество рёбер или ошибка.
+ *
+ * @param input Входные данные.
+ * @param output Выходные данные.
+ */
+static int CountEdges(const GraphRequest& input, nlohmann::json* output) {
+  (*output)["id"] = input.fields.at("id");
+  if (input.NumEdges() == 0)
+    return -1;
+  if (input.fields.contains("throw"))
+    throw std::runtime_error("test");
+
+  (*output)["data"] = input.NumEdges();
+  return 0;
+}
+
+//! Количество выполняющихся запросов к методу /Slow.
+static std::atomic<size_t> slowActive(0);
+//! Наибольшее количество одновременных запросов к методу /Slow.
+static std::atomic<size_t> slowPeak(0);
+
+/**
+ * @brief Метод для тестов: запоминает число одновременных запросов.
+ *
+ * @param input Входные данные.
+ * @param output Выходные данные.
+ */
+static int Slow(const GraphRequest& input, nlohmann::json* output) {
+  const size_t active = ++slowActive;
+  size_t peak = slowPeak;
+  while (active > peak && !slowPeak.compare_exchange_weak(peak, active)) {
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  (*output)["id"] = input.fields.at("id");
+  slowActive--;
+  return 0;
+}
+
+//! Методы для тестов.
+static const GraphMethods kMethods = {
+  {"/CountEdges", {CountEdges, kDependsOnTopology}},
+  {"/Slow", {Slow, kDependsOnTopology}},
+};
+
+/**
+ * @brief Результаты идут в порядке запросов, у каждого свой статус.
+ */
+static void RunBatchTest() {
+  GraphStore store(1 << 20);
+  ResultCache cache(0);
+  nlohmann::json body = nlohmann::json::array();
+
+  for (size_t i = 0; i < 100; i++) {
+    nlohmann::json input = {{"id", i}, {"edges", nlohmann::json::array()}};
+    for (size_t j = 0; j < i % 7; j++)
+      input["edges"].push_back({j, j + 1});
+    body.push_back({{"method", i % 2 ? "/CountEdges" : "CountEdges"},
+                    {"input", input}});
+  }
+
+  for (size_t numThreads : {1, 4}) {
+    ThreadPool pool(numThreads);
+    nlohmann::json output;
+    REQUIRE_EQUAL(RunBatch(body.dump(), kMethods, &store, &cache, nullptr,
+                           &pool, &output), 0);
+    REQUIRE_EQUAL(output.size(), body.size());
+
+    for (size_t i = 0; i < output.size(); i++) {
+      const nlohmann::json& result = output[i];
+      REQUIRE_EQUAL(result["output"]["id"], i);
+      if (i % 7 == 0) {
+        REQUIRE_EQUAL(result["status"], 400);
+      } else {
+        REQUIRE_EQUAL(result["status"], 200);
+        REQUIRE_EQUAL(result["output"]["data"], i % 7);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Некорректные пакеты и запросы.
+ */
+static void InvalidBatchTest() {
+  GraphStore store(1 << 20);
+  ResultCache cache(0);
+  ThreadPool pool(2);
+  nlohmann::json output;
+
+  REQUIRE_EQUAL(RunBatch("{\"method\": \"/CountEdges\"}", kMethods, &store,
+                         &cache, nullptr, nullptr, &output), -1);
+  REQUIRE_EQUAL(RunBatch("[", kMethods, &store, &cache, nullptr, nullptr,
+                         &output), -1);
+
+  REQUIRE_EQUAL(RunBatch("[]", kMethods, &store, &cache, nullptr, nullptr,
+                         &output), 0);
+  REQUIRE(output == nlohmann::json::array());
+
+  const nlohmann::json body = R"([
+    1,
+    {"input": {"id": 1}},
+    {"method": 5, "input": {"id": 1}},
+    {"method": "/Unknown", "input": {"id": 1}},
+    {"method": "/CountEdges"},
+    {"method": "/CountEdges", "input": {"id": 1, "edges": [[1, -2]]}},
+    {"method": "/CountEdges", "input": {"id": 1, "graph": "g0"}},
+    {"method": "/CountEdges", "input": {"edges": [[1, 2]]}},
+    {"method": "/CountEdges",
+     "input": {"id": 1, "throw": true, "edges": [[1, 2]]}},
+    {"method": "/CountEdges", "input": {"id": 1, "edges": [[1, 2]]}}
+  ])"_json;
+  const int expected[] = {400, 400, 400, 404, 400, 400, 400, 500, 500, 200};
+
+  REQUIRE_EQUAL(RunBatch(body.dump(), kMethods, &store, &cache, nullptr,
+                         &pool, &output), 0);
+  REQUIRE_EQUAL(output.size(), body.size());
+  for (size_t i = 0; i < output.size(); i++)
+    REQUIRE_EQUAL(output[i]["status"], expected[i]);
+}
+
+/**
+ * @brief Запросы пакета подчиняются ограничениям своих методов, но ждут
+ *        места вместо отказа.
+ */
+static void LimiterTest() {
+  GraphStore store(1 << 20);
+  ResultCache cache(0);
+  const ConcurrencyLimiter limiter(1, {{"/Slow", 2}});
+  const ConcurrencyLimiter off(1, {{"/CountEdges", 0}});
+  ThreadPool pool(4);
+  nlohmann::json output;
+
+  const std::string body = R"([
+    {"method": "/CountEdges", "input": {"id": 1, "edges": [[1, 2]]}},
+    {"method": "/CountEdges", "input": {"id": 2, "edges": [[1, 2]]}}
+  ])";
+
+  {
+    // Единственное место метода занято отдельным запросом: пакет ждёт.
+    ConcurrencyLimiter::Slot busy = limiter.Acquire("/CountEdges");
+    REQUIRE(static_cast<bool>(busy));
+    REQUIRE(!limiter.Acquire("/CountEdges"));
+
+    std::atomic<bool> finished(false);
+    std::thread batch([&] {
+      RunBatch(body, kMethods, &store, &cache, &limiter, &pool, &output);
+      finished = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    REQUIRE(!finished);
+
+    busy = ConcurrencyLimiter::Slot();
+    batch.join();
+    for (const nlohmann::json& result : output)
+      REQUIRE_EQUAL(result["status"], 200);
+  }
+
+  // Каждый запрос пакета освобождает место после выполнения.
+  REQUIRE(static_cast<bool>(limiter.Acquire("/CountEdges")));
+
+  // Без конкуренции запросы пакета не получают 503, даже если потоков
+  // больше, чем мест, а ограничение соблюдается.
+  nlohmann::json many = nlohmann::json::array();
+  for (size_t i = 0; i < 64; i++) {
+    many.push_back({{"method", i % 2 ? "/CountEdges" : "/Slow"},
+                    {"input", {{"id", i}, {"edges", {{i, i + 1}}}}}});
+  }
+
+  slowPeak = 0;
+  REQUIRE_EQUAL(RunBatch(many.dump(), kMethods, &store, &cache, &limiter,
+                         &pool, &output), 0);
+  REQUIRE_EQUAL(output.size(), many.size());
+  for (size_t i = 0; i < output.size(); i++) {
+    REQUIRE_EQUAL(output[i]["status"], 200);
+    REQUIRE_EQUAL(output[i]["output"]["id"], i);
+  }
+  REQUIRE(slowPeak.load() <= 2);
+
+  // Метод с ограничением 0 по-прежнему отклоняет запросы.
+  REQUIRE_EQUAL(RunBatch(body, kMethods, &store, &cache, &off, &pool,
+                         &output), 0);
+  for (const nlohmann::json& result : output) {
+    REQUIRE_EQUAL(result["status"], 503);
+    REQUIRE(!result.contains("output"));
+  }
+}
+
+/**
+ * @brief Пакет отвечает так же, как отдельные запросы.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void EndpointTest(httplib::Client* cli) {
+  std::mt19937 gen(20);
+  nlohmann::json body = nlohmann::json::array();
+
+  for (size_t i = 0; i < 200; i++) {
+    const size_t n = 10 + gen() % 30, m = n + gen() % (2 * n);
+    nlohmann::json input = {{"id", i}, {"size", n}, {"numEdges", m}};
+
+    for (size_t v = 0; v < n; v++)
+      input["vertices"].push_back(v);
+    for (size_t e = 0; e < m; e++) {
+      size_t a = gen() % n, b = gen() % n;
+      if (a == b)
+        b = (b + 1) % n;
+      input["edges"].push_back({std::min(a, b), std::max(a, b)});
+    }
+
+    if (i % 2 == 0) {
+      input["type"] = "graph";
+      body.push_back({{"method", "/CutPoints"}, {"input", input}});
+    } else {
+      input["type"] = "oriented_graph";
+      body.push_back({{"method", "/TopologicalSorting"}, {"input", input}});
+    }
+  }
+
+  // Некорректный запрос внутри пакета.
+  nlohmann::json invalid = {{"id", 1}};
+  invalid["vertices"].push_back(-1);
+  body.push_back({{"method", "/CutPoints"}, {"input", invalid}});
+
+  httplib::Result res = cli->Post("/Batch", body.dump(), "application/json");
+  REQUIRE_EQUAL(res->status, 200);
+  const nlohmann::json output = nlohmann::json::parse(res->body);
+  REQUIRE_EQUAL(output.size(), body.size());
+
+  for (size_t i = 0; i < body.size(); i++) {
+    const std::string method = body[i]["method"];
+    httplib::Result single = cli->Post(method.c_str(),
+                                       body[i]["input"].dump(),
+                                       "application/json");
+    REQUIRE_EQUAL(output[i]["status"], single->status);
+    if (single->status == 200)
+      REQUIRE(output[i]["output"] == nlohmann::json::parse(single->body));
+  }
+  REQUIRE_EQUAL(output.back()["status"], 400);
+
+  res = cli->Post("/Batch", "{}", "application/json");
+  REQUIRE_EQUAL(res->status, 400);
+}
@@ -6,6 +6,8 @@
  */
 
 #include <belmanf.hpp>
+#include <d_ary_heap.hpp>
+#include <radix_heap.hpp>
 #include <httplib.h>
 #include <nlohmann/json.hpp>
 #include "test_core.hpp"
@@ -14,6 +16,11 @@
 using graph::WeightedOrientedGraph;
 static void SimpleTest(httplib::Client* cli);
 static void RandomTest(httplib::Client* cli);
+static void NegativeWeightsTest(httplib::Client* cli);
+static void NegativeCycleTest(httplib::Client* cli);
+static void FloatingPointTest(httplib::Client* cli);
+static void DijkstraTest(httplib::Client* cli);
+static void HeapTest();
 
 static void RandomIntegerHelperTest(httplib::Client* cli, std::string type);
 
@@ -22,6 +29,11 @@ void TestBelmanf(httplib::Client* cli) {
 
   RUN_TEST_REMOTE(suite, cli, SimpleTest);
   RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST_REMOTE(suite, cli, NegativeWeightsTest);
+  RUN_TEST_REMOTE(suite, cli, NegativeCycleTest);
+  RUN_TEST_REMOTE(suite, cli, FloatingPointTest);
+  RUN_TEST_REMOTE(suite, cli, DijkstraTest);
+  RUN_TEST(suite, HeapTest);
 }
 
 /**
@@ -181,3 +193,214 @@ static void SimpleTest(httplib::Client* cli) {
       }
   }
 }
+
+/**
+* @brief Тест на граф с отрицательными весами, которому нужно несколько фаз.
+*
+* @param cli Указатель на HTTP клиент.
+*/
+static void NegativeWeightsTest(httplib::Client* cli) {
+  // Кратчайший путь 1 -> 5 -> 4 -> 3 -> 2 проходит по рёбрам в порядке,
+  // обратном порядку номеров вершин.
+  nlohmann::json input = R"(
+    {
+      "id": 2,
+      "type": "int",
+      "size": [ 6, 5, 1 ],
+      "data": [ 10, 1, 2, 10, 1, 3, 10, 1, 4, 1, 1, 5, -2, 5, 4, -3, 4, 3,
+                -4, 3, 2 ]
+    }
+  )"_json;
+
+  input["size"][0] = input["data"].size() / 3;
+
+  for (std::string algorithm : {"spfa", "bellman_ford"}) {
+    input["algorithm"] = algorithm;
+
+    httplib::Result res = cli->Post("/Belmanf", input.dump(),
+                                    "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+
+    REQUIRE_EQUAL(200, res->status);
+    REQUIRE_EQUAL(5, output["size"]);
+
+    std::unordered_map<size_t, std::string> dist;
+    for (size_t i = 0; i < output["data"].size(); i++)
+      dist[output["data"][i][0]] = output["data"][i][1];
+
+    REQUIRE_EQUAL(dist[1], "0");
+    REQUIRE_EQUAL(dist[5], "1");
+    REQUIRE_EQUAL(dist[4], "-1");
+    REQUIRE_EQUAL(dist[3], "-4");
+    REQUIRE_EQUAL(dist[2], "-8");
+
+    std::unordered_map<size_t, size_t> parent;
+    for (size_t i = 0; i < output["parents"].size(); i++)
+      parent[output["parents"][i][0]] = output["parents"][i][1];
+
+    REQUIRE_EQUAL(parent.size(), 4ul);
+    REQUIRE_EQUAL(parent[2], 3ul);
+    REQUIRE_EQUAL(parent[3], 4ul);
+    REQUIRE_EQUAL(parent[4], 5ul);
+    REQUIRE_EQUAL(parent[5], 1ul);
+  }
+}
+
+/**
+* @brief Тест на граф с достижимым циклом отрицательного веса.
+*
+* @param cli Указатель на HTTP клиент.
+*/
+static void NegativeCycleTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+    {
+      "id": 3,
+      "type": "int",
+      "size": [ 4, 4, 1 ],
+      "data": [ 1, 1, 2, 1, 2, 3, -3, 3, 2, 5, 3, 4 ]
+    }
+  )"_json;
+
+  for (std::string algorithm : {"spfa", "bellman_ford"}) {
+    input["algorithm"] = algorithm;
+
+    httplib::Result res = cli->Post("/Belmanf", input.dump(),
+                                    "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+
+    REQUIRE_EQUAL(output["data"], "negative cycle");
+  }
+
+  input["algorithm"] = "floyd";
+
+  httplib::Result res = cli->Post("/Belmanf", input.dump(),
+                                  "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
+
+/**
+* @brief Тест на граф с дробными весами.
+*
+* @param cli Указатель на HTTP клиент.
+*/
+static void FloatingPointTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+    {
+      "id": 4,
+      "type": "double",
+      "size": [ 3, 3, 1 ],
+      "data": [ 0.5, 1, 2, 0.25, 2, 3, 1.0, 1, 3 ]
+    }
+  )"_json;
+
+  httplib::Result res = cli->Post("/Belmanf", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  std::unordered_map<size_t, std::string> dist;
+  for (size_t i = 0; i < output["data"].size(); i++)
+    dist[output["data"][i][0]] = output["data"][i][1];
+
+  REQUIRE_EQUAL(std::stod(dist[2]), 0.5);
+  REQUIRE_EQUAL(std::stod(dist[3]), 0.75);
+}
+
+/**
+* @brief Случайный тест: на графах без отрицательных весов алгоритм
+*        Дейкстры выбирается автоматически и совпадает с Беллманом-Фордом.
+*
+* @param cli Указатель на HTTP клиент.
+*/
+static void DijkstraTest(httplib::Client* cli) {
+  // Число попыток.
+  const int numTries = 20;
+  // Используется для инициализации генератора случайных чисел.
+  std::random_device rd;
+  // Генератор случайных чисел.
+  std::mt19937 gen(rd());
+  // Распределение для количества вершин.
+  std::uniform_int_distribution<size_t> graphSize(2, 100);
+  // Распределение для весов рёбер.
+  std::uniform_int_distribution<int> elem(0, 1000);
+
+  for (int it = 0; it < numTries; it++) {
+    const std::string type = it % 2 ? "int" : "double";
+    const size_t n = graphSize(gen);
+    std::uniform_int_distribution<size_t> ver(0, n - 1);
+    const size_t size = 3 * n;
+
+    nlohmann::json input;
+    input["id"] = it;
+    input["type"] = type;
+    input["size"] = {size, n, 0};
+    for (size_t i = 0; i < size; i++) {
+      if (type == "int")
+        input["data"][i * 3] = elem(gen);
+      else
+        input["data"][i * 3] = elem(gen) / 8.0;
+      input["data"][i * 3 + 1] = ver(gen);
+      input["data"][i * 3 + 2] = ver(gen);
+    }
+
+    httplib::Result res = cli->Post("/Belmanf", input.dump(),
+                                    "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+
+    input["algorithm"] = "bellman_ford";
+    httplib::Result expectedRes = cli->Post("/Belmanf", input.dump(),
+                                            "application/json");
+    nlohmann::json expected = nlohmann::json::parse(expectedRes->body);
+
+    REQUIRE_EQUAL("dijkstra", output["algorithm"]);
+    REQUIRE_EQUAL(expected["data"], output["data"]);
+  }
+}
+
+/**
+* @brief Тест на кучи, используемые в алгоритме Дейкстры.
+*/
+static void HeapTest() {
+  // Используется для инициализации генератора случайных чисел.
+  std::random_device rd;
+  // Генератор случайных чисел.
+  std::mt19937 gen(rd());
+  // Распределение для приращений ключей.
+  std::uniform_int_distribution<unsigned> step(0, 1000);
+
+  graph::RadixHeap<unsigned, size_t> radix;
+  graph::DAryHeap<double, size_t> dary;
+  unsigned last = 0;
+
+  for (size_t i = 0; i < 1000; i++) {
+    // Ключи монотонной очереди не меньше последнего извлечённого.
+    radix.Push(last + step(gen), i);
+    dary.Push(step(gen) / 3.0, i);
+
+    if (i % 3 == 2) {
+      const unsigned key = radix.Pop().first;
+
+      REQUIRE(key >= last);
+      last = key;
+    }
+  }
+
+  if (last > 0)
+    REQUIRE_THROW(radix.Push(last - 1, 0), std::invalid_argument);
+
+  while (!radix.Empty()) {
+    const unsigned key = radix.Pop().first;
+
+    REQUIRE(key >= last);
+    last = key;
+  }
+
+  double previous = -1;
+  REQUIRE_EQUAL(dary.Size(), 1000ul);
+  while (!dary.Empty()) {
+    const double key = dary.Pop().first;
+
+    REQUIRE(key >= previous);
+    previous = key;
+  }
+}
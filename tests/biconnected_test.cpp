@@ -0,0 +1,238 @@
+/**
+ * @file tests/biconnected_test.cpp
+ *
+ * Реализация набора тестов для поиска компонент двусвязности.
+ */
+
+#include <biconnected.hpp>
+#include <graph.hpp>
+#include <disjoint_set.hpp>
+#include <httplib.h>
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "test_core.hpp"
+#include "test.hpp"
+
+static void SimpleTest(httplib::Client* cli);
+static void OutputsTest(httplib::Client* cli);
+static void RandomTest();
+
+void TestBiconnected(httplib::Client* cli) {
+  TestSuite suite("TestBiconnected");
+
+  RUN_TEST_REMOTE(suite, cli, SimpleTest);
+  RUN_TEST_REMOTE(suite, cli, OutputsTest);
+  RUN_TEST(suite, RandomTest);
+}
+
+/**
+ * @brief Отсортировать компоненты и вершины внутри них.
+ *
+ * @param components Компоненты в формате JSON.
+ */
+static std::vector<std::vector<size_t>> Normalize(
+    const nlohmann::json& components) {
+  std::vector<std::vector<size_t>> result;
+
+  for (const auto& component : components) {
+    std::vector<size_t> vertices = component;
+    std::sort(vertices.begin(), vertices.end());
+    result.push_back(vertices);
+  }
+  std::sort(result.begin(), result.end());
+
+  return result;
+}
+
+/**
+ * @brief Простейший статический тест.
+ *
+ * Два треугольника 1-2-3 и 3-4-5, соединённые в вершине 3, мост 5-6
+ * и изолированная вершина 7.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void SimpleTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 1,
+    "type": "graph",
+    "size": 7,
+    "vertices": [ 1, 2, 3, 4, 5, 6, 7 ],
+    "numEdges": 7,
+    "edges": [ [1,2], [2,3], [3,1], [3,4], [4,5], [5,3], [5,6] ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/Biconnected", input.dump(),
+      "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(1, output["id"]);
+  REQUIRE_EQUAL(7, output["size"]);
+
+  std::vector<size_t> points = output["cut_points"];
+  std::sort(points.begin(), points.end());
+  REQUIRE(points == std::vector<size_t>({3, 5}));
+
+  REQUIRE_EQUAL(size_t{1}, output["bridges"].size());
+  std::vector<size_t> bridge = output["bridges"][0];
+  std::sort(bridge.begin(), bridge.end());
+  REQUIRE(bridge == std::vector<size_t>({5, 6}));
+
+  REQUIRE(Normalize(output["two_edge_components"]) ==
+          std::vector<std::vector<size_t>>({{1, 2, 3, 4, 5}, {6}, {7}}));
+  REQUIRE(Normalize(output["blocks"]) ==
+          std::vector<std::vector<size_t>>({{1, 2, 3}, {3, 4, 5}, {5, 6},
+                                            {7}}));
+}
+
+/**
+ * @brief Тест на поле "outputs".
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void OutputsTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 2,
+    "type": "graph",
+    "size": 3,
+    "vertices": [ 1, 2, 3 ],
+    "numEdges": 2,
+    "edges": [ [1,2], [2,3] ],
+    "outputs": [ "bridges" ]
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/Biconnected", input.dump(),
+      "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(size_t{2}, output["bridges"].size());
+  REQUIRE(!output.contains("cut_points"));
+  REQUIRE(!output.contains("blocks"));
+  REQUIRE(!output.contains("two_edge_components"));
+
+  input["outputs"] = {"cut_points", "articulation"};
+  res = cli->Post("/Biconnected", input.dump(), "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
+
+/**
+ * @brief Количество компонент связности графа без вершины и ребра.
+ *
+ * @param n Количество вершин.
+ * @param edges Рёбра.
+ * @param skipVertex Удаляемая вершина (n, если не удаляется).
+ * @param skipEdge Номер удаляемого ребра (edges.size(), если не удаляется).
+ */
+static size_t CountComponents(size_t n,
+                              const std::vector<std::pair<size_t, size_t>>&
+                                  edges,
+                              size_t skipVertex, size_t skipEdge) {
+  graph::DisjointSet sets(n);
+
+  for (size_t i = 0; i < edges.size(); i++) {
+    const auto& [a, b] = edges[i];
+
+    if (i != skipEdge && a != skipVertex && b != skipVertex)
+      sets.Union(a, b);
+  }
+
+  return sets.NumSets() - (skipVertex < n ? 1 : 0);
+}
+
+/**
+ * @brief Сравнение с полным перебором на случайных графах.
+ */
+static void RandomTest() {
+  // Число попыток.
+  const int numTries = 100;
+  // Используется для инициализации генератора случайных чисел.
+  std::random_device rd;
+  // Генератор случайных чисел.
+  std::mt19937 gen(rd());
+  // Распределение для количества вершин.
+  std::uniform_int_distribution<size_t> graphSize(1, 25);
+
+  for (int it = 0; it < numTries; it++) {
+    const size_t n = graphSize(gen);
+    std::uniform_int_distribution<size_t> ver(0, n - 1);
+    std::uniform_int_distribution<size_t> numEdges(0, 2 * n);
+
+    graph::Graph g;
+    std::set<std::pair<size_t, size_t>> edgeSet;
+    for (size_t v = 0; v < n; v++)
+      g.AddVertex(v);
+    for (size_t i = numEdges(gen); i > 0; i--) {
+      size_t a = ver(gen), b = ver(gen);
+      if (a == b)
+        continue;
+      g.AddEdge(a, b);
+      edgeSet.insert({std::min(a, b), std::max(a, b)});
+    }
+    const std::vector<std::pair<size_t, size_t>> edges(edgeSet.begin(),
+                                                       edgeSet.end());
+
+    graph::BiconnectedComponents result;
+    graph::Biconnected(g, graph::kAllBiconnectedOutputs, &result);
+
+    const size_t base = CountComponents(n, edges, n, edges.size());
+
+    // Точки сочленения: удаление вершины увеличивает число компонент.
+    std::vector<size_t> expectedPoints;
+    for (size_t v = 0; v < n; v++)
+      if (CountComponents(n, edges, v, edges.size()) > base)
+        expectedPoints.push_back(v);
+    std::sort(result.cutPoints.begin(), result.cutPoints.end());
+    REQUIRE(expectedPoints == result.cutPoints);
+
+    // Мосты: удаление ребра увеличивает число компонент.
+    std::set<std::pair<size_t, size_t>> expectedBridges, bridges;
+    for (size_t i = 0; i < edges.size(); i++)
+      if (CountComponents(n, edges, n, i) > base)
+        expectedBridges.insert(edges[i]);
+    for (const auto& [a, b] : result.bridges)
+      bridges.insert({std::min(a, b), std::max(a, b)});
+    REQUIRE_EQUAL(expectedBridges.size(), result.bridges.size());
+    REQUIRE(expectedBridges == bridges);
+
+    // Компоненты рёберной двусвязности: связность без мостов.
+    graph::DisjointSet twoEdge(n);
+    for (const auto& edge : edges)
+      if (expectedBridges.count(edge) == 0)
+        twoEdge.Union(edge.first, edge.second);
+    REQUIRE_EQUAL(twoEdge.NumSets(), result.twoEdgeComponents.size());
+    for (const auto& component : result.twoEdgeComponents)
+      for (size_t v : component)
+        REQUIRE(twoEdge.Connected(v, component.front()));
+
+    // Блоки: каждое ребро лежит ровно в одном блоке, а вершина лежит
+    // в нескольких блоках тогда и только тогда, когда она - точка
+    // сочленения.
+    std::vector<size_t> blocksOf(n, 0);
+    for (const auto& block : result.blocks)
+      for (size_t v : block)
+        blocksOf[v]++;
+    for (size_t v = 0; v < n; v++) {
+      const bool isPoint = std::binary_search(expectedPoints.begin(),
+                                              expectedPoints.end(), v);
+      REQUIRE(blocksOf[v] >= 1);
+      REQUIRE_EQUAL(isPoint, blocksOf[v] > 1);
+    }
+    for (const auto& [a, b] : edges) {
+      size_t common = 0;
+      for (const auto& block : result.blocks)
+        if (std::find(block.begin(), block.end(), a) != block.end() &&
+            std::find(block.begin(), block.end(), b) != block.end())
+          common++;
+      REQUIRE_EQUAL(size_t{1}, common);
+    }
+  }
+}
@@ -0,0 +1,275 @@
+/**
+ * @file tests/binary_format_test.cpp
+ *
+ * Тесты для бинарного формата запросов и ответов сервера.
+ */
+
+#include <httplib.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "test_core.hpp"
+#include "test.hpp"
+#include "../methods/binary_format.hpp"
+
+using graph::DecodeBinaryGraph;
+using graph::EncodeBinaryGraph;
+using graph::GraphRequest;
+using graph::kBinaryGraphContentType;
+using graph::kBinaryGraphHeaderSize;
+using graph::kFloat64Weights;
+using graph::kInt32Weights;
+using graph::kInt64Weights;
+using graph::kNoWeights;
+using graph::ReadBinaryGraphRequest;
+
+static void RoundTripTest();
+static void WeightTypesTest();
+static void InvalidTest();
+static void EndpointsTest(httplib::Client* cli);
+static void BinaryResponseTest(httplib::Client* cli);
+
+void TestBinaryFormat(httplib::Client* cli) {
+  TestSuite suite("TestBinaryFormat");
+
+  RUN_TEST(suite, RoundTripTest);
+  RUN_TEST(suite, WeightTypesTest);
+  RUN_TEST(suite, InvalidTest);
+  RUN_TEST_REMOTE(suite, cli, EndpointsTest);
+  RUN_TEST_REMOTE(suite, cli, BinaryResponseTest);
+}
+
+/**
+ * @brief Закодировать сообщение и раскодировать его обратно.
+ *
+ * @param message Сообщение.
+ */
+static nlohmann::json RoundTrip(const nlohmann::json& message) {
+  std::string body;
+  nlohmann::json result;
+
+  REQUIRE_EQUAL(EncodeBinaryGraph(message, &body), 0);
+  REQUIRE_EQUAL(body.size() % 8, size_t{0});
+  REQUIRE_EQUAL(DecodeBinaryGraph(body, &result), 0);
+
+  return result;
+}
+
+/**
+ * @brief Сообщения восстанавливаются без изменений.
+ */
+static void RoundTripTest() {
+  const std::vector<nlohmann::json> messages = {
+    R"({"id": 1, "type": "graph", "size": 3, "numEdges": 2,
+        "vertices": [1, 2, 3], "edges": [[1, 2], [2, 3]]})"_json,
+    R"({"id": 2, "type": "weighted_oriented_graph", "start": 1,
+        "vertices": [1, 2], "edges": [[1, 2, -5], [2, 1, 7]]})"_json,
+    R"({"id": 3, "type": "double", "size": [2, 3, 1],
+        "data": [0.5, 1, 2, -1.25, 2, 3]})"_json,
+    R"({"id": 4, "vertices": [], "edges": []})"_json,
+    R"({"id": 5, "data": [1, 2], "edges": "none", "vertices": [-1]})"_json,
+    R"({"id": 6, "data": null, "simpledata": [3, 1, 2]})"_json,
+  };
+
+  for (const nlohmann::json& message : messages)
+    REQUIRE(RoundTrip(message) == message);
+}
+
+/**
+ * @brief Выбор типа весов и чтение запроса без копирования.
+ */
+static void WeightTypesTest() {
+  struct Case {
+    nlohmann::json edges;
+    graph::PackedWeightType type;
+  };
+
+  const std::vector<Case> cases = {
+    {R"([[1, 2]])"_json, kNoWeights},
+    {R"([[1, 2, -3], [2, 1, 2147483647]])"_json, kInt32Weights},
+    {R"([[1, 2, -3], [2, 1, 2147483648]])"_json, kInt64Weights},
+    {R"([[1, 2, 3], [2, 1, 0.5]])"_json, kFloat64Weights},
+  };
+
+  for (const Case& test : cases) {
+    nlohmann::json message = {{"id", 0}, {"edges", test.edges}};
+    std::string body;
+    GraphRequest request;
+
+    REQUIRE_EQUAL(EncodeBinaryGraph(message, &body), 0);
+    REQUIRE_EQUAL(ReadBinaryGraphRequest(body, &request), 0);
+    REQUIRE_EQUAL(static_cast<int>(request.packedWeights),
+                  static_cast<int>(test.type));
+    REQUIRE(request.packed != nullptr);
+    REQUIRE(request.fields == nlohmann::json({{"id", 0}}));
+    REQUIRE_EQUAL(request.NumEdges(), test.edges.size());
+
+    for (size_t i = 0; i < test.edges.size(); i++) {
+      REQUIRE_EQUAL(request.EdgeSource(i), test.edges[i][0].get<size_t>());
+      REQUIRE_EQUAL(request.EdgeTarget(i), test.edges[i][1].get<size_t>());
+      if (test.type != kNoWeights)
+        REQUIRE_EQUAL(request.EdgeWeight<double>(i),
+                      test.edges[i][2].get<double>());
+    }
+  }
+}
+
+/**
+ * @brief Некорректные сообщения.
+ */
+static void InvalidTest() {
+  std::string body;
+  GraphRequest request;
+
+  REQUIRE_EQUAL(EncodeBinaryGraph(nlohmann::json::array(), &body), -1);
+  REQUIRE_EQUAL(EncodeBinaryGraph(
+      R"({"vertices": [1, 2], "edges": [[1, 2, 3]]})"_json, &body), 0);
+  REQUIRE_EQUAL(ReadBinaryGraphRequest(body, &request), 0);
+
+  // Обрезанное сообщение.
+  REQUIRE_EQUAL(ReadBinaryGraphRequest(body.substr(0, body.size() - 1),
+                                       &request), -1);
+  REQUIRE_EQUAL(ReadBinaryGraphRequest(body.substr(0, 16), &request), -1);
+
+  // Неверная сигнатура, версия и тип весов.
+  for (size_t position : {0, 4, 5}) {
+    std::string broken = body;
+    broken[position] = 100;
+    REQUIRE_EQUAL(ReadBinaryGraphRequest(broken, &request), -1);
+  }
+
+  // Слишком большое количество вершин.
+  std::string huge = body;
+  huge[23] = 0x10;
+  REQUIRE_EQUAL(ReadBinaryGraphRequest(huge, &request), -1);
+
+  // Поля не являются объектом JSON.
+  std::string fields = body;
+  fields[kBinaryGraphHeaderSize] = '[';
+  REQUIRE_EQUAL(ReadBinaryGraphRequest(fields, &request), -1);
+}
+
+/**
+ * @brief Отправить одно и то же сообщение в JSON и в бинарном формате.
+ *
+ * @param cli Указатель на HTTP клиент.
+ * @param path Адрес метода.
+ * @param input Сообщение.
+ */
+static void CompareFormats(httplib::Client* cli, const char* path,
+                           const nlohmann::json& input) {
+  std::string body;
+  REQUIRE_EQUAL(EncodeBinaryGraph(input, &body), 0);
+
+  httplib::Result json = cli->Post(path, input.dump(), "application/json");
+  httplib::Result binary = cli->Post(path, body, kBinaryGraphContentType);
+
+  REQUIRE_EQUAL(json->status, binary->status);
+  REQUIRE_EQUAL(binary->get_header_value("Content-Type"),
+                std::string(kBinaryGraphContentType));
+
+  nlohmann::json output;
+  REQUIRE_EQUAL(DecodeBinaryGraph(binary->body, &output), 0);
+  REQUIRE(output == nlohmann::json::parse(json->body));
+}
+
+/**
+ * @brief Все методы отвечают на бинарные запросы так же, как на JSON.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void EndpointsTest(httplib::Client* cli) {
+  std::mt19937 gen(16);
+  const size_t n = 60, m = 200;
+  nlohmann::json vertices = nlohmann::json::array();
+  nlohmann::json edges = nlohmann::json::array();
+  nlohmann::json weighted = nlohmann::json::array();
+  nlohmann::json triples = nlohmann::json::array();
+
+  for (size_t i = 0; i < n; i++)
+    vertices.push_back(i);
+
+  for (size_t i = 0; i < m; i++) {
+    size_t a = gen() % n, b = gen() % n;
+    const int w = static_cast<int>(gen() % 20);
+    if (a == b)
+      b = (b + 1) % n;
+
+    edges.push_back({a, b});
+    weighted.push_back({a, b, w});
+    triples.push_back(w);
+    triples.push_back(a);
+    triples.push_back(b);
+  }
+
+  // Для топологической сортировки рёбра идут от меньшей вершины к большей.
+  nlohmann::json acyclic = nlohmann::json::array();
+  for (const nlohmann::json& edge : edges) {
+    const size_t a = edge[0], b = edge[1];
+    acyclic.push_back({std::min(a, b), std::max(a, b)});
+  }
+
+  nlohmann::json graph = {{"id", 1}, {"type", "graph"}, {"size", n},
+                          {"numEdges", m}, {"vertices", vertices},
+                          {"edges", edges}};
+
+  CompareFormats(cli, "/FindBridges", graph);
+  CompareFormats(cli, "/CutPoints", graph);
+  CompareFormats(cli, "/Biconnected", graph);
+
+  nlohmann::json oriented = graph;
+  oriented["type"] = "oriented_graph";
+  oriented["edges"] = acyclic;
+  CompareFormats(cli, "/TopologicalSorting", oriented);
+
+  nlohmann::json network = graph;
+  network["type"] = "weighted_oriented_graph";
+  network["edges"] = weighted;
+  network["start"] = 0;
+  network["theEnd"] = n - 1;
+  CompareFormats(cli, "/Dinic", network);
+
+  nlohmann::json cycle = network;
+  cycle["TypeWeights"] = "double";
+  cycle["edges"].push_back({0, 1, -1000.5});
+  cycle["edges"].push_back({1, 0, 10});
+  cycle["numEdges"] = m + 2;
+  CompareFormats(cli, "/NegCycle", cycle);
+
+  nlohmann::json maximal = {{"id", 2}, {"type", "int"}, {"size", {m, n}},
+                            {"data", triples}};
+  CompareFormats(cli, "/Maximal", maximal);
+
+  nlohmann::json paths = {{"id", 3}, {"type", "double"},
+                          {"size", {m, n, 0}}, {"data", triples}};
+  CompareFormats(cli, "/Belmanf", paths);
+
+  // Некорректный бинарный запрос.
+  httplib::Result res = cli->Post("/Dinic", "GRPH", kBinaryGraphContentType);
+  REQUIRE_EQUAL(res->status, 400);
+}
+
+/**
+ * @brief На бинарный запрос приходит бинарный ответ.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void BinaryResponseTest(httplib::Client* cli) {
+  nlohmann::json input = R"({
+    "id": 7, "type": "graph", "size": 3, "numEdges": 2,
+    "vertices": [1, 2, 3], "edges": [[1, 2], [2, 3]]
+  })"_json;
+  std::string body;
+  REQUIRE_EQUAL(EncodeBinaryGraph(input, &body), 0);
+
+  httplib::Result res = cli->Post("/CutPoints", body, kBinaryGraphContentType);
+  REQUIRE_EQUAL(res->status, 200);
+  REQUIRE_EQUAL(res->body.compare(0, 4, "GRPH"), 0);
+
+  nlohmann::json output;
+  REQUIRE_EQUAL(DecodeBinaryGraph(res->body, &output), 0);
+  REQUIRE_EQUAL(output["id"], 7);
+  REQUIRE(output["data"] == nlohmann::json({2}));
+}
@@ -0,0 +1,252 @@
+/**
+ * @file csr_builder_test.cpp
+ *
+ * Тесты для класса graph::ParallelCsrBuilder.
+ */
+
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+#include "test_core.hpp"
+#include <csr_builder.hpp>
+#include <graph.hpp>
+#include <oriented_graph.hpp>
+#include <weighted_graph.hpp>
+#include <weighted_oriented_graph.hpp>
+
+using std::vector;
+using std::pair;
+using std::tuple;
+using std::random_device;
+using std::mt19937;
+using std::uniform_int_distribution;
+
+using graph::CsrGraph;
+using graph::Graph;
+using graph::OrientedGraph;
+using graph::ParallelCsrBuilder;
+using graph::WeightedGraph;
+using graph::WeightedOrientedGraph;
+
+static void EmptyTest();
+static void SimpleTest();
+static void RandomTest();
+static void FillGraphTest();
+
+/**
+ * @brief Основная функция для тестирования класса graph::ParallelCsrBuilder.
+ */
+void TestCsrBuilder() {
+  TestSuite suite("TestCsrBuilder");
+
+  RUN_TEST(suite, EmptyTest);
+  RUN_TEST(suite, SimpleTest);
+  RUN_TEST(suite, RandomTest);
+  RUN_TEST(suite, FillGraphTest);
+}
+
+/**
+ * @brief Проверить, что CSR графы совпадают поэлементно.
+ */
+template<typename Weight>
+static bool SameCsr(const CsrGraph<Weight>& a, const CsrGraph<Weight>& b) {
+  return a.Vertices() == b.Vertices() && a.Offsets() == b.Offsets() &&
+         a.Neighbours() == b.Neighbours() && a.Weights() == b.Weights() &&
+         a.ReverseOffsets() == b.ReverseOffsets() &&
+         a.ReverseNeighbours() == b.ReverseNeighbours() &&
+         a.ReverseWeights() == b.ReverseWeights() &&
+         a.Weighted() == b.Weighted();
+}
+
+/**
+ * @brief Проверить, что графы совпадают: вершины, рёбра и веса.
+ */
+template<typename First, typename Second>
+static bool SameGraphs(const First& first, const Second& second) {
+  if (first.NumVertices() != second.NumVertices())
+    return false;
+
+  for (size_t id : first.Vertices()) {
+    if (!second.HasVertex(id) ||
+        first.Edges(id).size() != second.Edges(id).size())
+      return false;
+
+    for (size_t neighbour : first.Edges(id)) {
+      if (!second.HasEdge(id, neighbour))
+        return false;
+
+      if constexpr (graph::IsWeightedGraph<First>::value)
+        if (first.EdgeWeight(id, neighbour) !=
+            second.EdgeWeight(id, neighbour))
+          return false;
+    }
+  }
+
+  return true;
+}
+
+/**
+ * @brief Тест на пустой список рёбер.
+ */
+static void EmptyTest() {
+  const vector<pair<size_t, size_t>> edges;
+
+  CsrGraph<> csr = ParallelCsrBuilder(4).Build<int>(edges.begin(),
+                                                    edges.end(), false);
+
+  REQUIRE_EQUAL(csr.NumVertices(), 0ul);
+  REQUIRE_EQUAL(csr.NumEdges(), 0ul);
+
+  csr = ParallelCsrBuilder(4).Build<int>(edges.begin(), edges.end(), true,
+                                         {5, 3, 5});
+
+  REQUIRE_EQUAL(csr.NumVertices(), size_t{2});
+  REQUIRE_EQUAL(csr.Id(0), size_t{3});
+  REQUIRE_EQUAL(csr.Edges(5).size(), 0ul);
+}
+
+/**
+ * @brief Тест на повторные рёбра и петли.
+ */
+static void SimpleTest() {
+  const vector<tuple<size_t, size_t, int>> edges = {
+    {1, 2, 3}, {3, 3, 1}, {1, 2, 7}, {2, 1, 4}, {10, 1, 9}
+  };
+
+  WeightedOrientedGraph<int> oriented;
+  WeightedGraph<int> undirected;
+  for (auto [from, to, weight] : edges) {
+    oriented.AddEdge(from, to, weight);
+    undirected.AddEdge(from, to, weight);
+  }
+
+  const CsrGraph<int> csr = ParallelCsrBuilder(2).Build<int>(
+      edges.begin(), edges.end(), false);
+
+  REQUIRE(SameCsr(csr, CsrGraph<int>(oriented)));
+  REQUIRE_EQUAL(csr.EdgeWeight(1, 2), 7);
+  REQUIRE_EQUAL(csr.IncomingEdges(1).size(), size_t{2});
+
+  const CsrGraph<int> symmetric = ParallelCsrBuilder(2).Build<int>(
+      edges.begin(), edges.end(), true);
+
+  REQUIRE(SameCsr(symmetric, CsrGraph<int>(undirected)));
+  REQUIRE_EQUAL(symmetric.EdgeWeight(2, 1), 4);
+  REQUIRE_EQUAL(symmetric.Edges(3).size(), size_t{1});
+}
+
+/**
+ * @brief Случайный тест: результат совпадает с CsrGraph, построенным из
+ * графа, и не зависит от количества потоков.
+ */
+static void RandomTest() {
+  // Используется для инициализации генератора случайных чисел.
+  random_device rd;
+  // Генератор случайных чисел.
+  mt19937 gen(rd());
+  // Распределение для номеров вершин (разреженных, чтобы вершины
+  // искались в хеш-таблице, а не в прямой таблице VertexIndex).
+  uniform_int_distribution<size_t> vertex(0, 1500);
+  // Распределение для весов рёбер.
+  uniform_int_distribution<int> weight(-100, 100);
+
+  // Достаточно рёбер, чтобы ParallelFor действительно делил работу.
+  vector<tuple<size_t, size_t, int>> weighted(20000);
+  vector<pair<size_t, size_t>> plain(weighted.size());
+  for (size_t i = 0; i < weighted.size(); i++) {
+    weighted[i] = {vertex(gen) * 1000, vertex(gen) * 1000, weight(gen)};
+    plain[i] = {std::get<0>(weighted[i]), std::get<1>(weighted[i])};
+  }
+  const vector<size_t> isolated = {7, 5000000, 7};
+
+  WeightedOrientedGraph<int> weightedOriented;
+  WeightedGraph<int> weightedUndirected;
+  OrientedGraph oriented;
+  Graph undirected;
+  for (size_t v : isolated) {
+    weightedOriented.AddVertex(v);
+    weightedUndirected.AddVertex(v);
+    oriented.AddVertex(v);
+    undirected.AddVertex(v);
+  }
+  for (auto [from, to, w] : weighted) {
+    weightedOriented.AddEdge(from, to, w);
+    weightedUndirected.AddEdge(from, to, w);
+    oriented.AddEdge(from, to);
+    undirected.AddEdge(from, to);
+  }
+
+  for (size_t numThreads : {1, 2, 3, 8}) {
+    const ParallelCsrBuilder builder(numThreads);
+
+    REQUIRE(SameCsr(builder.Build<int>(weighted.begin(), weighted.end(),
+                                       false, isolated),
+                    CsrGraph<int>(weightedOriented)));
+    REQUIRE(SameCsr(builder.Build<int>(weighted.begin(), weighted.end(),
+                                       true, isolated),
+                    CsrGraph<int>(weightedUndirected)));
+    REQUIRE(SameCsr(builder.Build<int>(plain.begin(), plain.end(), false,
+                                       isolated),
+                    CsrGraph<int>(oriented)));
+    REQUIRE(SameCsr(builder.Build<int>(plain.begin(), plain.end(), true,
+                                       isolated),
+                    CsrGraph<int>(undirected)));
+  }
+}
+
+/**
+ * @brief Тест на заполнение классов графов из CSR графа.
+ */
+static void FillGraphTest() {
+  random_device rd;
+  mt19937 gen(rd());
+  uniform_int_distribution<size_t> vertex(0, 300);
+  uniform_int_distribution<int> weight(-100, 100);
+
+  vector<tuple<size_t, size_t, int>> edges(5000);
+  for (auto& edge : edges)
+    edge = {vertex(gen), vertex(gen), weight(gen)};
+
+  const ParallelCsrBuilder builder(4);
+  const CsrGraph<int> csr = builder.Build<int>(edges.begin(), edges.end(),
+                                               false, {1000});
+  const CsrGraph<int> symmetric = builder.Build<int>(edges.begin(),
+                                                     edges.end(), true);
+
+  WeightedOrientedGraph<int> expectedOriented;
+  WeightedGraph<int> expectedUndirected;
+  OrientedGraph expectedPlain;
+  Graph expectedPlainUndirected;
+  expectedOriented.AddVertex(1000);
+  expectedPlain.AddVertex(1000);
+  for (auto [from, to, w] : edges) {
+    expectedOriented.AddEdge(from, to, w);
+    expectedUndirected.AddEdge(from, to, w);
+    expectedPlain.AddEdge(from, to);
+    expectedPlainUndirected.AddEdge(from, to);
+  }
+
+  WeightedOrientedGraph<int> weightedOriented;
+  graph::FillGraphFromCsr(csr, &weightedOriented);
+
+  REQUIRE(SameGraphs(expectedOriented, weightedOriented));
+
+  WeightedGraph<int> weightedUndirected;
+  graph::FillGraphFromCsr(symmetric, &weightedUndirected);
+
+  REQUIRE(SameGraphs(expectedUndirected, weightedUndirected));
+
+  OrientedGraph oriented;
+  graph::FillGraphFromCsr(csr, &oriented);
+
+  REQUIRE(SameGraphs(expectedPlain, oriented));
+  for (size_t v : expectedPlain.Vertices())
+    REQUIRE_EQUAL(oriented.IncomingEdges(v).size(),
+                  expectedPlain.IncomingEdges(v).size());
+
+  Graph undirected;
+  graph::FillGraphFromCsr(symmetric, &undirected);
+
+  REQUIRE(SameGraphs(expectedPlainUndirected, undirected));
+}
@@ -0,0 +1,214 @@
+/**
+ * @file csr_graph_test.cpp
+ *
+ * Тесты для класса graph::CsrGraph.
+ */
+
+#include <algorithm>
+#include <random>
+#include <vector>
+#include "test_core.hpp"
+#include <csr_graph.hpp>
+#include <cut_points.hpp>
+#include <graph.hpp>
+#include <oriented_graph.hpp>
+#include <weighted_graph.hpp>
+#include <weighted_oriented_graph.hpp>
+
+using std::vector;
+using std::out_of_range;
+using std::random_device;
+using std::mt19937;
+using std::uniform_int_distribution;
+
+using graph::CsrGraph;
+using graph::Graph;
+using graph::OrientedGraph;
+using graph::WeightedGraph;
+using graph::WeightedOrientedGraph;
+
+static void EmptyGraphTest();
+static void OrientedGraphTest();
+static void WeightedGraphTest();
+static void RandomTest();
+static void AlgorithmTest();
+
+/**
+ * @brief Основная функция для тестирования класса graph::CsrGraph.
+ */
+void TestCsrGraph() {
+  TestSuite suite("TestCsrGraph");
+
+  RUN_TEST(suite, EmptyGraphTest);
+  RUN_TEST(suite, OrientedGraphTest);
+  RUN_TEST(suite, WeightedGraphTest);
+  RUN_TEST(suite, RandomTest);
+  RUN_TEST(suite, AlgorithmTest);
+}
+
+/**
+ * @brief Тест на пустой граф.
+ */
+static void EmptyGraphTest() {
+  Graph graph;
+  CsrGraph<> csr(graph);
+
+  REQUIRE_EQUAL(csr.NumVertices(), 0ul);
+  REQUIRE_EQUAL(csr.NumEdges(), 0ul);
+  REQUIRE_EQUAL(csr.HasVertex(1), false);
+  REQUIRE_EQUAL(csr.HasEdge(1, 2), false);
+  REQUIRE_THROW(csr.Edges(1), out_of_range);
+  REQUIRE_THROW(csr.IncomingEdges(1), out_of_range);
+}
+
+/**
+ * @brief Тест на ориентированный граф.
+ */
+static void OrientedGraphTest() {
+  OrientedGraph graph;
+
+  graph.AddVertex(7);
+  graph.AddEdge(1, 5);
+  graph.AddEdge(1, 3);
+  graph.AddEdge(3, 5);
+  graph.AddEdge(5, 1);
+
+  CsrGraph<> csr(graph);
+
+  REQUIRE_EQUAL(csr.NumVertices(), 4ul);
+  REQUIRE_EQUAL(csr.NumEdges(), 4ul);
+  REQUIRE_EQUAL(csr.Weighted(), false);
+  REQUIRE(csr.Vertices() == vector<size_t>({1, 3, 5, 7}));
+
+  REQUIRE(csr.HasEdge(1, 5));
+  REQUIRE(csr.HasEdge(1, 3));
+  REQUIRE(csr.HasEdge(5, 1));
+  REQUIRE_EQUAL(csr.HasEdge(5, 3), false);
+  REQUIRE_EQUAL(csr.HasEdge(7, 1), false);
+
+  vector<size_t> out(csr.Edges(1).begin(), csr.Edges(1).end());
+  REQUIRE(out == vector<size_t>({3, 5}));
+
+  vector<size_t> in(csr.IncomingEdges(5).begin(),
+                    csr.IncomingEdges(5).end());
+  REQUIRE(in == vector<size_t>({1, 3}));
+
+  REQUIRE_EQUAL(csr.Edges(7).size(), 0ul);
+  REQUIRE_EQUAL(csr.IncomingEdges(7).size(), 0ul);
+  REQUIRE_THROW(csr.EdgeWeight(1, 5), out_of_range);
+}
+
+/**
+ * @brief Тест на взвешенные графы.
+ */
+static void WeightedGraphTest() {
+  {
+    WeightedOrientedGraph<double> graph;
+
+    graph.AddEdge(2, 4, 1.5);
+    graph.AddEdge(4, 2, -2.0);
+    graph.AddEdge(2, 8, 3.0);
+
+    CsrGraph<double> csr(graph);
+
+    REQUIRE(csr.Weighted());
+    REQUIRE_EQUAL(csr.EdgeWeight(2, 4), 1.5);
+    REQUIRE_EQUAL(csr.EdgeWeight(4, 2), -2.0);
+    REQUIRE_EQUAL(csr.EdgeWeight(2, 8), 3.0);
+    REQUIRE_THROW(csr.EdgeWeight(8, 2), out_of_range);
+
+    const size_t i = csr.Index(8);
+    const size_t k = csr.ReverseOffsets()[i];
+
+    REQUIRE_EQUAL(csr.ReverseOffsets()[i + 1] - k, 1ul);
+    REQUIRE_EQUAL(csr.Id(csr.ReverseNeighbours()[k]), 2ul);
+    REQUIRE_EQUAL(csr.ReverseWeights()[k], 3.0);
+  }
+
+  {
+    WeightedGraph<int> graph;
+
+    graph.AddEdge(1, 2, 10);
+    graph.AddEdge(2, 3, 20);
+
+    CsrGraph<int> csr(graph);
+
+    REQUIRE_EQUAL(csr.NumEdges(), 4ul);
+    REQUIRE_EQUAL(csr.EdgeWeight(1, 2), 10);
+    REQUIRE_EQUAL(csr.EdgeWeight(2, 1), 10);
+    REQUIRE_EQUAL(csr.EdgeWeight(3, 2), 20);
+    REQUIRE_EQUAL(csr.IncomingEdges(2).size(), 2ul);
+  }
+}
+
+/**
+ * @brief Случайный тест: CSR представление совпадает с исходным графом.
+ */
+static void RandomTest() {
+  // Используется для инициализации генератора случайных чисел.
+  random_device rd;
+  // Генератор случайных чисел.
+  mt19937 gen(rd());
+  // Распределение для номеров вершин.
+  uniform_int_distribution<size_t> vertex(0, 200);
+  // Распределение для весов рёбер.
+  uniform_int_distribution<int> weight(-100, 100);
+
+  WeightedOrientedGraph<int> graph;
+
+  for (size_t i = 0; i < 1000; i++)
+    graph.AddEdge(vertex(gen), vertex(gen), weight(gen));
+
+  CsrGraph<int> csr(graph);
+
+  REQUIRE_EQUAL(csr.NumVertices(), graph.NumVertices());
+
+  size_t numEdges = 0;
+
+  for (size_t v : graph.Vertices()) {
+    REQUIRE(csr.HasVertex(v));
+    REQUIRE_EQUAL(csr.Edges(v).size(), graph.Edges(v).size());
+    REQUIRE_EQUAL(csr.IncomingEdges(v).size(),
+                  graph.IncomingEdges(v).size());
+
+    for (size_t to : graph.Edges(v)) {
+      REQUIRE(csr.HasEdge(v, to));
+      REQUIRE_EQUAL(csr.EdgeWeight(v, to), graph.EdgeWeight(v, to));
+    }
+
+    for (size_t to : csr.Edges(v))
+      REQUIRE(graph.HasEdge(v, to));
+
+    for (size_t from : csr.IncomingEdges(v))
+      REQUIRE(graph.HasEdge(from, v));
+
+    numEdges += graph.Edges(v).size();
+  }
+
+  REQUIRE_EQUAL(csr.NumEdges(), numEdges);
+}
+
+/**
+ * @brief Тест на запуск алгоритма на CSR представлении.
+ */
+static void AlgorithmTest() {
+  Graph graph;
+
+  graph.AddEdge(1, 2);
+  graph.AddEdge(2, 3);
+  graph.AddEdge(3, 1);
+  graph.AddEdge(3, 4);
+  graph.AddEdge(4, 5);
+
+  vector<size_t> expected;
+  vector<size_t> result;
+
+  graph::CutPoints(graph, &expected);
+  graph::CutPoints(CsrGraph<>(graph), &result);
+
+  std::sort(expected.begin(), expected.end());
+  std::sort(result.begin(), result.end());
+
+  REQUIRE(result == expected);
+  REQUIRE(result == vector<size_t>({3, 4}));
+}
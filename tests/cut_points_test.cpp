@@ -5,12 +5,16 @@
 
 #include <cut_points.hpp>
 #include <httplib.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include "test_core.hpp"
 #include "test.hpp"
 
 static void SimpleTest(httplib::Client* cli);
 static void RandomTest(httplib::Client* cli);
+static void LongChainTest();
 
 template<typename T>
 static void RandomIntegerHelperTest(httplib::Client* cli, std::string type);
@@ -23,6 +27,7 @@ void TestCutPoints(httplib::Client* cli) {
   TestSuite suite("TestCutPoints");
   RUN_TEST_REMOTE(suite, cli, SimpleTest);
   RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST(suite, LongChainTest);
 }
 
 /** 
@@ -139,3 +144,23 @@ static void RandomTest(httplib::Client* cli) {
     REQUIRE(find);
   }
 }
+
+/**
+ * @brief Тест на длинной цепочке: обход не должен переполнять стек.
+ */
+static void LongChainTest() {
+  const size_t n = 500000;
+  graph::Graph graph;
+
+  for (size_t i = 0; i + 1 < n; i++)
+    graph.AddEdge(i, i + 1);
+
+  std::vector<size_t> points;
+  graph::CutPoints(graph, &points);
+
+  REQUIRE_EQUAL(n - 2, points.size());
+
+  std::sort(points.begin(), points.end());
+  for (size_t i = 0; i < points.size(); i++)
+    REQUIRE_EQUAL(i + 1, points[i]);
+}
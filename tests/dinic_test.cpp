@@ -5,6 +5,7 @@
  * Реализация набора тестов для метода поиска мостов.
  */
 #include <dinic.hpp>
+#include <push_relabel.hpp>
 #include <httplib.h>
 #include <nlohmann/json.hpp>
 #include "test_core.hpp"
@@ -12,12 +13,18 @@
 
 static void SimpleTest(httplib::Client *cli);
 static void RandomTest(httplib::Client *cli);
+static void FloatingPointTest();
+static void AlgorithmTest(httplib::Client *cli);
+static void PushRelabelTest();
 
 void TestDinic(httplib::Client *cli) {
   TestSuite suite("TestDinic");
 
   RUN_TEST_REMOTE(suite, cli, SimpleTest);
   RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST(suite, FloatingPointTest);
+  RUN_TEST_REMOTE(suite, cli, AlgorithmTest);
+  RUN_TEST(suite, PushRelabelTest);
 }
 
 /** 
@@ -244,3 +251,128 @@ static void RandomTest(httplib::Client *cli) {
     REQUIRE_EQUAL((s <= n), true);
   }
 }
+
+/**
+ * @brief Тест на граф с дробными пропускными способностями.
+ *
+ * Поток не должен округляться до целых чисел.
+ */
+static void FloatingPointTest() {
+  graph::WeightedOrientedGraph<double> g;
+  graph::WeightedOrientedGraph<double> result;
+
+  g.AddEdge(1, 2, 0.5);
+  g.AddEdge(1, 3, 1.25);
+  g.AddEdge(2, 4, 2.0);
+  g.AddEdge(3, 2, 0.75);
+  g.AddEdge(3, 4, 0.25);
+
+  REQUIRE_EQUAL(graph::Dinic(g, &result, 1, 4), 1.5);
+  REQUIRE_EQUAL(result.EdgeWeight(1, 2), 0.5);
+  REQUIRE_EQUAL(result.EdgeWeight(1, 3), 1.0);
+  REQUIRE_EQUAL(result.EdgeWeight(3, 2), 0.75);
+  REQUIRE_EQUAL(result.EdgeWeight(2, 4), 1.25);
+  REQUIRE_EQUAL(result.EdgeWeight(3, 4), 0.25);
+
+  REQUIRE_EQUAL(graph::Dinic(g, &result, 1, 5), 0.0);
+  REQUIRE_EQUAL(result.NumVertices(), 4ul);
+}
+
+/**
+ * @brief Тест на выбор алгоритма полем "algorithm".
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void AlgorithmTest(httplib::Client *cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 3,
+    "type": "weighted_oriented_graph",
+    "size": 4,
+    "vertices": [1, 2, 3, 4],
+    "numEdges": 6,
+    "start": 1,
+    "theEnd": 4,
+    "edges": [[1,2,5],[1,3,2],[2,3,5],[3,1,3],[3,4,8],[1,4,1]]
+  }
+)"_json;
+
+  for (std::string algorithm : {"dinic", "push_relabel"}) {
+    input["algorithm"] = algorithm;
+
+    httplib::Result res = cli->Post("/Dinic", input.dump(),
+        "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+
+    REQUIRE_EQUAL(200, res->status);
+    REQUIRE_EQUAL(algorithm, output["algorithm"]);
+    REQUIRE_EQUAL(6, output["numEdges"]);
+
+    size_t flow = 0;
+    for (size_t i = 0; i < output.at("numEdges"); i++)
+      if (output.at("edges").at(i).at(1) == 4)
+        flow += static_cast<size_t>(output.at("edges").at(i).at(2));
+
+    REQUIRE_EQUAL(8ul, flow);
+  }
+
+  input["algorithm"] = "ford_fulkerson";
+
+  httplib::Result res = cli->Post("/Dinic", input.dump(),
+      "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+}
+
+/**
+ * @brief Случайный тест: проталкивание предпотока находит поток той же
+ *        величины, что и алгоритм Диница.
+ */
+static void PushRelabelTest() {
+  // Число попыток.
+  const int numTries = 50;
+  // Используется для инициализации генератора случайных чисел.
+  std::random_device rd;
+  // Генератор случайных чисел.
+  std::mt19937 gen(rd());
+  // Распределение для количества вершин.
+  std::uniform_int_distribution<size_t> graphSize(2, 40);
+  // Распределение весов рёбер.
+  std::uniform_int_distribution<int> weight(0, 20);
+
+  for (int it = 0; it < numTries; it++) {
+    const size_t size = graphSize(gen);
+    std::uniform_int_distribution<size_t> vertex(1, size);
+    std::uniform_int_distribution<size_t> numEdges(size, size * size);
+
+    graph::WeightedOrientedGraph<int> g;
+    for (size_t v = 1; v <= size; v++)
+      g.AddVertex(v);
+
+    const size_t edges = numEdges(gen);
+    for (size_t i = 0; i < edges; i++)
+      g.AddEdge(vertex(gen), vertex(gen), weight(gen));
+
+    graph::WeightedOrientedGraph<int> dinic, pushRelabel;
+
+    const int expected = graph::Dinic(g, &dinic, 1, size);
+
+    REQUIRE_EQUAL(expected, graph::PushRelabel(g, &pushRelabel, 1, size));
+
+    // Поток не превышает пропускных способностей и сохраняется в вершинах.
+    std::vector<int> balance(size + 1, 0);
+    for (size_t v : g.Vertices()) {
+      for (const auto& [to, capacity] : g.WeightedEdges(v)) {
+        const int flow = pushRelabel.EdgeWeight(v, to);
+
+        REQUIRE(flow >= 0 && flow <= capacity);
+        balance[v] -= flow;
+        balance[to] += flow;
+      }
+    }
+
+    for (size_t v = 2; v < size; v++)
+      REQUIRE_EQUAL(0, balance[v]);
+    REQUIRE_EQUAL(expected, balance[size]);
+  }
+}
@@ -0,0 +1,89 @@
+/**
+ * @file disjoint_set_test.cpp
+ *
+ * Тесты для класса graph::DisjointSet.
+ */
+
+#include <random>
+#include <vector>
+#include "test_core.hpp"
+#include <disjoint_set.hpp>
+
+using std::vector;
+
+using graph::DisjointSet;
+
+static void SimpleTest();
+static void RandomTest();
+
+/**
+ * @brief Основная функция для тестирования класса graph::DisjointSet.
+ */
+void TestDisjointSet() {
+  TestSuite suite("TestDisjointSet");
+
+  RUN_TEST(suite, SimpleTest);
+  RUN_TEST(suite, RandomTest);
+}
+
+/**
+ * @brief Простейший статический тест.
+ */
+static void SimpleTest() {
+  DisjointSet sets(5);
+
+  REQUIRE_EQUAL(sets.NumElements(), 5ul);
+  REQUIRE_EQUAL(sets.NumSets(), 5ul);
+  REQUIRE(!sets.Connected(0, 1));
+
+  REQUIRE(sets.Union(0, 1));
+  REQUIRE(sets.Union(3, 4));
+  REQUIRE(sets.Union(1, 4));
+  REQUIRE(!sets.Union(0, 3));
+
+  REQUIRE_EQUAL(sets.NumSets(), 2ul);
+  REQUIRE(sets.Connected(0, 3));
+  REQUIRE(!sets.Connected(2, 3));
+  REQUIRE_EQUAL(sets.SetSize(4), 4ul);
+  REQUIRE_EQUAL(sets.SetSize(2), 1ul);
+}
+
+/**
+ * @brief Случайный тест: сравнение с наивной разметкой компонент.
+ */
+static void RandomTest() {
+  // Используется для инициализации генератора случайных чисел.
+  std::random_device rd;
+  // Генератор случайных чисел.
+  std::mt19937 gen(rd());
+  // Количество элементов.
+  const size_t n = 200;
+  // Распределение для элементов.
+  std::uniform_int_distribution<size_t> elem(0, n - 1);
+
+  DisjointSet sets(n);
+  vector<size_t> component(n);
+  size_t numComponents = n;
+
+  for (size_t i = 0; i < n; i++)
+    component[i] = i;
+
+  for (size_t it = 0; it < 300; it++) {
+    const size_t x = elem(gen), y = elem(gen);
+    const size_t cx = component[x], cy = component[y];
+
+    REQUIRE_EQUAL(sets.Union(x, y), cx != cy);
+
+    if (cx != cy) {
+      for (size_t i = 0; i < n; i++)
+        if (component[i] == cy)
+          component[i] = cx;
+      numComponents--;
+    }
+
+    REQUIRE_EQUAL(sets.NumSets(), numComponents);
+
+    const size_t a = elem(gen), b = elem(gen);
+    REQUIRE_EQUAL(sets.Connected(a, b), component[a] == component[b]);
+  }
+}
@@ -7,6 +7,9 @@
 
 #include <find_bridges.hpp>
 #include <httplib.h>
+#include <algorithm>
+#include <utility>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include "test_core.hpp"
 #include "test.hpp"
@@ -14,12 +17,14 @@
 
 static void SimpleTest(httplib::Client* cli);
 static void RandomTest(httplib::Client* cli);
+static void LongChainTest();
 
 void TestFindBridges(httplib::Client* cli) {
   TestSuite suite("TestFindBridges");
 
   RUN_TEST_REMOTE(suite, cli, SimpleTest);
   RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST(suite, LongChainTest);
 }
 
 /**
@@ -192,3 +197,23 @@ static void RandomTest(httplib::Client* cli) {
     REQUIRE_EQUAL(true, find);
   }
 }
+
+/**
+ * @brief Тест на длинной цепочке: обход не должен переполнять стек.
+ */
+static void LongChainTest() {
+  const size_t n = 500000;
+  graph::Graph graph;
+
+  for (size_t i = 0; i + 1 < n; i++)
+    graph.AddEdge(i, i + 1);
+
+  std::vector<std::pair<size_t, size_t>> bridges;
+  graph::FindBridges(graph, &bridges);
+
+  REQUIRE_EQUAL(n - 1, bridges.size());
+
+  for (auto& [a, b] : bridges) {
+    REQUIRE_EQUAL(a + 1, b);
+  }
+}
@@ -0,0 +1,326 @@
+/**
+ * @file tests/flat_hash_test.cpp
+ *
+ * Тесты для хеш-таблиц с открытой адресацией и политик контейнеров.
+ */
+
+#include <algorithm>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "test_core.hpp"
+#include <flat_hash.hpp>
+#include <graph.hpp>
+#include <oriented_graph.hpp>
+#include <weighted_oriented_graph.hpp>
+
+using std::out_of_range;
+using std::string;
+using std::unordered_map;
+using std::unordered_set;
+using std::vector;
+
+using graph::BasicGraph;
+using graph::Graph;
+using graph::FlatHashMap;
+using graph::FlatHashSet;
+using graph::OrientedGraph;
+using graph::StdHashContainers;
+using graph::WeightedOrientedGraph;
+
+static void SetTest();
+static void MapTest();
+static void CopyTest();
+static void RandomTest();
+static void PolicyTest();
+static void AllocatorTest();
+
+/**
+ * @brief Основная функция для тестирования классов graph::FlatHashSet
+ *        и graph::FlatHashMap.
+ */
+void TestFlatHash() {
+  TestSuite suite("TestFlatHash");
+
+  RUN_TEST(suite, SetTest);
+  RUN_TEST(suite, MapTest);
+  RUN_TEST(suite, CopyTest);
+  RUN_TEST(suite, RandomTest);
+  RUN_TEST(suite, PolicyTest);
+  RUN_TEST(suite, AllocatorTest);
+}
+
+/**
+ * @brief Простые операции с множеством.
+ */
+static void SetTest() {
+  FlatHashSet<size_t> set;
+
+  REQUIRE(set.empty());
+  REQUIRE(set.begin() == set.end());
+  REQUIRE(set.find(1) == set.end());
+  REQUIRE_EQUAL(set.erase(1), 0ul);
+
+  REQUIRE(set.insert(1).second);
+  REQUIRE(!set.insert(1).second);
+  REQUIRE(set.insert(5).second);
+  REQUIRE_EQUAL(*set.insert(7).first, 7ul);
+  REQUIRE_EQUAL(set.size(), 3ul);
+  REQUIRE_EQUAL(set.count(5), 1ul);
+  REQUIRE_EQUAL(set.count(6), 0ul);
+
+  vector<size_t> items(set.begin(), set.end());
+  std::sort(items.begin(), items.end());
+  REQUIRE(items == vector<size_t>({1, 5, 7}));
+
+  REQUIRE_EQUAL(set.erase(5), 1ul);
+  REQUIRE_EQUAL(set.count(5), 0ul);
+  REQUIRE_EQUAL(set.size(), 2ul);
+
+  set.clear();
+  REQUIRE(set.empty());
+  REQUIRE_EQUAL(set.count(1), 0ul);
+}
+
+/**
+ * @brief Простые операции со словарём.
+ */
+static void MapTest() {
+  FlatHashMap<size_t, string> map;
+
+  REQUIRE_THROW(map.at(1), out_of_range);
+
+  map[1] = "one";
+  map[2];
+  REQUIRE_EQUAL(map.size(), 2ul);
+  REQUIRE_EQUAL(map.at(1), string("one"));
+  REQUIRE(map.at(2).empty());
+
+  REQUIRE(!map.emplace(1, "uno").second);
+  REQUIRE(map.emplace(3, "three").second);
+  REQUIRE_EQUAL(map.find(3)->second, string("three"));
+
+  map.find(2)->second = "two";
+  const FlatHashMap<size_t, string>& constMap = map;
+  REQUIRE_EQUAL(constMap.at(2), string("two"));
+  REQUIRE(constMap.find(4) == constMap.end());
+
+  size_t sum = 0;
+  for (const auto& [key, value] : constMap) {
+    sum += key;
+    REQUIRE(!value.empty());
+  }
+  REQUIRE_EQUAL(sum, 6ul);
+
+  REQUIRE_EQUAL(map.erase(1), 1ul);
+  REQUIRE_THROW(constMap.at(1), out_of_range);
+}
+
+/**
+ * @brief Копирование, перемещение и резервирование.
+ */
+static void CopyTest() {
+  FlatHashMap<size_t, FlatHashSet<size_t>> map;
+  for (size_t i = 0; i < 100; i++)
+    map[i % 10].insert(i);
+
+  FlatHashMap<size_t, FlatHashSet<size_t>> copy = map;
+  map[0].erase(0);
+  REQUIRE_EQUAL(copy.at(0).count(0), 1ul);
+  REQUIRE_EQUAL(map.at(0).count(0), 0ul);
+
+  FlatHashMap<size_t, FlatHashSet<size_t>> moved = std::move(copy);
+  REQUIRE_EQUAL(moved.size(), 10ul);
+  REQUIRE_EQUAL(moved.at(9).size(), 10ul);
+
+  copy = moved;
+  copy = copy;
+  REQUIRE_EQUAL(copy.size(), 10ul);
+
+  FlatHashSet<size_t> set;
+  set.reserve(1000);
+  for (size_t i = 0; i < 1000; i++)
+    set.insert(i * 1024);
+  REQUIRE_EQUAL(set.size(), 1000ul);
+  for (size_t i = 0; i < 1000; i++)
+    REQUIRE_EQUAL(set.count(i * 1024), 1ul);
+}
+
+/**
+ * @brief Случайные операции дают тот же результат, что и со
+ *        std::unordered_map.
+ */
+static void RandomTest() {
+  std::mt19937 gen(21);
+
+  // Плотные, разреженные и кратные степени двойки ключи.
+  for (size_t stride : {1ul, 1ul << 20, 1000003ul}) {
+    FlatHashMap<size_t, size_t> map;
+    unordered_map<size_t, size_t> expected;
+
+    for (size_t step = 0; step < 20000; step++) {
+      const size_t key = (gen() % 2000) * stride;
+      const size_t value = gen();
+
+      switch (gen() % 4) {
+        case 0:
+        case 1:
+          map[key] = value;
+          expected[key] = value;
+          break;
+        case 2:
+          REQUIRE_EQUAL(map.erase(key), expected.erase(key));
+          break;
+        default:
+          REQUIRE_EQUAL(map.count(key), expected.count(key));
+          if (expected.count(key) != 0)
+            REQUIRE_EQUAL(map.at(key), expected.at(key));
+      }
+
+      REQUIRE_EQUAL(map.size(), expected.size());
+    }
+
+    size_t visited = 0;
+    for (const auto& [key, value] : map) {
+      REQUIRE_EQUAL(expected.at(key), value);
+      visited++;
+    }
+    REQUIRE_EQUAL(visited, expected.size());
+  }
+}
+
+/**
+ * @brief Графы с разными политиками контейнеров ведут себя одинаково.
+ */
+static void PolicyTest() {
+  std::mt19937 gen(2021);
+  graph::Graph flat;
+  BasicGraph<StdHashContainers> nodes;
+  WeightedOrientedGraph<int> flatWeighted;
+  WeightedOrientedGraph<int, StdHashContainers> nodesWeighted;
+
+  for (size_t step = 0; step < 5000; step++) {
+    const size_t a = gen() % 100, b = gen() % 100;
+    const int w = static_cast<int>(gen() % 10);
+
+    switch (gen() % 5) {
+      case 0:
+        flat.RemoveVertex(a);
+        nodes.RemoveVertex(a);
+        flatWeighted.RemoveVertex(a);
+        nodesWeighted.RemoveVertex(a);
+        break;
+      case 1:
+        flat.RemoveEdge(a, b);
+        nodes.RemoveEdge(a, b);
+        flatWeighted.RemoveEdge(a, b);
+        nodesWeighted.RemoveEdge(a, b);
+        break;
+      default:
+        flat.AddEdge(a, b);
+        nodes.AddEdge(a, b);
+        flatWeighted.AddEdge(a, b, w);
+        nodesWeighted.AddEdge(a, b, w);
+    }
+  }
+
+  REQUIRE_EQUAL(flat.NumVertices(), nodes.NumVertices());
+  REQUIRE_EQUAL(flatWeighted.NumVertices(), nodesWeighted.NumVertices());
+
+  for (size_t v : nodes.Vertices()) {
+    unordered_set<size_t> neighbours(flat.Edges(v).begin(),
+                                     flat.Edges(v).end());
+    REQUIRE(neighbours == nodes.Edges(v));
+  }
+
+  for (size_t v : nodesWeighted.Vertices()) {
+    REQUIRE_EQUAL(flatWeighted.Edges(v).size(),
+                  nodesWeighted.Edges(v).size());
+    REQUIRE_EQUAL(flatWeighted.IncomingEdges(v).size(),
+                  nodesWeighted.IncomingEdges(v).size());
+    for (size_t u : nodesWeighted.Edges(v))
+      REQUIRE_EQUAL(flatWeighted.EdgeWeight(v, u),
+                    nodesWeighted.EdgeWeight(v, u));
+  }
+}
+
+/**
+ * @brief Источник памяти, считающий выделенные байты.
+ */
+class CountingResource : public std::pmr::memory_resource {
+ public:
+  //! Количество выделенных и ещё не освобождённых байт.
+  size_t bytes = 0;
+  //! Количество выделений памяти.
+  size_t allocations = 0;
+
+ private:
+  void* do_allocate(size_t size, size_t alignment) override {
+    bytes += size;
+    allocations++;
+    return std::pmr::new_delete_resource()->allocate(size, alignment);
+  }
+
+  void do_deallocate(void* p, size_t size, size_t alignment) override {
+    bytes -= size;
+    std::pmr::new_delete_resource()->deallocate(p, size, alignment);
+  }
+
+  bool do_is_equal(const memory_resource& other) const noexcept override {
+    return this == &other;
+  }
+};
+
+/**
+ * @brief Граф берёт всю память из своего аллокатора.
+ */
+static void AllocatorTest() {
+  CountingResource resource;
+
+  {
+    OrientedGraph graph{OrientedGraph::allocator_type(&resource)};
+    REQUIRE(graph.get_allocator().resource() == &resource);
+
+    // Вершина 0 с большим количеством соседей выносит их в хеш-таблицу.
+    for (size_t i = 1; i <= 1000; i++) {
+      graph.AddEdge(0, i);
+      graph.AddEdge(i, i % 1000 + 1);
+    }
+    REQUIRE(resource.allocations > 0);
+    const size_t bytes = resource.bytes;
+
+    // Копия не зависит от памяти оригинала.
+    OrientedGraph copy = graph;
+    REQUIRE(copy.get_allocator().resource() ==
+            std::pmr::get_default_resource());
+    for (size_t i = 1; i <= 1000; i++)
+      copy.AddEdge(i, 0);
+    REQUIRE_EQUAL(resource.bytes, bytes);
+
+    // Перемещённый граф забирает аллокатор вместе с памятью.
+    OrientedGraph moved = std::move(graph);
+    REQUIRE(moved.get_allocator().resource() == &resource);
+    moved.RemoveVertex(0);
+    moved.AddEdge(5000, 5001);
+    REQUIRE_EQUAL(moved.Edges(1).size(), 1ul);
+
+    copy = std::move(moved);
+    REQUIRE(copy.get_allocator().resource() == &resource);
+  }
+
+  // Вся память возвращена в тот же источник.
+  REQUIRE_EQUAL(resource.bytes, 0ul);
+
+  {
+    Graph graph{Graph::allocator_type(&resource)};
+    for (size_t i = 0; i < 100; i++)
+      graph.AddEdge(i, (i * 7) % 100);
+    graph = Graph();
+    REQUIRE_EQUAL(resource.bytes, 0ul);
+  }
+}
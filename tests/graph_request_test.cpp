@@ -0,0 +1,205 @@
+/**
+ * @file tests/graph_request_test.cpp
+ *
+ * Тесты для потокового чтения запросов к серверу.
+ */
+
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <graph.hpp>
+#include <weighted_oriented_graph.hpp>
+#include "test_core.hpp"
+#include "test.hpp"
+#include "../methods/graph_request.hpp"
+
+using graph::FillGraph;
+using graph::Graph;
+using graph::GraphRequest;
+using graph::ReadGraphRequest;
+using graph::WeightedOrientedGraph;
+
+static void EdgesTest();
+static void WeightedEdgesTest();
+static void DataTest();
+static void FieldsTest();
+static void InvalidTest();
+static void DomTest();
+
+void TestGraphRequest() {
+  TestSuite suite("TestGraphRequest");
+
+  RUN_TEST(suite, EdgesTest);
+  RUN_TEST(suite, WeightedEdgesTest);
+  RUN_TEST(suite, DataTest);
+  RUN_TEST(suite, FieldsTest);
+  RUN_TEST(suite, InvalidTest);
+  RUN_TEST(suite, DomTest);
+}
+
+/**
+ * @brief Невзвешенные рёбра в формате [откуда, куда].
+ */
+static void EdgesTest() {
+  GraphRequest request;
+
+  REQUIRE_EQUAL(ReadGraphRequest(R"({
+    "edges": [[0, 1], [1, 2.0]],
+    "id": 3,
+    "numEdges": 2,
+    "size": 4,
+    "type": "graph",
+    "vertices": [0, 1, 2, 7]
+  })", &request), 0);
+
+  REQUIRE(request.vertices == std::vector<size_t>({0, 1, 2, 7}));
+  REQUIRE(request.edges == std::vector<size_t>({0, 1, 1, 2}));
+  REQUIRE(request.weights.empty());
+  REQUIRE_EQUAL(request.NumEdges(), size_t{2});
+  REQUIRE(!request.fields.contains("edges"));
+  REQUIRE(!request.fields.contains("vertices"));
+
+  Graph graph;
+  REQUIRE_EQUAL(FillGraph(request, 4, 2, &graph), 0);
+  REQUIRE_EQUAL(graph.NumVertices(), size_t{4});
+  REQUIRE(graph.HasEdge(0, 1));
+  REQUIRE(graph.HasEdge(2, 1));
+  REQUIRE(!graph.HasEdge(0, 2));
+
+  // Вершин и рёбер меньше, чем заявлено.
+  Graph other;
+  REQUIRE_EQUAL(FillGraph(request, 5, 2, &other), -1);
+  REQUIRE_EQUAL(FillGraph(request, 4, 3, &other), -1);
+}
+
+/**
+ * @brief Взвешенные рёбра в формате [откуда, куда, вес].
+ */
+static void WeightedEdgesTest() {
+  GraphRequest request;
+
+  REQUIRE_EQUAL(ReadGraphRequest(R"({
+    "edges": [[1, 2, -3], [2, 1, 2.5]],
+    "vertices": [1, 2]
+  })", &request), 0);
+
+  REQUIRE(request.edges == std::vector<size_t>({1, 2, 2, 1}));
+  REQUIRE(request.weights == std::vector<double>({-3, 2.5}));
+
+  WeightedOrientedGraph<double> graph;
+  REQUIRE_EQUAL(FillGraph(request, 2, 2, &graph), 0);
+  REQUIRE_EQUAL(graph.EdgeWeight(1, 2), -3.0);
+  REQUIRE_EQUAL(graph.EdgeWeight(2, 1), 2.5);
+
+  // У невзвешенных рёбер нельзя взять веса.
+  GraphRequest unweighted;
+  WeightedOrientedGraph<int> other;
+  REQUIRE_EQUAL(ReadGraphRequest(R"({"edges": [[1, 2]]})", &unweighted), 0);
+  REQUIRE_EQUAL(FillGraph(unweighted, 0, 1, &other), -1);
+}
+
+/**
+ * @brief Тройки (вес, откуда, куда) в поле "data".
+ */
+static void DataTest() {
+  GraphRequest request;
+
+  REQUIRE_EQUAL(ReadGraphRequest(R"({
+    "data": [5, 1, 2, -1.5, 2, 3],
+    "size": [2, 3, 1],
+    "type": "double"
+  })", &request), 0);
+
+  REQUIRE(request.edges == std::vector<size_t>({1, 2, 2, 3}));
+  REQUIRE(request.weights == std::vector<double>({5, -1.5}));
+  REQUIRE(request.fields.at("size") == nlohmann::json({2, 3, 1}));
+}
+
+/**
+ * @brief Остальные поля сохраняются как JSON.
+ */
+static void FieldsTest() {
+  GraphRequest request;
+
+  REQUIRE_EQUAL(ReadGraphRequest(R"({
+    "id": 1,
+    "nested": {"vertices": [1, {"a": null}], "b": [true, "x"]},
+    "outputs": ["bridges", "blocks"],
+    "vertices": []
+  })", &request), 0);
+
+  const nlohmann::json expected = R"({
+    "id": 1,
+    "nested": {"vertices": [1, {"a": null}], "b": [true, "x"]},
+    "outputs": ["bridges", "blocks"]
+  })"_json;
+
+  REQUIRE(request.fields == expected);
+  REQUIRE(request.vertices.empty());
+
+  // Поле "data" может быть и не массивом.
+  REQUIRE_EQUAL(ReadGraphRequest(R"({"data": "none"})", &request), 0);
+  REQUIRE(request.fields.at("data") == "none");
+}
+
+/**
+ * @brief Некорректные запросы.
+ */
+static void InvalidTest() {
+  const std::vector<std::string> invalid = {
+    "",
+    "[1, 2]",
+    "{\"id\": 1",
+    "{\"vertices\": [-1]}",
+    "{\"vertices\": [1.5]}",
+    "{\"vertices\": [[1]]}",
+    "{\"vertices\": [\"1\"]}",
+    "{\"edges\": [1, 2]}",
+    "{\"edges\": [[1]]}",
+    "{\"edges\": [[1, 2, 3, 4]]}",
+    "{\"edges\": [[1, 2], [1, 2, 3]]}",
+    "{\"edges\": [[1, -2]]}",
+    "{\"data\": [1, 2]}",
+    "{\"data\": [1, 2, 3.5]}",
+  };
+
+  for (const std::string& body : invalid) {
+    GraphRequest request;
+    REQUIRE_EQUAL(ReadGraphRequest(body, &request), -1);
+  }
+}
+
+/**
+ * @brief Результат совпадает с разбором через дерево JSON.
+ */
+static void DomTest() {
+  nlohmann::json input;
+  input["id"] = 42;
+  input["type"] = "weighted_oriented_graph";
+  input["size"] = 100;
+  input["numEdges"] = 300;
+
+  for (size_t i = 0; i < 100; i++)
+    input["vertices"][i] = i * 7;
+  for (size_t i = 0; i < 300; i++) {
+    input["edges"][i][0] = (i * 13) % 100 * 7;
+    input["edges"][i][1] = (i * 29 + 1) % 100 * 7;
+    input["edges"][i][2] = static_cast<int>(i % 17) - 8;
+  }
+
+  GraphRequest request;
+  REQUIRE_EQUAL(ReadGraphRequest(input.dump(), &request), 0);
+
+  REQUIRE_EQUAL(request.fields.size(), size_t{4});
+  REQUIRE_EQUAL(request.vertices.size(), size_t{100});
+  REQUIRE_EQUAL(request.NumEdges(), size_t{300});
+
+  for (size_t i = 0; i < 100; i++)
+    REQUIRE_EQUAL(request.vertices[i], input["vertices"][i].get<size_t>());
+  for (size_t i = 0; i < 300; i++) {
+    REQUIRE_EQUAL(request.edges[2 * i], input["edges"][i][0].get<size_t>());
+    REQUIRE_EQUAL(request.edges[2 * i + 1],
+                  input["edges"][i][1].get<size_t>());
+    REQUIRE_EQUAL(request.weights[i], input["edges"][i][2].get<double>());
+  }
+}
@@ -0,0 +1,812 @@
+/**
+ * @file tests/graph_store_test.cpp
+ *
+ * Тесты для хранилища графов, загруженных на сервер.
+ */
+
+#include <httplib.h>
+#include <algorithm>
+#include <memory>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include <graph.hpp>
+#include <oriented_graph.hpp>
+#include <weighted_graph.hpp>
+#include <weighted_oriented_graph.hpp>
+#include "test_core.hpp"
+#include "test.hpp"
+#include "../methods/binary_format.hpp"
+#include "../methods/graph_store.hpp"
+
+using graph::CsrGraph;
+using graph::EncodeBinaryGraph;
+using graph::FillGraph;
+using graph::GetCsrGraph;
+using graph::GetGraph;
+using graph::GraphAllocator;
+using graph::Graph;
+using graph::GraphPatch;
+using graph::GraphRequest;
+using graph::GraphStore;
+using graph::kBinaryGraphContentType;
+using graph::kDependsOnTopology;
+using graph::kDependsOnWeights;
+using graph::OrientedGraph;
+using graph::ReadGraphPatch;
+using graph::ReadGraphRequest;
+using graph::ResolveGraphRequest;
+using graph::ResultCache;
+using graph::RunGraphMethod;
+using graph::RunInArena;
+using graph::StoredGraph;
+using graph::WeightedGraph;
+using graph::WeightedOrientedGraph;
+
+static void StoredGraphTest();
+static void EvictionTest();
+static void ResolveTest();
+static void ReadPatchTest();
+static void PatchTest();
+static void PatchResultsTest();
+static void RandomPatchTest();
+static void ArenaTest();
+static void CsrThreadsTest();
+static void StoredResultsTest();
+static void EndpointsTest(httplib::Client* cli);
+static void HandleTest(httplib::Client* cli);
+static void PatchEndpointTest(httplib::Client* cli);
+
+void TestGraphStore(httplib::Client* cli) {
+  TestSuite suite("TestGraphStore");
+
+  RUN_TEST(suite, StoredGraphTest);
+  RUN_TEST(suite, EvictionTest);
+  RUN_TEST(suite, ResolveTest);
+  RUN_TEST(suite, ReadPatchTest);
+  RUN_TEST(suite, PatchTest);
+  RUN_TEST(suite, PatchResultsTest);
+  RUN_TEST(suite, RandomPatchTest);
+  RUN_TEST(suite, ArenaTest);
+  RUN_TEST(suite, CsrThreadsTest);
+  RUN_TEST(suite, StoredResultsTest);
+  RUN_TEST_REMOTE(suite, cli, EndpointsTest);
+  RUN_TEST_REMOTE(suite, cli, HandleTest);
+  RUN_TEST_REMOTE(suite, cli, PatchEndpointTest);
+}
+
+//! Небольшой граф для тестов хранилища.
+static const char kSmallGraph[] = R"({
+  "id": 1, "type": "graph", "size": 4, "numEdges": 3,
+  "vertices": [1, 2, 3, 4], "edges": [[1, 2], [2, 3], [3, 4]]
+})";
+
+/**
+ * @brief Граф каждого типа строится один раз.
+ */
+static void StoredGraphTest() {
+  StoredGraph stored;
+  REQUIRE_EQUAL(stored.Load("{\"id\": 1", false), -1);
+  REQUIRE_EQUAL(stored.Load(kSmallGraph, false), 0);
+  REQUIRE_EQUAL(stored.Request().NumEdges(), size_t{3});
+
+  const size_t loaded = stored.MemoryUsage();
+  const Graph* first = nullptr;
+  const Graph* second = nullptr;
+  REQUIRE_EQUAL(stored.Get(4, 3, &first), 0);
+  REQUIRE(stored.MemoryUsage() > loaded);
+  REQUIRE_EQUAL(stored.Get(4, 3, &second), 0);
+  REQUIRE(first == second);
+  REQUIRE(first->HasEdge(3, 2));
+  REQUIRE(!first->HasEdge(1, 3));
+
+  // Граф другого типа строится отдельно.
+  const OrientedGraph* oriented = nullptr;
+  REQUIRE_EQUAL(stored.Get(4, 3, &oriented), 0);
+  REQUIRE(oriented->HasEdge(2, 3));
+  REQUIRE(!oriented->HasEdge(3, 2));
+
+  // Рёбер меньше, чем нужно.
+  REQUIRE_EQUAL(stored.Get(4, 4, &first), -1);
+
+  // Загруженный граф не может ссылаться на другой загруженный граф.
+  StoredGraph nested;
+  REQUIRE_EQUAL(nested.Load("{\"graph\": \"g1\"}", false), -1);
+}
+
+/**
+ * @brief Создать загруженный граф.
+ */
+static std::shared_ptr<StoredGraph> MakeStoredGraph() {
+  auto stored = std::make_shared<StoredGraph>();
+  REQUIRE_EQUAL(stored->Load(kSmallGraph, false), 0);
+  return stored;
+}
+
+/**
+ * @brief Удаляются графы, которые дольше всех не использовались.
+ */
+static void EvictionTest() {
+  const size_t size = MakeStoredGraph()->MemoryUsage();
+  GraphStore store(2 * size + size / 2);
+  std::string first, second, third;
+
+  REQUIRE_EQUAL(store.Add(MakeStoredGraph(), &first), 0);
+  REQUIRE_EQUAL(store.Add(MakeStoredGraph(), &second), 0);
+  REQUIRE(first != second);
+  REQUIRE_EQUAL(store.Size(), size_t{2});
+  REQUIRE_EQUAL(store.MemoryUsage(), 2 * size);
+
+  // Первый граф использовался позже второго, поэтому удаляется второй.
+  REQUIRE(store.Find(first) != nullptr);
+  REQUIRE_EQUAL(store.Add(MakeStoredGraph(), &third), 0);
+  REQUIRE_EQUAL(store.Size(), size_t{2});
+  REQUIRE(store.Find(first) != nullptr);
+  REQUIRE(store.Find(second) == nullptr);
+  REQUIRE(store.Find(third) != nullptr);
+
+  // Построенный граф тоже занимает память.
+  std::shared_ptr<StoredGraph> grown = store.Find(first);
+  const Graph* graph = nullptr;
+  REQUIRE_EQUAL(grown->Get(4, 3, &graph), 0);
+  REQUIRE(store.Find(first) != nullptr);
+  REQUIRE(store.Find(third) == nullptr);
+  REQUIRE_EQUAL(store.Size(), size_t{1});
+
+  // Граф больше всей памяти не добавляется.
+  GraphStore tiny(size - 1);
+  REQUIRE_EQUAL(tiny.Add(MakeStoredGraph(), &third), -1);
+  REQUIRE_EQUAL(tiny.Size(), size_t{0});
+
+  REQUIRE(store.Remove(first));
+  REQUIRE(!store.Remove(first));
+  REQUIRE_EQUAL(store.MemoryUsage(), size_t{0});
+}
+
+/**
+ * @brief Подстановка загруженного графа в запрос.
+ */
+static void ResolveTest() {
+  GraphStore store(1 << 20);
+  std::string handle;
+  REQUIRE_EQUAL(store.Add(MakeStoredGraph(), &handle), 0);
+
+  GraphRequest request;
+  REQUIRE_EQUAL(ReadGraphRequest(
+      R"({"graph": ")" + handle + R"(", "id": 7, "outputs": []})",
+      &request), 0);
+  REQUIRE_EQUAL(ResolveGraphRequest(&store, &request), 0);
+  REQUIRE(request.stored != nullptr);
+  REQUIRE(!request.fields.contains("graph"));
+  REQUIRE_EQUAL(request.fields.at("id"), 7);
+  REQUIRE_EQUAL(request.fields.at("size"), 4);
+  REQUIRE(request.fields.at("outputs") == nlohmann::json::array());
+
+  Graph local;
+  const Graph* graph = nullptr;
+  REQUIRE_EQUAL(GetGraph(request, 4, 3, &local, &graph), 0);
+  REQUIRE(graph != &local);
+  REQUIRE_EQUAL(local.NumVertices(), size_t{0});
+  REQUIRE(graph->HasEdge(1, 2));
+
+  // Запрос без поля "graph" не меняется.
+  GraphRequest inline_request;
+  REQUIRE_EQUAL(ReadGraphRequest(kSmallGraph, &inline_request), 0);
+  REQUIRE_EQUAL(ResolveGraphRequest(&store, &inline_request), 0);
+  REQUIRE(inline_request.stored == nullptr);
+  REQUIRE_EQUAL(GetGraph(inline_request, 4, 3, &local, &graph), 0);
+  REQUIRE(graph == &local);
+
+  const std::vector<std::string> invalid = {
+    R"({"graph": "g0"})",
+    R"({"graph": 1})",
+    R"({"graph": ")" + handle + R"(", "edges": [[1, 2]]})",
+  };
+
+  for (const std::string& body : invalid) {
+    GraphRequest other;
+    REQUIRE_EQUAL(ReadGraphRequest(body, &other), 0);
+    REQUIRE_EQUAL(ResolveGraphRequest(&store, &other), -1);
+  }
+}
+
+/**
+ * @brief Загрузить граф на сервер.
+ *
+ * @param cli Указатель на HTTP клиент.
+ * @param input Граф в формате запроса к методу.
+ */
+static std::string Upload(httplib::Client* cli, const nlohmann::json& input) {
+  httplib::Result res = cli->Post("/graphs", input.dump(),
+                                  "application/json");
+  REQUIRE_EQUAL(res->status, 200);
+
+  nlohmann::json output = nlohmann::json::parse(res->body);
+  const size_t numEdges = input.contains("edges") ?
+      input.at("edges").size() : input.at("data").size() / 3;
+  REQUIRE_EQUAL(output.at("numEdges").get<size_t>(), numEdges);
+  return output.at("graph");
+}
+
+/**
+ * @brief Сравнить ответы метода на граф в запросе и на загруженный граф.
+ *
+ * @param cli Указатель на HTTP клиент.
+ * @param path Адрес метода.
+ * @param input Запрос с графом.
+ * @param handle Идентификатор загруженного графа.
+ * @param fields Поля запроса, кроме графа.
+ */
+static void CompareWithStored(httplib::Client* cli, const char* path,
+                              nlohmann::json input, const std::string& handle,
+                              const nlohmann::json& fields) {
+  nlohmann::json request = fields;
+  request["graph"] = handle;
+  for (const auto& field : fields.items())
+    input[field.key()] = field.value();
+
+  httplib::Result expected = cli->Post(path, input.dump(),
+                                       "application/json");
+  httplib::Result result = cli->Post(path, request.dump(),
+                                     "application/json");
+
+  REQUIRE_EQUAL(expected->status, 200);
+  REQUIRE_EQUAL(result->status, 200);
+  REQUIRE(nlohmann::json::parse(result->body) ==
+          nlohmann::json::parse(expected->body));
+}
+
+/**
+ * @brief Все методы работают с загруженными графами.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void EndpointsTest(httplib::Client* cli) {
+  std::mt19937 gen(17);
+  const size_t n = 50, m = 150;
+  nlohmann::json vertices = nlohmann::json::array();
+  nlohmann::json edges = nlohmann::json::array();
+  nlohmann::json acyclic = nlohmann::json::array();
+  nlohmann::json weighted = nlohmann::json::array();
+  nlohmann::json triples = nlohmann::json::array();
+
+  for (size_t i = 0; i < n; i++)
+    vertices.push_back(i);
+
+  for (size_t i = 0; i < m; i++) {
+    const size_t a = gen() % n, b = (a + 1 + gen() % (n - 1)) % n;
+    const int w = static_cast<int>(gen() % 20) - 2;
+
+    edges.push_back({a, b});
+    acyclic.push_back({std::min(a, b), std::max(a, b)});
+    weighted.push_back({a, b, w + 2});
+    triples.push_back(w);
+    triples.push_back(a);
+    triples.push_back(b);
+  }
+
+  const nlohmann::json graph = {{"type", "graph"}, {"size", n},
+                                {"numEdges", m}, {"vertices", vertices},
+                                {"edges", edges}};
+  const std::string undirected = Upload(cli, graph);
+
+  // Один загруженный граф используется несколькими методами.
+  CompareWithStored(cli, "/FindBridges", graph, undirected, {{"id", 1}});
+  CompareWithStored(cli, "/CutPoints", graph, undirected, {{"id", 2}});
+  CompareWithStored(cli, "/Biconnected", graph, undirected,
+                    {{"id", 3}, {"outputs", {"blocks", "bridges"}}});
+  CompareWithStored(cli, "/CutPoints", graph, undirected, {{"id", 4}});
+
+  nlohmann::json oriented = graph;
+  oriented["type"] = "oriented_graph";
+  oriented["edges"] = acyclic;
+  CompareWithStored(cli, "/TopologicalSorting", oriented,
+                    Upload(cli, oriented), {{"id", 5}, {"algorithm", "kahn"}});
+
+  nlohmann::json network = graph;
+  network["type"] = "weighted_oriented_graph";
+  network["edges"] = weighted;
+  network["TypeWeights"] = "int";
+  const std::string flow = Upload(cli, network);
+  CompareWithStored(cli, "/Dinic", network, flow,
+                    {{"id", 6}, {"start", 0}, {"theEnd", n - 1}});
+  CompareWithStored(cli, "/Dinic", network, flow,
+                    {{"id", 7}, {"start", 1}, {"theEnd", 2}});
+  CompareWithStored(cli, "/NegCycle", network, flow, {{"id", 8}});
+
+  const nlohmann::json data = {{"type", "int"}, {"data", triples}};
+  const std::string paths = Upload(cli, data);
+  CompareWithStored(cli, "/Maximal", data, paths,
+                    {{"id", 9}, {"size", {m, n}}});
+  CompareWithStored(cli, "/Belmanf", data, paths,
+                    {{"id", 10}, {"size", {m, n, 0}}});
+  CompareWithStored(cli, "/Belmanf", data, paths,
+                    {{"id", 11}, {"type", "double"}, {"size", {m, n, 3}}});
+}
+
+/**
+ * @brief Загрузка в бинарном формате, удаление и неизвестные графы.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void HandleTest(httplib::Client* cli) {
+  nlohmann::json input = nlohmann::json::parse(kSmallGraph);
+  std::string body;
+  REQUIRE_EQUAL(EncodeBinaryGraph(input, &body), 0);
+
+  httplib::Result res = cli->Post("/graphs", body, kBinaryGraphContentType);
+  REQUIRE_EQUAL(res->status, 200);
+  const std::string handle = nlohmann::json::parse(res->body).at("graph");
+
+  res = cli->Post("/CutPoints", R"({"graph": ")" + handle + R"("})",
+                  "application/json");
+  REQUIRE_EQUAL(res->status, 200);
+  nlohmann::json output = nlohmann::json::parse(res->body);
+  REQUIRE_EQUAL(output.at("id"), 1);
+  std::vector<size_t> cutPoints = output.at("data");
+  std::sort(cutPoints.begin(), cutPoints.end());
+  REQUIRE(cutPoints == std::vector<size_t>({2, 3}));
+
+  res = cli->Get("/graphs");
+  REQUIRE_EQUAL(res->status, 200);
+  output = nlohmann::json::parse(res->body);
+  REQUIRE(output.at("graphs") >= 1);
+  REQUIRE(output.at("memory") <= output.at("memoryBudget"));
+
+  // После удаления граф больше нельзя использовать.
+  const std::string path = "/graphs/" + handle;
+  REQUIRE_EQUAL(cli->Delete(path.c_str())->status, 200);
+  REQUIRE_EQUAL(cli->Delete(path.c_str())->status, 404);
+  res = cli->Post("/CutPoints", R"({"graph": ")" + handle + R"("})",
+                  "application/json");
+  REQUIRE_EQUAL(res->status, 400);
+
+  // Некорректный граф не загружается.
+  res = cli->Post("/graphs", "{\"vertices\": [-1]}", "application/json");
+  REQUIRE_EQUAL(res->status, 400);
+}
+
+/**
+ * @brief Разбор изменения графа.
+ */
+static void ReadPatchTest() {
+  GraphPatch patch;
+  REQUIRE_EQUAL(ReadGraphPatch(R"({
+    "removeVertices": [1], "removeEdges": [[2, 3]],
+    "addVertices": [7, 8], "addEdges": [[7, 8, 2.5], [8, 7, -1]]
+  })", &patch), 0);
+
+  REQUIRE(patch.removeVertices == std::vector<size_t>({1}));
+  REQUIRE(patch.removeEdges == std::vector<size_t>({2, 3}));
+  REQUIRE(patch.addVertices == std::vector<size_t>({7, 8}));
+  REQUIRE(patch.addEdges == std::vector<size_t>({7, 8, 8, 7}));
+  REQUIRE(patch.addWeights == std::vector<double>({2.5, -1}));
+
+  const std::vector<std::string> invalid = {
+    "[]",
+    "{\"addVertices\": 1}",
+    "{\"addVertices\": [-1]}",
+    "{\"addEdges\": [[1]]}",
+    "{\"addEdges\": [[1, 2], [1, 2, 3]]}",
+    "{\"removeEdges\": [[1, 2, 3]]}",
+    "{\"addedges\": [[1, 2]]}",
+  };
+
+  for (const std::string& body : invalid)
+    REQUIRE_EQUAL(ReadGraphPatch(body, &patch), -1);
+}
+
+/**
+ * @brief Построенный граф меняется на месте.
+ */
+static void PatchTest() {
+  StoredGraph stored;
+  REQUIRE_EQUAL(stored.Load(kSmallGraph, false), 0);
+
+  const Graph* graph = nullptr;
+  const Graph* patched = nullptr;
+  REQUIRE_EQUAL(stored.Get(4, 3, &graph), 0);
+
+  GraphPatch patch;
+  REQUIRE_EQUAL(ReadGraphPatch(R"({"addEdges": [[1, 3]]})", &patch), 0);
+  REQUIRE_EQUAL(stored.Patch(patch), 0);
+  REQUIRE_EQUAL(stored.Version(), size_t{1});
+  REQUIRE_EQUAL(stored.Request().fields.at("numEdges"), 4);
+  REQUIRE_EQUAL(stored.Get(4, 4, &patched), 0);
+  REQUIRE(patched == graph);
+  REQUIRE(graph->HasEdge(3, 1));
+
+  // Вершина удаляется вместе с рёбрами, ребро - в обоих направлениях.
+  REQUIRE_EQUAL(ReadGraphPatch(R"({
+    "removeVertices": [2], "removeEdges": [[4, 3]], "addVertices": [5]
+  })", &patch), 0);
+  REQUIRE_EQUAL(stored.Patch(patch), 0);
+  REQUIRE_EQUAL(stored.Version(), size_t{2});
+  REQUIRE_EQUAL(stored.Request().fields.at("size"), 4);
+  REQUIRE_EQUAL(stored.Request().fields.at("numEdges"), 1);
+  REQUIRE_EQUAL(stored.Get(4, 1, &patched), 0);
+  REQUIRE(patched == graph);
+  REQUIRE(!graph->HasVertex(2));
+  REQUIRE(graph->HasVertex(5));
+  REQUIRE(!graph->HasEdge(3, 4));
+  REQUIRE(graph->HasEdge(1, 3));
+
+  // Некорректные изменения не меняют граф.
+  const std::vector<std::string> invalid = {
+    R"({"removeVertices": [2]})",
+    R"({"removeEdges": [[1, 4]]})",
+    R"({"addEdges": [[1, 4, 5]]})",
+  };
+
+  for (const std::string& body : invalid) {
+    REQUIRE_EQUAL(ReadGraphPatch(body, &patch), 0);
+    REQUIRE_EQUAL(stored.Patch(patch), -1);
+  }
+
+  // Изменение, которое ничего не меняет, не создаёт новую версию.
+  REQUIRE_EQUAL(ReadGraphPatch(R"({
+    "addVertices": [1], "addEdges": [[3, 1]]
+  })", &patch), 0);
+  REQUIRE_EQUAL(stored.Patch(patch), 0);
+  REQUIRE_EQUAL(stored.Version(), size_t{2});
+
+  // Из графа, построенного только по рёбрам, удаляется вершина, у которой
+  // не осталось рёбер, даже если она есть в "vertices".
+  StoredGraph chain;
+  const Graph* edgesOnly = nullptr;
+  REQUIRE_EQUAL(chain.Load(kSmallGraph, false), 0);
+  REQUIRE_EQUAL(chain.Get(0, 3, &edgesOnly), 0);
+  REQUIRE_EQUAL(ReadGraphPatch(R"({"removeEdges": [[3, 4]]})", &patch), 0);
+  REQUIRE_EQUAL(chain.Patch(patch), 0);
+  REQUIRE_EQUAL(chain.Get(0, 2, &patched), 0);
+  REQUIRE(patched == edgesOnly);
+  REQUIRE_EQUAL(edgesOnly->NumVertices(), size_t{3});
+  REQUIRE(!edgesOnly->HasVertex(4));
+}
+
+/**
+ * @brief После изменения остаются результаты, которые не могли измениться.
+ */
+static void PatchResultsTest() {
+  StoredGraph stored;
+  REQUIRE_EQUAL(stored.Load(R"({
+    "type": "weighted_oriented_graph", "size": 3, "numEdges": 2,
+    "vertices": [1, 2, 3], "edges": [[1, 2, 5], [2, 3, 7]]
+  })", false), 0);
+
+  nlohmann::json output;
+  stored.SaveResult("topology", kDependsOnTopology, {{"data", 1}});
+  stored.SaveResult("weights", kDependsOnWeights, {{"data", 2}});
+  REQUIRE(stored.FindResult("topology", &output));
+  REQUIRE_EQUAL(output.at("data"), 1);
+
+  // Меняется только вес.
+  GraphPatch patch;
+  REQUIRE_EQUAL(ReadGraphPatch(R"({"addEdges": [[1, 2, 6]]})", &patch), 0);
+  REQUIRE_EQUAL(stored.Patch(patch), 0);
+  REQUIRE_EQUAL(stored.Version(), size_t{1});
+  REQUIRE_EQUAL(stored.Request().NumEdges(), size_t{2});
+  REQUIRE(stored.FindResult("topology", &output));
+  REQUIRE(!stored.FindResult("weights", &output));
+
+  // Меняется набор рёбер.
+  stored.SaveResult("weights", kDependsOnWeights, {{"data", 2}});
+  REQUIRE_EQUAL(ReadGraphPatch(R"({"addEdges": [[3, 1, 1]]})", &patch), 0);
+  REQUIRE_EQUAL(stored.Patch(patch), 0);
+  REQUIRE(!stored.FindResult("topology", &output));
+  REQUIRE(!stored.FindResult("weights", &output));
+
+  // Невзвешенные рёбра нельзя добавить во взвешенный граф.
+  REQUIRE_EQUAL(ReadGraphPatch(R"({"addEdges": [[3, 2]]})", &patch), 0);
+  REQUIRE_EQUAL(stored.Patch(patch), -1);
+}
+
+/**
+ * @brief Проверить, что два графа совпадают.
+ *
+ * @tparam T Тип графа.
+ *
+ * @param a Первый граф.
+ * @param b Второй граф.
+ */
+template<class T>
+static void RequireSameGraph(const T& a, const T& b) {
+  REQUIRE_EQUAL(a.NumVertices(), b.NumVertices());
+
+  for (size_t v : a.Vertices()) {
+    REQUIRE(b.HasVertex(v));
+    REQUIRE_EQUAL(a.Edges(v).size(), b.Edges(v).size());
+
+    for (size_t u : a.Edges(v)) {
+      REQUIRE(b.HasEdge(v, u));
+      if constexpr (graph::IsWeightedGraph<T>::value)
+        REQUIRE_EQUAL(a.EdgeWeight(v, u), b.EdgeWeight(v, u));
+    }
+  }
+}
+
+/**
+ * @brief Изменённый граф совпадает с графом, построенным заново.
+ *
+ * @tparam T Тип графа.
+ *
+ * @param stored Загруженный граф.
+ * @param graph Граф, построенный до изменения.
+ * @param allVertices Построен ли граф по всем вершинам, а не только
+ *        по рёбрам.
+ */
+template<class T>
+static void RequireRebuilt(StoredGraph* stored, const T* graph,
+                           bool allVertices) {
+  const GraphRequest& request = stored->Request();
+  const size_t numVertices = allVertices ? request.NumVertices() : 0;
+  const size_t numEdges = request.NumEdges();
+  const T* patched = nullptr;
+  T rebuilt;
+
+  REQUIRE_EQUAL(stored->Get(numVertices, numEdges, &patched), 0);
+  REQUIRE(patched == graph);
+  REQUIRE_EQUAL(FillGraph(request, numVertices, numEdges, &rebuilt), 0);
+  RequireSameGraph(*patched, rebuilt);
+}
+
+/**
+ * @brief Случайные изменения графов всех типов.
+ */
+static void RandomPatchTest() {
+  std::mt19937 gen(18);
+  const size_t n = 30;
+
+  for (const char* type : {"graph", "weighted_oriented_graph"}) {
+    const bool weighted = std::string(type) != "graph";
+    nlohmann::json input = {{"type", type}, {"size", n}};
+
+    for (size_t i = 0; i < n; i++)
+      input["vertices"].push_back(i);
+    for (size_t i = 0; i < 3 * n; i++) {
+      nlohmann::json edge = {gen() % n, gen() % n};
+      if (weighted)
+        edge.push_back(static_cast<int>(gen() % 10));
+      input["edges"].push_back(edge);
+    }
+    input["numEdges"] = input["edges"].size();
+
+    StoredGraph stored;
+    REQUIRE_EQUAL(stored.Load(input.dump(), false), 0);
+
+    const Graph* graph = nullptr;
+    const OrientedGraph* oriented = nullptr;
+    const WeightedGraph<int>* undirected = nullptr;
+    const WeightedOrientedGraph<int>* network = nullptr;
+    const size_t m = stored.Request().NumEdges();
+    REQUIRE_EQUAL(stored.Get(n, m, &graph), 0);
+    REQUIRE_EQUAL(stored.Get(n, m, &oriented), 0);
+    if (weighted) {
+      REQUIRE_EQUAL(stored.Get(n, m, &undirected), 0);
+      REQUIRE_EQUAL(stored.Get(n, m, &network), 0);
+    }
+
+    // Графы, построенные только по рёбрам.
+    const Graph* graphEdges = nullptr;
+    const OrientedGraph* orientedEdges = nullptr;
+    const WeightedGraph<int>* undirectedEdges = nullptr;
+    const WeightedOrientedGraph<int>* networkEdges = nullptr;
+    REQUIRE_EQUAL(stored.Get(0, m, &graphEdges), 0);
+    REQUIRE_EQUAL(stored.Get(0, m, &orientedEdges), 0);
+    if (weighted) {
+      REQUIRE_EQUAL(stored.Get(0, m, &undirectedEdges), 0);
+      REQUIRE_EQUAL(stored.Get(0, m, &networkEdges), 0);
+    }
+
+    for (size_t step = 0; step < 50; step++) {
+      const GraphRequest& request = stored.Request();
+      nlohmann::json patch = nlohmann::json::object();
+
+      // Удаляем существующие рёбра (иногда в обратном направлении)
+      // и вершины, добавляем новые рёбра и вершины.
+      for (size_t k = 0; k < 2 && request.NumEdges() > 0; k++) {
+        const size_t i = gen() % request.NumEdges();
+        size_t a = request.EdgeSource(i), b = request.EdgeTarget(i);
+        if (!weighted && gen() % 2)
+          std::swap(a, b);
+        patch["removeEdges"].push_back({a, b});
+      }
+      if (gen() % 4 == 0 && request.NumVertices() > 0)
+        patch["removeVertices"].push_back(
+            request.Vertex(gen() % request.NumVertices()));
+      if (gen() % 4 == 0)
+        patch["addVertices"].push_back(gen() % (2 * n));
+      for (size_t k = 0; k < 3; k++) {
+        nlohmann::json edge = {gen() % n, gen() % n};
+        if (weighted)
+          edge.push_back(static_cast<int>(gen() % 10));
+        patch["addEdges"].push_back(edge);
+      }
+
+      GraphPatch parsed;
+      REQUIRE_EQUAL(ReadGraphPatch(patch.dump(), &parsed), 0);
+      REQUIRE_EQUAL(stored.Patch(parsed), 0);
+
+      RequireRebuilt(&stored, graph, true);
+      RequireRebuilt(&stored, oriented, true);
+      RequireRebuilt(&stored, graphEdges, false);
+      RequireRebuilt(&stored, orientedEdges, false);
+      if (weighted) {
+        RequireRebuilt(&stored, undirected, true);
+        RequireRebuilt(&stored, network, true);
+        RequireRebuilt(&stored, undirectedEdges, false);
+        RequireRebuilt(&stored, networkEdges, false);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Метод для тестов: строит граф запроса в арене.
+ *
+ * @param input Входные данные.
+ * @param output Выходные данные.
+ */
+static int BuildInArena(const GraphRequest& input, nlohmann::json* output) {
+  if (input.fields.contains("throw"))
+    throw std::runtime_error("test");
+
+  Graph local(GraphAllocator<Graph>(input));
+  const Graph* graph;
+  if (GetGraph(input, input.NumVertices(), input.NumEdges(), &local,
+               &graph) < 0)
+    return -1;
+
+  (*output)["inArena"] = input.memory != nullptr &&
+                         graph->get_allocator().resource() == input.memory;
+  (*output)["size"] = graph->NumVertices();
+  return 0;
+}
+
+/**
+ * @brief Метод выполняется в арене, которая существует только во время
+ *        его выполнения.
+ */
+static void ArenaTest() {
+  GraphRequest input;
+  nlohmann::json output;
+  REQUIRE_EQUAL(ReadGraphRequest(R"({"id": 1, "vertices": [1, 2, 3],
+                                     "edges": [[1, 2], [2, 3]]})",
+                                 &input), 0);
+
+  REQUIRE_EQUAL(RunInArena(BuildInArena, &input, &output), 0);
+  REQUIRE(input.memory == nullptr);
+  REQUIRE(output["inArena"].get<bool>());
+  REQUIRE_EQUAL(output["size"], 3);
+
+  // Вне метода графы берут память по умолчанию.
+  REQUIRE(GraphAllocator<Graph>(input).resource() ==
+          std::pmr::get_default_resource());
+
+  // Графы, которые не умеют работать с ареной, строятся как обычно.
+  std::pmr::monotonic_buffer_resource arena;
+  input.memory = &arena;
+  REQUIRE(GraphAllocator<Graph>(input).resource() == &arena);
+  graph::BasicGraph<graph::StdHashContainers> local(
+      GraphAllocator<graph::BasicGraph<graph::StdHashContainers>>(input));
+  REQUIRE_EQUAL(FillGraph(input, 3, 2, &local), 0);
+  REQUIRE(local.HasEdge(2, 1));
+  input.memory = nullptr;
+
+  input.fields["throw"] = true;
+  REQUIRE_THROW(RunInArena(BuildInArena, &input, &output),
+                std::runtime_error);
+  REQUIRE(input.memory == nullptr);
+}
+
+/**
+ * @brief CSR граф запроса строится заданным количеством потоков.
+ */
+static void CsrThreadsTest() {
+  GraphRequest input;
+  CsrGraph<int> csr;
+  REQUIRE_EQUAL(ReadGraphRequest(R"({"threads": 1, "vertices": [1, 2, 3],
+                                     "edges": [[1, 2, 5], [2, 3, 7]]})",
+                                 &input), 0);
+
+  REQUIRE_EQUAL(GetCsrGraph<WeightedOrientedGraph<int>>(input, 3, 2, &csr),
+                0);
+  REQUIRE_EQUAL(csr.NumVertices(), size_t{3});
+  REQUIRE_EQUAL(csr.EdgeWeight(2, 3), 7);
+
+  // Некорректное количество потоков.
+  for (const nlohmann::json& threads : {nlohmann::json(-1),
+                                        nlohmann::json("4")}) {
+    input.fields["threads"] = threads;
+    REQUIRE_EQUAL(GetCsrGraph<WeightedOrientedGraph<int>>(input, 3, 2, &csr),
+                  -1);
+  }
+}
+
+//! Сколько раз был вызван метод CountCalls().
+static size_t numCalls = 0;
+
+/**
+ * @brief Метод для тестов: считает свои вызовы.
+ *
+ * @param input Входные данные.
+ * @param output Выходные данные.
+ */
+static int CountCalls(const GraphRequest& input, nlohmann::json* output) {
+  numCalls++;
+  (*output)["id"] = input.fields.at("id");
+  (*output)["size"] = input.stored->Request().NumVertices();
+  return 0;
+}
+
+/**
+ * @brief Результат метода для загруженного графа не зависит от "id"
+ *        запроса.
+ */
+static void StoredResultsTest() {
+  ResultCache cache(0);
+  GraphRequest input;
+  input.stored = MakeStoredGraph();
+  nlohmann::json output;
+  numCalls = 0;
+
+  for (int id : {10, 11, 12}) {
+    input.fields = {{"id", id}, {"graph", "handle"}};
+    output = nlohmann::json::object();
+
+    REQUIRE_EQUAL(RunGraphMethod(CountCalls, "/Count", kDependsOnTopology,
+                                 &input, &cache, &output), 0);
+    REQUIRE_EQUAL(output.at("id"), id);
+    REQUIRE_EQUAL(output.at("size"), 4);
+  }
+  REQUIRE_EQUAL(numCalls, size_t{1});
+
+  // Другие параметры запроса дают другой ключ.
+  input.fields["source"] = 1;
+  REQUIRE_EQUAL(RunGraphMethod(CountCalls, "/Count", kDependsOnTopology,
+                               &input, &cache, &output), 0);
+  REQUIRE_EQUAL(numCalls, size_t{2});
+}
+
+/**
+ * @brief Изменение графа на сервере.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void PatchEndpointTest(httplib::Client* cli) {
+  nlohmann::json input = nlohmann::json::parse(kSmallGraph);
+  const std::string handle = Upload(cli, input);
+  const std::string path = "/graphs/" + handle;
+  const std::string request = R"({"graph": ")" + handle + R"("})";
+
+  httplib::Result res = cli->Post("/FindBridges", request,
+                                  "application/json");
+  REQUIRE_EQUAL(res->status, 200);
+  REQUIRE_EQUAL(nlohmann::json::parse(res->body).at("data").size(),
+                size_t{3});
+
+  // Ребро 1-4 замыкает цикл: мостов больше нет.
+  res = cli->Patch(path.c_str(), R"({"addEdges": [[4, 1]]})",
+                   "application/json");
+  REQUIRE_EQUAL(res->status, 200);
+  nlohmann::json output = nlohmann::json::parse(res->body);
+  REQUIRE_EQUAL(output.at("version"), 1);
+  REQUIRE_EQUAL(output.at("numEdges"), 4);
+
+  input["edges"].push_back({4, 1});
+  input["numEdges"] = 4;
+  CompareWithStored(cli, "/FindBridges", input, handle, {{"id", 1}});
+  CompareWithStored(cli, "/Biconnected", input, handle, {{"id", 1}});
+  res = cli->Post("/FindBridges", request, "application/json");
+  REQUIRE(!nlohmann::json::parse(res->body).contains("data"));
+
+  res = cli->Patch(path.c_str(), R"({"removeVertices": [9]})",
+                   "application/json");
+  REQUIRE_EQUAL(res->status, 400);
+  res = cli->Patch("/graphs/g0", "{}", "application/json");
+  REQUIRE_EQUAL(res->status, 404);
+  REQUIRE_EQUAL(cli->Delete(path.c_str())->status, 200);
+}
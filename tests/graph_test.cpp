@@ -47,6 +47,7 @@ static void EdgesRemovalTest();
 static void GraphIteratorTest();
 static void RandomAdditionTest();
 static void RandomTest();
+static void BulkAdditionTest();
 
 /**
  * @brief Основная функция для тестирования класса graph::Graph.
@@ -61,6 +62,7 @@ void TestGraph() {
   RUN_TEST(suite, GraphIteratorTest);
   RUN_TEST(suite, RandomAdditionTest);
   RUN_TEST(suite, RandomTest);
+  RUN_TEST(suite, BulkAdditionTest);
 }
 
 /**
@@ -682,3 +684,75 @@ static void RandomTest() {
     REQUIRE(vertices == iteratedVertices);
   }
 }
+
+/**
+ * @brief Сравнить графы: совпадают ли вершины и множества соседей.
+ */
+template<typename First, typename Second>
+static bool SameGraphs(const First& first, const Second& second) {
+  if (first.NumVertices() != second.NumVertices())
+    return false;
+
+  for (size_t id : first.Vertices()) {
+    if (!second.HasVertex(id) ||
+        first.Edges(id).size() != second.Edges(id).size())
+      return false;
+
+    for (size_t neighbour : first.Edges(id))
+      if (!second.HasEdge(id, neighbour))
+        return false;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Тест массового добавления рёбер функцией AddEdges() и конструктором
+ * по промежутку рёбер.
+ */
+static void BulkAdditionTest() {
+  const int numTries = 100;
+  const size_t maxId = 30;
+
+  random_device rd;
+  mt19937 generator(rd());
+  uniform_int_distribution<size_t> ids(0, maxId);
+  uniform_int_distribution<size_t> sizes(0, 200);
+
+  for (int i = 0; i < numTries; i++) {
+    // Повторные рёбра и петли тоже попадают в промежуток.
+    vector<pair<size_t, size_t>> list(sizes(generator));
+    for (auto& [id1, id2] : list) {
+      id1 = ids(generator);
+      id2 = ids(generator);
+    }
+
+    Graph expected;
+    for (auto [id1, id2] : list)
+      expected.AddEdge(id1, id2);
+
+    Graph bulk(list.begin(), list.end());
+
+    REQUIRE(SameGraphs(expected, bulk));
+
+    graph::BasicGraph<graph::StdHashContainers> stdBulk(list.begin(),
+                                                        list.end());
+
+    REQUIRE(SameGraphs(expected, stdBulk));
+
+    // Добавление к уже непустому графу.
+    const size_t half = list.size() / 2;
+    Graph partial;
+    partial.Reserve(maxId + 1, list.size());
+    for (size_t id = 0; id <= maxId; id += 3)
+      partial.AddVertex(id);
+    for (size_t j = 0; j < half; j++)
+      partial.AddEdge(list[j].first, list[j].second);
+    partial.AddEdges(list.begin() + half, list.end());
+
+    for (size_t id = 0; id <= maxId; id += 3)
+      expected.AddVertex(id);
+
+    REQUIRE(SameGraphs(expected, partial));
+  }
+}
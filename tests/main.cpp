@@ -22,6 +22,12 @@ int main(int argc, char* argv[]) {
   TestOrientedGraph();
   TestWeightedGraph();
   TestWeightedOrientedGraph();
+  TestCsrGraph();
+  TestCsrBuilder();
+  TestVertexIndex();
+  TestDisjointSet();
+  TestFlatHash();
+  TestSmallFlatSet();
 
   if (argc >= 2) {
     // Меняем хост, если предоставлен соответствующий аргумент командной строки.
@@ -41,6 +47,9 @@ int main(int argc, char* argv[]) {
 
   /* Сюда нужно вставить вызов набора тестов для алгоритма. */
 
+  TestServer();
+  TestGraphRequest();
+
   TestTopologicalSorting(&cli);
   TestCutPoints(&cli);
   TestDinic(&cli);
@@ -48,6 +57,11 @@ int main(int argc, char* argv[]) {
   TestMaximal(&cli);
   TestNegCycle(&cli);
   TestBelmanf(&cli);
+  TestBiconnected(&cli);
+  TestBinaryFormat(&cli);
+  TestGraphStore(&cli);
+  TestResultCache(&cli);
+  TestBatch(&cli);
 
   /* Конец вставки. */
 
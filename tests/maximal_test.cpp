@@ -1,11 +1,16 @@
 #include <maximal.hpp>
+#include <boruvka.hpp>
 #include <httplib.h>
+#include <algorithm>
+#include <random>
 #include <nlohmann/json.hpp>
 #include "test_core.hpp"
 #include "test.hpp"
 
 static void SimpleTest(httplib::Client* cli);
 static void RandomTest(httplib::Client* cli);
+static void BoruvkaTest(httplib::Client* cli);
+static void ParallelBoruvkaTest();
 
 static void RandomIntegerHelperTest(httplib::Client* cli, std::string type);
 
@@ -22,6 +27,8 @@ void TestMaximal(httplib::Client* cli) {
 
   RUN_TEST_REMOTE(suite, cli, SimpleTest);
   RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST_REMOTE(suite, cli, BoruvkaTest);
+  RUN_TEST(suite, ParallelBoruvkaTest);
 }
 
 /** 
@@ -264,3 +271,134 @@ static void RandomIntegerHelperTest(httplib::Client* cli, std::string type) {
     }
   }
 }
+
+/**
+ * @brief Множество рёбер остова в виде отсортированных пар (a, b), a < b.
+ *
+ * @param data Рёбра из ответа сервера.
+ */
+static std::vector<std::pair<size_t, size_t>> EdgeSet(
+    const nlohmann::json& data) {
+  std::vector<std::pair<size_t, size_t>> edges;
+
+  for (size_t i = 0; i < data.size(); i++) {
+    const size_t a = data[i][0], b = data[i][1];
+
+    if (a < b)
+      edges.push_back({a, b});
+  }
+
+  std::sort(edges.begin(), edges.end());
+
+  return edges;
+}
+
+/**
+ * @brief Тест на алгоритм Борувки: результат совпадает с алгоритмом
+ *        Крускала, в том числе при равных весах рёбер.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void BoruvkaTest(httplib::Client* cli) {
+  // Число попыток.
+  const int numTries = 20;
+  // Используется для инициализации генератора случайных чисел.
+  std::random_device rd;
+  // Генератор случайных чисел.
+  std::mt19937 gen(rd());
+  // Распределение для количества вершин.
+  std::uniform_int_distribution<size_t> graphSize(2, 60);
+  // Распределение для весов рёбер (много равных весов).
+  std::uniform_int_distribution<int> elem(0, 5);
+
+  for (int it = 0; it < numTries; it++) {
+    const size_t n = graphSize(gen);
+    const size_t size = 2 * n;
+    std::uniform_int_distribution<size_t> ver(0, n - 1);
+
+    nlohmann::json input;
+    input["id"] = it;
+    input["type"] = "int";
+    input["size"] = {size, n};
+    for (size_t i = 0; i < size; i++) {
+      input["data"][i * 3] = elem(gen);
+      input["data"][i * 3 + 1] = ver(gen);
+      input["data"][i * 3 + 2] = ver(gen);
+    }
+
+    httplib::Result res = cli->Post("/Maximal", input.dump(),
+        "application/json");
+    nlohmann::json expected = nlohmann::json::parse(res->body);
+
+    input["algorithm"] = "boruvka";
+    input["threads"] = 4;
+    res = cli->Post("/Maximal", input.dump(), "application/json");
+    nlohmann::json output = nlohmann::json::parse(res->body);
+
+    REQUIRE_EQUAL(expected["size"], output["size"]);
+    REQUIRE(EdgeSet(expected["data"]) == EdgeSet(output["data"]));
+  }
+
+  nlohmann::json input = R"(
+  {
+    "id": 4,
+    "type": "int",
+    "size": [ 1, 2 ],
+    "data": [ 1, 0, 1 ],
+    "algorithm": "prim"
+  }
+)"_json;
+  httplib::Result res = cli->Post("/Maximal", input.dump(),
+      "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+
+  // Количество потоков должно быть неотрицательным целым числом.
+  input["algorithm"] = "boruvka";
+  for (const nlohmann::json& threads : {nlohmann::json(-1),
+                                        nlohmann::json(2.5),
+                                        nlohmann::json("4")}) {
+    input["threads"] = threads;
+    res = cli->Post("/Maximal", input.dump(), "application/json");
+
+    REQUIRE_EQUAL(400, res->status);
+  }
+
+  // Слишком большое значение ограничивается количеством ядер.
+  input["threads"] = size_t{1} << 40;
+  res = cli->Post("/Maximal", input.dump(), "application/json");
+
+  REQUIRE_EQUAL(200, res->status);
+  REQUIRE_EQUAL(nlohmann::json::parse(res->body)["size"], 2);
+}
+
+/**
+ * @brief Тест на многопоточный алгоритм Борувки на большом графе.
+ */
+static void ParallelBoruvkaTest() {
+  // Используется для инициализации генератора случайных чисел.
+  std::random_device rd;
+  // Генератор случайных чисел.
+  std::mt19937 gen(rd());
+  // Количество вершин.
+  const size_t n = 5000;
+  // Распределение для вершин.
+  std::uniform_int_distribution<size_t> ver(0, n - 1);
+  // Распределение для весов рёбер.
+  std::uniform_int_distribution<int> elem(0, 100);
+
+  graph::WeightedGraph<int> wGraph;
+  for (size_t i = 0; i < 4 * n; i++)
+    wGraph.AddEdge(ver(gen), ver(gen), elem(gen));
+
+  const graph::Graph expected = graph::Maximal(wGraph);
+  const graph::Graph result = graph::Boruvka(wGraph, 8);
+
+  REQUIRE_EQUAL(expected.NumVertices(), result.NumVertices());
+  for (size_t v : expected.Vertices()) {
+    REQUIRE_EQUAL(expected.Edges(v).size(), result.Edges(v).size());
+
+    for (size_t neighbour : expected.Edges(v))
+      REQUIRE(result.HasEdge(v, neighbour));
+  }
+}
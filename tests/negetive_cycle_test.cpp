@@ -9,14 +9,22 @@
 #include "test_core.hpp"
 #include "test.hpp"
 #include <negetive_cycle.hpp>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
 
 static void SimpleTestNegCycle(httplib::Client* cli);
 static void RandomTestNegCycle(httplib::Client* cli);
+static void ZeroVertexTestNegCycle(httplib::Client* cli);
+static void AlgorithmsTestNegCycle();
 
 void TestNegCycle(httplib::Client* cli) {
     TestSuite suite("TestNegCycle");
     RUN_TEST_REMOTE(suite, cli, SimpleTestNegCycle);
     RUN_TEST_REMOTE(suite, cli, RandomTestNegCycle);
+    RUN_TEST_REMOTE(suite, cli, ZeroVertexTestNegCycle);
+    RUN_TEST(suite, AlgorithmsTestNegCycle);
 }
 
 /**
@@ -294,3 +302,97 @@ static void RandomTestNegCycle(httplib::Client* cli) {
         REQUIRE_EQUAL(true, find);
     }
 }
+
+/**
+ * @brief Тест на антицикл через вершину 0 для всех алгоритмов.
+ *
+ * @param cli Указатель на HTTP клиент.
+**/
+static void ZeroVertexTestNegCycle(httplib::Client* cli) {
+    nlohmann::json input = R"(
+    {
+    "id": 5,
+    "type": "weighted_oriented_graph",
+    "TypeWeights": "int",
+    "size": 3,
+    "vertices": [ 0, 1, 2 ],
+    "numEdges": 3,
+    "edges": [[0,1,-1],[1,2,-1],[2,0,-1]]
+    }
+    )"_json;
+    for (const std::string algorithm : {"tarjan", "spfa", "bellman_ford"}) {
+        input["algorithm"] = algorithm;
+        httplib::Result res = cli->Post("/NegCycle", input.dump(),
+                                        "application/json");
+        nlohmann::json output = nlohmann::json::parse(res->body);
+        REQUIRE_EQUAL(algorithm, output["algorithm"]);
+        REQUIRE_EQUAL(output["data"].size(), static_cast<size_t>(4));
+        std::vector<size_t> cycle = output["data"];
+        std::sort(cycle.begin(), cycle.end() - 1);
+        REQUIRE(cycle[0] == 0 && cycle[1] == 1 && cycle[2] == 2);
+    }
+    input["algorithm"] = "floyd";
+    httplib::Result res = cli->Post("/NegCycle", input.dump(),
+                                    "application/json");
+    REQUIRE_EQUAL(400, res->status);
+}
+
+/**
+ * @brief Проверить, что путь - антицикл графа.
+ *
+ * @param graph Граф.
+ * @param cycle Замкнутый путь.
+**/
+static bool IsNegativeCycle(const graph::WeightedOrientedGraph<int>& graph,
+                            const std::vector<size_t>& cycle) {
+    if (cycle.size() < 2 || cycle.front() != cycle.back())
+        return false;
+    int weight = 0;
+    for (size_t i = 0; i + 1 < cycle.size(); i++) {
+        if (!graph.HasEdge(cycle[i], cycle[i + 1]))
+            return false;
+        weight += graph.EdgeWeight(cycle[i], cycle[i + 1]);
+    }
+    return weight < 0;
+}
+
+/**
+ * @brief Сравнение алгоритмов поиска антицикла на случайных графах.
+**/
+static void AlgorithmsTestNegCycle() {
+    const int numTries = 300;  // число попыток
+    // Используется для инициализации генератора случайных чисел.
+    std::random_device rd;
+    // Генератор случайных чисел.
+    std::mt19937 gen(rd());
+    std::uniform_int_distribution<size_t> graphSize(1, 30);
+    for (int it = 0; it < numTries; it++) {
+        const size_t n = graphSize(gen);
+        std::uniform_int_distribution<size_t> vert(0, n - 1);
+        std::uniform_int_distribution<size_t> numEdges(0, 3 * n);
+        // чем больше сдвиг, тем реже встречаются антициклы
+        std::uniform_int_distribution<int> weight(-3, 3 + it % 10);
+        graph::WeightedOrientedGraph<int> g;
+        for (size_t v = 0; v < n; v++)
+            g.AddVertex(v);
+        for (size_t i = numEdges(gen); i > 0; i--)
+            g.AddEdge(vert(gen), vert(gen), weight(gen));
+
+        const graph::CsrGraph<int> csr(g);
+        std::vector<size_t> cycle1, cycle2, cycle3, path;
+        const bool found1 = graph::NegCycleBellmanFord(csr, &cycle1);
+        const bool found2 = graph::NegCycleSpfa(csr, &cycle2);
+        const bool found3 = graph::NegCycleTarjan(csr, &cycle3);
+        REQUIRE_EQUAL(found1, found2);
+        REQUIRE_EQUAL(found1, found3);
+        if (found1) {
+            for (auto* cycle : {&cycle1, &cycle2, &cycle3}) {
+                for (size_t& v : *cycle)
+                    v = csr.Id(v);
+                REQUIRE(IsNegativeCycle(g, *cycle));
+            }
+        }
+        graph::NegCycle(g, &path);
+        REQUIRE_EQUAL(found1, !path.empty());
+    }
+}
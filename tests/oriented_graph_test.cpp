@@ -5,6 +5,8 @@
  * Тесты для класса graph::OrientedGraph.
  */
 
+#include <utility>
+#include <vector>
 #include "test_core.hpp"
 #include <oriented_graph.hpp>
 
@@ -12,12 +14,14 @@ using graph::OrientedGraph;
 
 static void SimpleTest();
 static void AnotherSimpleTest();
+static void BulkTest();
 
 void TestOrientedGraph() {
   TestSuite suite("TestOrientedGraph");
 
   RUN_TEST(suite, SimpleTest);
   RUN_TEST(suite, AnotherSimpleTest);
+  RUN_TEST(suite, BulkTest);
 }
 
 static void SimpleTest() {
@@ -55,3 +59,51 @@ static void AnotherSimpleTest() {
 
   REQUIRE(!graph.HasEdge(1, 2));
 }
+
+/**
+ * @brief Проверить, что множества соседей совпадают.
+ */
+template<typename Set>
+static bool SameSets(const Set& first, const Set& second) {
+  if (first.size() != second.size())
+    return false;
+
+  for (size_t id : first)
+    if (second.count(id) == 0)
+      return false;
+
+  return true;
+}
+
+static void BulkTest() {
+  const std::vector<std::pair<size_t, size_t>> list = {
+    {1, 2}, {3, 1}, {1, 2}, {4, 4}, {1, 5}, {6, 1}
+  };
+
+  OrientedGraph expected;
+  for (auto [id1, id2] : list)
+    expected.AddEdge(id1, id2);
+
+  OrientedGraph graph;
+  graph.Reserve(6, list.size());
+  graph.AddVertex(7);
+  graph.AddEdges(list.begin(), list.end());
+
+  REQUIRE_EQUAL(graph.NumVertices(), expected.NumVertices() + 1);
+  REQUIRE(graph.HasVertex(7));
+
+  for (size_t id : expected.Vertices()) {
+    REQUIRE(SameSets(graph.Edges(id), expected.Edges(id)));
+    REQUIRE(SameSets(graph.IncomingEdges(id), expected.IncomingEdges(id)));
+  }
+
+  REQUIRE_EQUAL(graph.Edges(1).size(), size_t{2});
+  REQUIRE_EQUAL(graph.IncomingEdges(1).size(), size_t{2});
+  REQUIRE(graph.HasEdge(4, 4));
+  REQUIRE(!graph.HasEdge(2, 1));
+
+  OrientedGraph copy(list.begin(), list.end());
+
+  REQUIRE_EQUAL(copy.NumVertices(), expected.NumVertices());
+  REQUIRE(SameSets(copy.IncomingEdges(5), expected.IncomingEdges(5)));
+}
@@ -0,0 +1,272 @@
+/**
+ * @file tests/result_cache_test.cpp
+ *
+ * Тесты для кэша результатов методов.
+ */
+
+#include <httplib.h>
+#include <cstdint>
+#include <string>
+#include <nlohmann/json.hpp>
+#include "test_core.hpp"
+#include "test.hpp"
+#include "../methods/binary_format.hpp"
+#include "../methods/graph_request.hpp"
+#include "../methods/result_cache.hpp"
+
+using graph::EncodeBinaryGraph;
+using graph::GraphRequest;
+using graph::Hasher64;
+using graph::kBinaryGraphContentType;
+using graph::PackGraphRequest;
+using graph::ReadBinaryGraphRequest;
+using graph::ReadGraphRequest;
+using graph::ResultCache;
+using graph::SameGraphRequest;
+
+static void HasherTest();
+static void KeyTest();
+static void EvictionTest();
+static void CollisionTest();
+static void EndpointTest(httplib::Client* cli);
+
+void TestResultCache(httplib::Client* cli) {
+  TestSuite suite("TestResultCache");
+
+  RUN_TEST(suite, HasherTest);
+  RUN_TEST(suite, KeyTest);
+  RUN_TEST(suite, EvictionTest);
+  RUN_TEST(suite, CollisionTest);
+  RUN_TEST_REMOTE(suite, cli, EndpointTest);
+}
+
+/**
+ * @brief Хэш совпадает с XXH64 от слов в порядке little-endian.
+ */
+static void HasherTest() {
+  REQUIRE_EQUAL(Hasher64().Finish(), uint64_t{0xEF46DB3751D8E999});
+
+  Hasher64 one;
+  one.Add(1);
+  REQUIRE_EQUAL(one.Finish(), uint64_t{0x9F29CB17A2A49995});
+
+  Hasher64 six;
+  for (uint64_t word = 1; word <= 6; word++)
+    six.Add(word);
+  REQUIRE_EQUAL(six.Finish(), uint64_t{0xCC1B402BA7A65B7B});
+
+  Hasher64 text, other;
+  text.Add(std::string("abc"));
+  other.Add(std::string("abc\0", 4));
+  REQUIRE(text.Finish() != other.Finish());
+}
+
+/**
+ * @brief Построить запрос в формате JSON.
+ *
+ * @param body Текст запроса.
+ */
+static GraphRequest JsonRequest(const std::string& body) {
+  GraphRequest request;
+  REQUIRE_EQUAL(ReadGraphRequest(body, &request), 0);
+  return request;
+}
+
+/**
+ * @brief Построить ключ запроса в формате JSON.
+ *
+ * @param endpoint Адрес метода.
+ * @param body Текст запроса.
+ */
+static std::string JsonKey(const std::string& endpoint,
+                           const std::string& body) {
+  std::string key;
+  REQUIRE(ResultCache::MakeKey(endpoint, JsonRequest(body), &key));
+  return key;
+}
+
+/**
+ * @brief Ключ зависит от графа и параметров, но не от "id" и формата.
+ */
+static void KeyTest() {
+  const nlohmann::json input = R"({
+    "id": 1, "type": "weighted_oriented_graph", "start": 1, "theEnd": 3,
+    "vertices": [1, 2, 3], "edges": [[1, 2, 5], [2, 3, -0.0]]
+  })"_json;
+  const std::string key = JsonKey("/Dinic", input.dump());
+
+  nlohmann::json changed = input;
+  changed["id"] = 2;
+  REQUIRE_EQUAL(JsonKey("/Dinic", changed.dump()), key);
+
+  // Тот же граф в бинарном формате.
+  std::string body;
+  GraphRequest binary;
+  std::string binaryKey;
+  REQUIRE_EQUAL(EncodeBinaryGraph(input, &body), 0);
+  REQUIRE_EQUAL(ReadBinaryGraphRequest(body, &binary), 0);
+  REQUIRE(ResultCache::MakeKey("/Dinic", binary, &binaryKey));
+  REQUIRE_EQUAL(binaryKey, key);
+  REQUIRE(SameGraphRequest(PackGraphRequest(binary),
+                           JsonRequest(input.dump())));
+
+  REQUIRE(JsonKey("/Maximal", input.dump()) != key);
+
+  changed = input;
+  changed["theEnd"] = 2;
+  REQUIRE(JsonKey("/Dinic", changed.dump()) != key);
+
+  changed = input;
+  changed["edges"][0][2] = 6;
+  REQUIRE(JsonKey("/Dinic", changed.dump()) != key);
+
+  changed = input;
+  changed["edges"][1] = {3, 2, 0};
+  REQUIRE(JsonKey("/Dinic", changed.dump()) != key);
+
+  changed = input;
+  changed["vertices"].push_back(4);
+  REQUIRE(JsonKey("/Dinic", changed.dump()) != key);
+
+  // Запрос без "id" не кэшируется.
+  changed = input;
+  changed.erase("id");
+  GraphRequest request;
+  std::string unused;
+  REQUIRE_EQUAL(ReadGraphRequest(changed.dump(), &request), 0);
+  REQUIRE(!ResultCache::MakeKey("/Dinic", request, &unused));
+}
+
+/**
+ * @brief Счётчики и вытеснение давно запрошенных результатов.
+ */
+static void EvictionTest() {
+  const nlohmann::json result = {{"id", 1}, {"data", {1, 2, 3}}};
+  const GraphRequest request;
+  nlohmann::json output;
+
+  ResultCache disabled(0);
+  disabled.Save("a", request, result);
+  REQUIRE(!disabled.Find("a", request, &output));
+  REQUIRE_EQUAL(disabled.Misses(), size_t{0});
+
+  ResultCache cache(600);
+  REQUIRE(!cache.Find("a", request, &output));
+  cache.Save("a", request, result);
+  REQUIRE(cache.Find("a", request, &output));
+  REQUIRE(output == result);
+  REQUIRE_EQUAL(cache.Hits(), size_t{1});
+  REQUIRE_EQUAL(cache.Misses(), size_t{1});
+
+  cache.Save("b", request, result);
+  cache.Save("c", request, result);
+  REQUIRE_EQUAL(cache.Size(), size_t{3});
+  REQUIRE(cache.MemoryUsage() <= cache.MemoryBudget());
+
+  // "a" запрошен недавно, поэтому вытесняется "b".
+  REQUIRE(cache.Find("a", request, &output));
+  cache.Save("d", request, result);
+  REQUIRE(cache.MemoryUsage() <= cache.MemoryBudget());
+  REQUIRE(!cache.Find("b", request, &output));
+  REQUIRE(cache.Find("a", request, &output));
+  REQUIRE(cache.Find("d", request, &output));
+
+  // Результат больше всего кэша не запоминается.
+  cache.Save("huge", request, {{"data", std::string(1000, 'x')}});
+  REQUIRE(!cache.Find("huge", request, &output));
+  REQUIRE(cache.Find("d", request, &output));
+}
+
+/**
+ * @brief При совпадении ключей графы сравниваются целиком.
+ */
+static void CollisionTest() {
+  const GraphRequest first = JsonRequest(R"({
+    "id": 1, "type": "weighted_graph", "vertices": [1, 2],
+    "edges": [[1, 2, 5]]
+  })");
+  const GraphRequest second = JsonRequest(R"({
+    "id": 1, "type": "weighted_graph", "vertices": [1, 2],
+    "edges": [[1, 2, 6]]
+  })");
+  nlohmann::json output;
+
+  REQUIRE(SameGraphRequest(PackGraphRequest(first), first));
+  REQUIRE(!SameGraphRequest(PackGraphRequest(first), second));
+  REQUIRE(!SameGraphRequest(PackGraphRequest(first) + "x", first));
+  REQUIRE(!SameGraphRequest("", first));
+
+  // Одинаковый ключ у разных графов (как при коллизии хэша).
+  ResultCache cache(1000);
+  cache.Save("key", first, {{"data", 1}});
+  REQUIRE(!cache.Find("key", second, &output));
+  REQUIRE(cache.Find("key", first, &output));
+  REQUIRE_EQUAL(output.at("data"), 1);
+
+  // Результат для другого графа заменяет старый.
+  cache.Save("key", second, {{"data", 2}});
+  REQUIRE_EQUAL(cache.Size(), size_t{1});
+  REQUIRE(cache.MemoryUsage() <= cache.MemoryBudget());
+  REQUIRE(!cache.Find("key", first, &output));
+  REQUIRE(cache.Find("key", second, &output));
+  REQUIRE_EQUAL(output.at("data"), 2);
+}
+
+/**
+ * @brief Прочитать состояние кэша сервера.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static nlohmann::json CacheStats(httplib::Client* cli) {
+  httplib::Result res = cli->Get("/cache");
+  REQUIRE_EQUAL(res->status, 200);
+  return nlohmann::json::parse(res->body);
+}
+
+/**
+ * @brief Повторный запрос берётся из кэша и получает свой "id".
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void EndpointTest(httplib::Client* cli) {
+  nlohmann::json input = {{"id", 1}, {"type", "int"}, {"size", {4, 4}},
+                          {"data", {7, 1, 2, 3, 2, 3, 5, 3, 4, 4, 1, 4}}};
+  const nlohmann::json before = CacheStats(cli);
+
+  httplib::Result res = cli->Post("/Maximal", input.dump(),
+                                  "application/json");
+  REQUIRE_EQUAL(res->status, 200);
+  nlohmann::json first = nlohmann::json::parse(res->body);
+
+  input["id"] = 2;
+  res = cli->Post("/Maximal", input.dump(), "application/json");
+  REQUIRE_EQUAL(res->status, 200);
+  nlohmann::json second = nlohmann::json::parse(res->body);
+  REQUIRE_EQUAL(second["id"], 2);
+  second["id"] = 1;
+  REQUIRE(second == first);
+
+  // Тот же граф в бинарном формате.
+  std::string body;
+  REQUIRE_EQUAL(EncodeBinaryGraph(input, &body), 0);
+  res = cli->Post("/Maximal", body, kBinaryGraphContentType);
+  REQUIRE_EQUAL(res->status, 200);
+
+  const nlohmann::json after = CacheStats(cli);
+  REQUIRE_EQUAL(after["hits"].get<size_t>() - before["hits"].get<size_t>(),
+                size_t{2});
+  REQUIRE_EQUAL(
+      after["misses"].get<size_t>() - before["misses"].get<size_t>(),
+      size_t{1});
+  REQUIRE(after["entries"].get<size_t>() >= 1);
+  REQUIRE(after["memory"].get<size_t>() <=
+          after["memoryBudget"].get<size_t>());
+
+  // Ошибочные запросы не запоминаются.
+  input["type"] = "string";
+  for (int i = 0; i < 2; i++) {
+    res = cli->Post("/Maximal", input.dump(), "application/json");
+    REQUIRE_EQUAL(res->status, 400);
+  }
+  REQUIRE_EQUAL(CacheStats(cli)["hits"], after["hits"]);
+}
@@ -0,0 +1,269 @@
+/**
+ * @file tests/server_test.cpp
+ *
+ * Тесты для параметров сервера, пула потоков и ограничения числа
+ * одновременных запросов.
+ */
+
+#include <httplib.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <nlohmann/json.hpp>
+#include "test_core.hpp"
+#include "test.hpp"
+#include "../methods/server.hpp"
+
+using graph::BoundedThreadPool;
+using graph::ConcurrencyLimiter;
+using graph::OverloadedResponse;
+using graph::ParseServerOptions;
+using graph::ServerOptions;
+
+static void DefaultOptionsTest();
+static void OptionsTest();
+static void InvalidOptionsTest();
+static void LimiterTest();
+static void ThreadPoolTest();
+static void OverloadedResponseTest();
+
+void TestServer() {
+  TestSuite suite("TestServer");
+
+  RUN_TEST(suite, DefaultOptionsTest);
+  RUN_TEST(suite, OptionsTest);
+  RUN_TEST(suite, InvalidOptionsTest);
+  RUN_TEST(suite, LimiterTest);
+  RUN_TEST(suite, ThreadPoolTest);
+  RUN_TEST(suite, OverloadedResponseTest);
+}
+
+/**
+ * @brief Разобрать параметры, заданные списком строк.
+ *
+ * @param args Аргументы без имени программы.
+ * @param options Параметры сервера.
+ */
+static int Parse(std::vector<std::string> args, ServerOptions* options) {
+  std::vector<char*> argv = {const_cast<char*>("graph_server")};
+
+  for (std::string& arg : args)
+    argv.push_back(&arg[0]);
+
+  return ParseServerOptions(static_cast<int>(argv.size()), argv.data(),
+                            options);
+}
+
+/**
+ * @brief Без аргументов и со старым форматом (только порт).
+ */
+static void DefaultOptionsTest() {
+  {
+    ServerOptions options;
+    REQUIRE_EQUAL(Parse({}, &options), 0);
+    REQUIRE_EQUAL(options.port, 2022);
+    REQUIRE(options.workers > 0);
+    REQUIRE(options.endpointLimit > 0);
+    REQUIRE(options.endpointLimit <= options.workers);
+  }
+
+  {
+    ServerOptions options;
+    REQUIRE_EQUAL(Parse({"8080"}, &options), 0);
+    REQUIRE_EQUAL(options.port, 8080);
+  }
+}
+
+/**
+ * @brief Все параметры.
+ */
+static void OptionsTest() {
+  ServerOptions options;
+
+  REQUIRE_EQUAL(Parse({"8080", "--workers", "8", "--queue-depth=16",
+                       "--keep-alive-max-count", "100",
+                       "--keep-alive-timeout=10", "--read-timeout=3",
+                       "--write-timeout", "4", "--max-body=1024",
+                       "--graph-memory", "4096", "--result-cache=2048",
+                       "--batch-threads", "3",
+                       "--limit", "/Dinic=2", "--limit=/NegCycle=1"},
+                      &options), 0);
+  REQUIRE_EQUAL(options.port, 8080);
+  REQUIRE_EQUAL(options.workers, size_t{8});
+  REQUIRE_EQUAL(options.queueDepth, size_t{16});
+  REQUIRE_EQUAL(options.keepAliveMaxCount, size_t{100});
+  REQUIRE_EQUAL(options.keepAliveTimeout, time_t{10});
+  REQUIRE_EQUAL(options.readTimeout, time_t{3});
+  REQUIRE_EQUAL(options.writeTimeout, time_t{4});
+  REQUIRE_EQUAL(options.maxBodyLength, size_t{1024});
+  REQUIRE_EQUAL(options.graphMemory, size_t{4096});
+  REQUIRE_EQUAL(options.resultCacheMemory, size_t{2048});
+  REQUIRE_EQUAL(options.batchThreads, size_t{3});
+  REQUIRE_EQUAL(options.endpointLimit, size_t{7});
+  REQUIRE_EQUAL(options.endpointLimits.size(), size_t{2});
+  REQUIRE_EQUAL(options.endpointLimits.at("/Dinic"), size_t{2});
+  REQUIRE_EQUAL(options.endpointLimits.at("/NegCycle"), size_t{1});
+}
+
+/**
+ * @brief Некорректные параметры.
+ */
+static void InvalidOptionsTest() {
+  const std::vector<std::vector<std::string>> invalid = {
+    {"port"},
+    {"70000"},
+    {"--workers"},
+    {"--workers=-1"},
+    {"--workers=two"},
+    {"--unknown=1"},
+    {"--limit=/Dinic"},
+    {"--limit=/Dinic=0"},
+    {"8080", "9090"},
+  };
+
+  for (const std::vector<std::string>& args : invalid) {
+    ServerOptions options;
+    REQUIRE_EQUAL(Parse(args, &options), -1);
+  }
+}
+
+/**
+ * @brief Запросы сверх ограничения сразу получают 503.
+ */
+static void LimiterTest() {
+  const ConcurrencyLimiter limiter(1, {{"/Free", 2}, {"/Off", 0}});
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool release = false;
+  std::atomic<size_t> started(0);
+
+  // Обработчик, который ждёт разрешения завершиться.
+  auto blocking = [&](const httplib::Request&, httplib::Response& res) {
+    started++;
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [&] { return release; });
+    res.status = 200;
+  };
+  auto quick = [](const httplib::Request&, httplib::Response& res) {
+    res.status = 200;
+  };
+
+  httplib::Handler slow = limiter.Wrap("/Slow", blocking);
+  httplib::Handler free = limiter.Wrap("/Free", quick);
+  httplib::Handler off = limiter.Wrap("/Off", quick);
+  httplib::Request req;
+  httplib::Response first, second, third, fourth;
+
+  std::thread thread([&] { slow(req, first); });
+  while (started == 0)
+    std::this_thread::yield();
+
+  // Второй запрос к занятому методу отклоняется, другой метод работает.
+  slow(req, second);
+  free(req, third);
+  off(req, fourth);
+
+  // Пакетные запросы занимают те же места, что и обработчики.
+  REQUIRE(!limiter.Acquire("/Slow"));
+  REQUIRE(!limiter.Acquire("/Off"));
+  {
+    const ConcurrencyLimiter::Slot slot = limiter.Acquire("/Free");
+    REQUIRE(static_cast<bool>(slot));
+    REQUIRE(static_cast<bool>(limiter.Acquire("/Free")));
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    release = true;
+  }
+  condition.notify_all();
+  thread.join();
+
+  REQUIRE_EQUAL(first.status, 200);
+  REQUIRE_EQUAL(second.status, 503);
+  REQUIRE_EQUAL(second.get_header_value("Retry-After"), std::string("1"));
+  REQUIRE_EQUAL(third.status, 200);
+  REQUIRE_EQUAL(fourth.status, 503);
+
+  // После завершения первого запроса метод снова доступен.
+  httplib::Response fifth;
+  slow(req, fifth);
+  REQUIRE_EQUAL(fifth.status, 200);
+  REQUIRE_EQUAL(started.load(), size_t{2});
+}
+
+/**
+ * @brief Задачи сверх длины очереди сразу выполняются в вызывающем
+ *        потоке с флагом IsOverloaded().
+ */
+static void ThreadPoolTest() {
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool release = false;
+  std::atomic<size_t> started(0), done(0), overloaded(0);
+  size_t doneBeforeRelease = 0, overloadedBeforeRelease = 0;
+
+  {
+    BoundedThreadPool pool(1, 1);
+
+    // Первая задача занимает единственный рабочий поток.
+    pool.enqueue([&] {
+      started++;
+      std::unique_lock<std::mutex> lock(mutex);
+      condition.wait(lock, [&] { return release; });
+      done++;
+    });
+    while (started == 0)
+      std::this_thread::yield();
+
+    // Вторая ждёт в очереди, третья и четвёртая получают отказ.
+    const std::thread::id caller = std::this_thread::get_id();
+    for (size_t i = 0; i < 3; i++) {
+      pool.enqueue([&] {
+        if (BoundedThreadPool::IsOverloaded() &&
+            std::this_thread::get_id() == caller)
+          overloaded++;
+        done++;
+      });
+    }
+
+    // Отказы выполнены до возврата из enqueue(), пока рабочий поток занят.
+    doneBeforeRelease = done;
+    overloadedBeforeRelease = overloaded;
+    REQUIRE(!BoundedThreadPool::IsOverloaded());
+
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      release = true;
+    }
+    condition.notify_all();
+    pool.shutdown();
+  }
+
+  REQUIRE_EQUAL(doneBeforeRelease, size_t{2});
+  REQUIRE_EQUAL(overloadedBeforeRelease, size_t{2});
+  REQUIRE_EQUAL(done.load(), size_t{4});
+  REQUIRE_EQUAL(overloaded.load(), size_t{2});
+}
+
+/**
+ * @brief Готовый ответ 503 - корректный HTTP ответ.
+ */
+static void OverloadedResponseTest() {
+  const std::string& response = OverloadedResponse();
+  const size_t headerEnd = response.find("\r\n\r\n");
+
+  REQUIRE_EQUAL(response.compare(0, 13, "HTTP/1.1 503 "), 0);
+  REQUIRE(headerEnd != std::string::npos);
+  REQUIRE(response.find("Connection: close\r\n") < headerEnd);
+  REQUIRE(response.find("Retry-After: 1\r\n") < headerEnd);
+
+  const std::string body = response.substr(headerEnd + 4);
+  REQUIRE(response.find("Content-Length: " + std::to_string(body.size()) +
+                        "\r\n") < headerEnd);
+  REQUIRE(nlohmann::json::parse(body).contains("error"));
+}
@@ -0,0 +1,208 @@
+/**
+ * @file tests/small_flat_set_test.cpp
+ *
+ * Тесты для класса graph::SmallFlatSet.
+ */
+
+#include <algorithm>
+#include <random>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "test_core.hpp"
+#include <oriented_graph.hpp>
+#include <small_flat_set.hpp>
+
+using std::unordered_set;
+using std::vector;
+
+using graph::OrientedGraph;
+using graph::SmallFlatSet;
+
+static void InlineTest();
+static void SpillTest();
+static void CopyTest();
+static void RandomTest();
+static void GraphTest();
+
+/**
+ * @brief Основная функция для тестирования класса graph::SmallFlatSet.
+ */
+void TestSmallFlatSet() {
+  TestSuite suite("TestSmallFlatSet");
+
+  RUN_TEST(suite, InlineTest);
+  RUN_TEST(suite, SpillTest);
+  RUN_TEST(suite, CopyTest);
+  RUN_TEST(suite, RandomTest);
+  RUN_TEST(suite, GraphTest);
+}
+
+/**
+ * @brief Функция возвращает отсортированные элементы множества.
+ *
+ * @param set Множество.
+ */
+template<typename Set>
+static vector<size_t> Sorted(const Set& set) {
+  vector<size_t> items(set.begin(), set.end());
+  std::sort(items.begin(), items.end());
+  return items;
+}
+
+/**
+ * @brief Элементы внутри объекта.
+ */
+static void InlineTest() {
+  SmallFlatSet<size_t> set;
+
+  // Незанятые ячейки массива не считаются элементами.
+  REQUIRE(set.empty());
+  REQUIRE_EQUAL(set.count(0), 0ul);
+  REQUIRE(set.find(0) == set.end());
+  REQUIRE(set.begin() == set.end());
+
+  REQUIRE(set.insert(0).second);
+  REQUIRE(set.insert(7).second);
+  REQUIRE(!set.insert(0).second);
+  REQUIRE_EQUAL(*set.insert(3).first, 3ul);
+  REQUIRE_EQUAL(set.size(), 3ul);
+  REQUIRE_EQUAL(set.count(0), 1ul);
+  REQUIRE_EQUAL(set.count(7), 1ul);
+  REQUIRE_EQUAL(set.count(5), 0ul);
+  REQUIRE_EQUAL(*set.find(7), 7ul);
+  REQUIRE(Sorted(set) == vector<size_t>({0, 3, 7}));
+
+  REQUIRE_EQUAL(set.erase(0), 1ul);
+  REQUIRE_EQUAL(set.erase(0), 0ul);
+  REQUIRE_EQUAL(set.count(0), 0ul);
+  REQUIRE(Sorted(set) == vector<size_t>({3, 7}));
+
+  set.clear();
+  REQUIRE(set.empty());
+  REQUIRE_EQUAL(set.count(3), 0ul);
+}
+
+/**
+ * @brief Перенос элементов в хеш-таблицу и обратно.
+ */
+static void SpillTest() {
+  SmallFlatSet<size_t, 4> set;
+
+  for (size_t i = 1; i <= 10; i++)
+    REQUIRE(set.insert(i * 100).second);
+  REQUIRE_EQUAL(set.size(), 10ul);
+  for (size_t i = 1; i <= 10; i++)
+    REQUIRE_EQUAL(set.count(i * 100), 1ul);
+  REQUIRE_EQUAL(set.count(0), 0ul);
+
+  for (size_t i = 1; i <= 8; i++)
+    REQUIRE_EQUAL(set.erase(i * 100), 1ul);
+  REQUIRE(Sorted(set) == vector<size_t>({900, 1000}));
+  REQUIRE_EQUAL(set.count(900), 1ul);
+  REQUIRE_EQUAL(set.count(100), 0ul);
+
+  for (size_t i = 0; i < 3; i++)
+    set.insert(i);
+  REQUIRE(Sorted(set) == vector<size_t>({0, 1, 2, 900, 1000}));
+
+  SmallFlatSet<size_t, 4> reserved;
+  reserved.reserve(100);
+  REQUIRE(reserved.empty());
+  for (size_t i = 0; i < 100; i++)
+    reserved.insert(i);
+  REQUIRE_EQUAL(reserved.size(), 100ul);
+}
+
+/**
+ * @brief Копирование и перемещение.
+ */
+static void CopyTest() {
+  for (size_t n : {2ul, 10ul}) {
+    SmallFlatSet<size_t> set;
+    for (size_t i = 0; i < n; i++)
+      set.insert(i);
+
+    SmallFlatSet<size_t> copy = set;
+    set.erase(0);
+    REQUIRE_EQUAL(copy.count(0), 1ul);
+    REQUIRE_EQUAL(set.count(0), 0ul);
+
+    SmallFlatSet<size_t> moved = std::move(copy);
+    REQUIRE_EQUAL(moved.size(), n);
+
+    copy = moved;
+    copy = copy;
+    REQUIRE(Sorted(copy) == Sorted(moved));
+  }
+}
+
+/**
+ * @brief Случайные операции дают тот же результат, что и со
+ *        std::unordered_set.
+ *
+ * @tparam N Количество элементов внутри объекта.
+ */
+template<size_t N>
+static void RandomTestImpl() {
+  std::mt19937 gen(22);
+  SmallFlatSet<size_t, N> set;
+  unordered_set<size_t> expected;
+
+  for (size_t step = 0; step < 20000; step++) {
+    // Множество то растёт, то сжимается, проходя через порог переноса.
+    const size_t range = step % 2000 < 1000 ? 3 * N : 4;
+    const size_t key = gen() % range;
+
+    switch (gen() % 3) {
+      case 0:
+        REQUIRE_EQUAL(set.insert(key).second, expected.insert(key).second);
+        break;
+      case 1:
+        REQUIRE_EQUAL(set.erase(key), expected.erase(key));
+        break;
+      default:
+        REQUIRE_EQUAL(set.count(key), expected.count(key));
+        REQUIRE_EQUAL(set.find(key) != set.end(), expected.count(key) != 0);
+    }
+
+    REQUIRE_EQUAL(set.size(), expected.size());
+  }
+
+  REQUIRE(unordered_set<size_t>(set.begin(), set.end()) == expected);
+}
+
+/**
+ * @brief Случайные операции для разных размеров массива.
+ */
+static void RandomTest() {
+  RandomTestImpl<1>();
+  RandomTestImpl<3>();
+  RandomTestImpl<4>();
+  RandomTestImpl<8>();
+}
+
+/**
+ * @brief Граф с вершинами малой и большой степени.
+ */
+static void GraphTest() {
+  OrientedGraph graph;
+
+  for (size_t i = 1; i <= 100; i++) {
+    graph.AddEdge(0, i);
+    graph.AddEdge(i, i % 100 + 1);
+  }
+
+  REQUIRE_EQUAL(graph.Edges(0).size(), 100ul);
+  REQUIRE_EQUAL(graph.IncomingEdges(1).size(), 2ul);
+  REQUIRE(graph.HasEdge(0, 50));
+  REQUIRE(graph.HasEdge(50, 51));
+  REQUIRE(!graph.HasEdge(51, 50));
+  REQUIRE(!graph.HasEdge(50, 0));
+
+  graph.RemoveVertex(0);
+  for (size_t i = 1; i <= 100; i++) {
+    REQUIRE_EQUAL(graph.Edges(i).size(), 1ul);
+    REQUIRE_EQUAL(graph.IncomingEdges(i).size(), 1ul);
+  }
+}
@@ -30,6 +30,46 @@ void TestWeightedGraph();
  */
 void TestWeightedOrientedGraph();
 
+/**
+ * @brief Набор тестов для класса graph::CsrGraph.
+ */
+void TestCsrGraph();
+
+/**
+ * @brief Набор тестов для класса graph::ParallelCsrBuilder.
+ */
+void TestCsrBuilder();
+
+/**
+ * @brief Набор тестов для класса graph::VertexIndex.
+ */
+void TestVertexIndex();
+
+/**
+ * @brief Набор тестов для класса graph::DisjointSet.
+ */
+void TestDisjointSet();
+
+/**
+ * @brief Набор тестов для классов graph::FlatHashSet и graph::FlatHashMap.
+ */
+void TestFlatHash();
+
+/**
+ * @brief Набор тестов для класса graph::SmallFlatSet.
+ */
+void TestSmallFlatSet();
+
+/**
+ * @brief Набор тестов для параметров сервера и ограничения нагрузки.
+ */
+void TestServer();
+
+/**
+ * @brief Набор тестов для потокового чтения запросов к серверу.
+ */
+void TestGraphRequest();
+
 /* Сюда нужно добавить объявления тестовых функций. */
 
 /**
@@ -57,6 +97,38 @@ void TestBelmanf(httplib::Client* cli);
  * @param cli Указатель на HTTP клиент.
  */
 void TestDinic(httplib::Client *cli);
+/**
+ * @brief Набор тестов для поиска компонент двусвязности.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+void TestBiconnected(httplib::Client* cli);
+/**
+ * @brief Набор тестов для бинарного формата запросов и ответов.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+void TestBinaryFormat(httplib::Client* cli);
+/**
+ * @brief Набор тестов для хранилища загруженных графов.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+void TestGraphStore(httplib::Client* cli);
+
+/**
+ * @brief Набор тестов для кэша результатов методов.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+void TestResultCache(httplib::Client* cli);
+
+/**
+ * @brief Набор тестов для пакетных запросов.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+void TestBatch(httplib::Client* cli);
 /* Конец вставки. */
 
 #endif  // TESTS_TEST_HPP_
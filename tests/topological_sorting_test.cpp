@@ -7,12 +7,20 @@
 
 #include <topological_sorting.hpp>
 #include <httplib.h>
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include "test_core.hpp"
 #include "test.hpp"
 
 static void SimpleTest(httplib::Client* cli);
 static void RandomTest(httplib::Client* cli);
+static void LongChainTest();
+static void KahnSimpleTest(httplib::Client* cli);
+static void KahnRandomTest();
+static void KahnCycleTest();
 
 
 void TestTopologicalSorting(httplib::Client* cli) {
@@ -20,6 +28,10 @@ void TestTopologicalSorting(httplib::Client* cli) {
 
   RUN_TEST_REMOTE(suite, cli, SimpleTest);
   RUN_TEST_REMOTE(suite, cli, RandomTest);
+  RUN_TEST(suite, LongChainTest);
+  RUN_TEST_REMOTE(suite, cli, KahnSimpleTest);
+  RUN_TEST(suite, KahnRandomTest);
+  RUN_TEST(suite, KahnCycleTest);
 }
 
 /**
@@ -176,3 +188,173 @@ static void RandomTest(httplib::Client* cli) {
     }
   }
 }
+
+/**
+ * @brief Тест на длинной цепочке: обход не должен переполнять стек.
+ */
+static void LongChainTest() {
+  const size_t n = 500000;
+  graph::OrientedGraph graph;
+
+  for (size_t i = 0; i + 1 < n; i++)
+    graph.AddEdge(i, i + 1);
+
+  std::vector<size_t> result;
+  graph::TopologicalSorting(graph, &result);
+
+  REQUIRE_EQUAL(n, result.size());
+  for (size_t i = 0; i < n; i++)
+    REQUIRE_EQUAL(i, result[i]);
+}
+
+/**
+ * @brief Тест алгоритма Кана через сервер: порядок, уровни и цикл.
+ *
+ * @param cli Указатель на HTTP клиент.
+ */
+static void KahnSimpleTest(httplib::Client* cli) {
+  nlohmann::json input = R"(
+  {
+    "id": 1,
+    "type": "oriented_graph",
+    "size": 5,
+    "vertices": [ 5, 1, 2, 4, 3 ],
+    "numEdges": 4,
+    "edges": [ [1,2], [1,3], [3,4], [2,4] ],
+    "algorithm": "kahn"
+  }
+)"_json;
+
+  httplib::Result res = cli->Post("/TopologicalSorting", input.dump(),
+                                  "application/json");
+  nlohmann::json output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL("kahn", output["algorithm"]);
+  REQUIRE(output["simpledata"] ==
+          nlohmann::json::parse("[1, 5, 2, 3, 4]"));
+  REQUIRE(output["levels"] == nlohmann::json::parse("[0, 0, 1, 1, 2]"));
+
+  input["edges"][3] = {4, 1};
+  res = cli->Post("/TopologicalSorting", input.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(200, res->status);
+  REQUIRE(!output.contains("simpledata"));
+  REQUIRE(output["cycle"] == nlohmann::json::parse("[3, 4, 1]"));
+
+  input["algorithm"] = "bfs";
+  res = cli->Post("/TopologicalSorting", input.dump(), "application/json");
+
+  REQUIRE_EQUAL(400, res->status);
+
+  // Количество потоков должно быть неотрицательным целым числом.
+  input["algorithm"] = "kahn";
+  for (const nlohmann::json& threads : {nlohmann::json(-1),
+                                        nlohmann::json(1.5),
+                                        nlohmann::json(nullptr)}) {
+    input["threads"] = threads;
+    res = cli->Post("/TopologicalSorting", input.dump(),
+                    "application/json");
+
+    REQUIRE_EQUAL(400, res->status);
+  }
+
+  // Слишком большое значение ограничивается количеством ядер.
+  input["threads"] = size_t{1} << 40;
+  res = cli->Post("/TopologicalSorting", input.dump(), "application/json");
+  output = nlohmann::json::parse(res->body);
+
+  REQUIRE_EQUAL(200, res->status);
+  REQUIRE(output["cycle"] == nlohmann::json::parse("[3, 4, 1]"));
+}
+
+/**
+ * @brief Тест алгоритма Кана на случайных ациклических графах.
+ *
+ * Проверяется, что каждое ребро идёт от меньшего уровня к большему, что
+ * уровень каждой вершины на единицу больше наибольшего уровня предков
+ * и что результат не зависит от количества потоков.
+ */
+static void KahnRandomTest() {
+  // Число попыток.
+  const int numTries = 10;
+  // Используется для инициализации генератора случайных чисел.
+  std::random_device rd;
+  // Генератор случайных чисел.
+  std::mt19937 gen(rd());
+  // Распределение для количества вершин.
+  std::uniform_int_distribution<size_t> graphSize(1, 20000);
+
+  for (int it = 0; it < numTries; it++) {
+    const size_t n = graphSize(gen);
+    std::uniform_int_distribution<size_t> ver(0, n - 1);
+
+    // Ребро идёт от меньшего номера в перестановке к большему.
+    std::vector<size_t> permutation(n);
+    for (size_t i = 0; i < n; i++)
+      permutation[i] = i;
+    std::shuffle(permutation.begin(), permutation.end(), gen);
+
+    graph::OrientedGraph g;
+    for (size_t i = 0; i < n; i++)
+      g.AddVertex(i);
+    for (size_t i = 0; i < 3 * n; i++) {
+      const size_t a = ver(gen), b = ver(gen);
+      if (a != b)
+        g.AddEdge(permutation[std::min(a, b)], permutation[std::max(a, b)]);
+    }
+
+    graph::TopologicalOrder order, parallelOrder;
+    REQUIRE(graph::KahnTopologicalSorting(g, &order, 1));
+    REQUIRE(graph::KahnTopologicalSorting(g, &parallelOrder, 4));
+    REQUIRE(order.order == parallelOrder.order);
+    REQUIRE(order.levels == parallelOrder.levels);
+    REQUIRE_EQUAL(n, order.order.size());
+    REQUIRE(order.cycle.empty());
+
+    std::vector<size_t> level(n);
+    for (size_t i = 0; i < n; i++)
+      level[order.order[i]] = order.levels[i];
+
+    for (size_t v = 0; v < n; v++) {
+      size_t expected = 0;
+      for (size_t from : g.IncomingEdges(v)) {
+        REQUIRE(level[from] < level[v]);
+        expected = std::max(expected, level[from] + 1);
+      }
+      REQUIRE_EQUAL(expected, level[v]);
+    }
+  }
+}
+
+/**
+ * @brief Тест алгоритма Кана на графах с циклом.
+ */
+static void KahnCycleTest() {
+  // Используется для инициализации генератора случайных чисел.
+  std::random_device rd;
+  // Генератор случайных чисел.
+  std::mt19937 gen(rd());
+
+  for (size_t n = 1; n < 50; n++) {
+    std::uniform_int_distribution<size_t> ver(0, n - 1);
+
+    graph::OrientedGraph g;
+    for (size_t i = 0; i < 2 * n; i++)
+      g.AddEdge(ver(gen), ver(gen));
+    // Гарантируем наличие цикла.
+    const size_t a = ver(gen), b = ver(gen);
+    g.AddEdge(a, b);
+    g.AddEdge(b, a);
+
+    graph::TopologicalOrder order;
+    REQUIRE(!graph::KahnTopologicalSorting(g, &order));
+    REQUIRE(!order.cycle.empty());
+
+    for (size_t i = 0; i < order.cycle.size(); i++) {
+      const size_t from = order.cycle[i];
+      const size_t to = order.cycle[(i + 1) % order.cycle.size()];
+      REQUIRE(g.HasEdge(from, to));
+    }
+  }
+}
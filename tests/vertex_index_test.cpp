@@ -0,0 +1,83 @@
+/**
+ * @file vertex_index_test.cpp
+ *
+ * Тесты для класса graph::VertexIndex.
+ */
+
+#include <vector>
+#include "test_core.hpp"
+#include <graph.hpp>
+#include <vertex_index.hpp>
+
+using std::vector;
+using std::out_of_range;
+
+using graph::Graph;
+using graph::VertexIndex;
+
+static void DenseIdsTest();
+static void SparseIdsTest();
+static void GraphTest();
+
+/**
+ * @brief Основная функция для тестирования класса graph::VertexIndex.
+ */
+void TestVertexIndex() {
+  TestSuite suite("TestVertexIndex");
+
+  RUN_TEST(suite, DenseIdsTest);
+  RUN_TEST(suite, SparseIdsTest);
+  RUN_TEST(suite, GraphTest);
+}
+
+/**
+ * @brief Тест на плотные номера вершин (прямая таблица).
+ */
+static void DenseIdsTest() {
+  VertexIndex index(vector<size_t>({5, 0, 3, 3, 1}));
+
+  REQUIRE_EQUAL(index.Size(), 4ul);
+  REQUIRE(index.Ids() == vector<size_t>({0, 1, 3, 5}));
+  REQUIRE_EQUAL(index.Index(0), 0ul);
+  REQUIRE_EQUAL(index.Index(3), 2ul);
+  REQUIRE_EQUAL(index.Index(5), 3ul);
+  REQUIRE_EQUAL(index.Id(1), 1ul);
+  REQUIRE_EQUAL(index.Contains(2), false);
+  REQUIRE_EQUAL(index.Find(6), VertexIndex::npos);
+  REQUIRE_THROW(index.Index(2), out_of_range);
+}
+
+/**
+ * @brief Тест на разреженные номера вершин (хеш-таблица).
+ */
+static void SparseIdsTest() {
+  const size_t big = 1'000'000'000'000ul;
+  VertexIndex index(vector<size_t>({big, 7, big + 1}));
+
+  REQUIRE_EQUAL(index.Size(), 3ul);
+  REQUIRE_EQUAL(index.Index(7), 0ul);
+  REQUIRE_EQUAL(index.Index(big), 1ul);
+  REQUIRE_EQUAL(index.Index(big + 1), 2ul);
+  REQUIRE_EQUAL(index.Id(2), big + 1);
+  REQUIRE_EQUAL(index.Contains(8), false);
+  REQUIRE_THROW(index.Index(big + 2), out_of_range);
+}
+
+/**
+ * @brief Тест на построение отображения по графу.
+ */
+static void GraphTest() {
+  Graph graph;
+
+  graph.AddEdge(10, 20);
+  graph.AddVertex(15);
+
+  VertexIndex index(graph);
+
+  REQUIRE(index.Ids() == vector<size_t>({10, 15, 20}));
+
+  for (size_t v : graph.Vertices())
+    REQUIRE_EQUAL(index.Id(index.Index(v)), v);
+
+  REQUIRE_EQUAL(VertexIndex().Size(), 0ul);
+}
@@ -5,6 +5,8 @@
  * Тесты для класса graph::WeightedGraph.
  */
 
+#include <tuple>
+#include <vector>
 #include "test_core.hpp"
 #include <weighted_graph.hpp>
 
@@ -12,12 +14,16 @@ using graph::WeightedGraph;
 
 static void SimpleTest();
 static void AnotherSimpleTest();
+static void WeightsTest();
+static void BulkTest();
 
 void TestWeightedGraph() {
   TestSuite suite("TestWeightedGraph");
 
   RUN_TEST(suite, SimpleTest);
   RUN_TEST(suite, AnotherSimpleTest);
+  RUN_TEST(suite, WeightsTest);
+  RUN_TEST(suite, BulkTest);
 }
 
 static void SimpleTest() {
@@ -55,3 +61,63 @@ static void AnotherSimpleTest() {
 
   REQUIRE(!graph.HasEdge(1, 2));
 }
+
+static void WeightsTest() {
+  WeightedGraph<int> graph;
+
+  graph.AddEdge(1, 2, 3);
+  graph.AddEdge(1, 3, 5);
+
+  REQUIRE_EQUAL(graph.Edges(1).size(), 2ul);
+  REQUIRE_EQUAL(graph.EdgeWeight(1, 2), 3);
+  REQUIRE_EQUAL(graph.EdgeWeight(1, 3), 5);
+
+  int sum = 0;
+
+  for (const auto& [neighbour, weight] : graph.WeightedEdges(1))
+    sum += static_cast<int>(neighbour) * weight;
+
+  REQUIRE_EQUAL(sum, 2 * 3 + 3 * 5);
+
+  graph.SetEdgeWeight(2, 1, 7);
+
+  REQUIRE_EQUAL(graph.EdgeWeight(1, 2), 7);
+  REQUIRE_EQUAL(graph.EdgeWeight(2, 1), 7);
+  REQUIRE_EQUAL(graph.WeightedEdges(2).at(1), 7);
+}
+
+static void BulkTest() {
+  const std::vector<std::tuple<size_t, size_t, int>> list = {
+    {1, 2, 3}, {3, 3, 1}, {1, 2, 7}, {2, 1, 4}, {1, 5, 9}
+  };
+
+  WeightedGraph<int> expected;
+  for (auto [id1, id2, weight] : list)
+    expected.AddEdge(id1, id2, weight);
+
+  WeightedGraph<int> graph;
+  graph.Reserve(4, list.size());
+  graph.AddEdges(list.begin(), list.end());
+
+  REQUIRE_EQUAL(graph.NumVertices(), expected.NumVertices());
+
+  for (size_t id : expected.Vertices()) {
+    REQUIRE_EQUAL(graph.Edges(id).size(), expected.Edges(id).size());
+    for (size_t neighbour : expected.Edges(id))
+      REQUIRE_EQUAL(graph.EdgeWeight(id, neighbour),
+                    expected.EdgeWeight(id, neighbour));
+  }
+
+  // Повторное ребро получает последний вес в обоих направлениях.
+  REQUIRE_EQUAL(graph.EdgeWeight(1, 2), 4);
+  REQUIRE_EQUAL(graph.EdgeWeight(2, 1), 4);
+  REQUIRE_EQUAL(graph.EdgeWeight(3, 3), 1);
+  REQUIRE_EQUAL(graph.EdgeWeight(5, 1), 9);
+  REQUIRE_EQUAL(graph.Edges(1).size(), size_t{2});
+  REQUIRE_EQUAL(graph.Edges(3).size(), size_t{1});
+
+  WeightedGraph<int> copy(list.begin(), list.end());
+
+  REQUIRE_EQUAL(copy.NumVertices(), expected.NumVertices());
+  REQUIRE_EQUAL(copy.EdgeWeight(1, 5), 9);
+}